@@ -0,0 +1,111 @@
+#include <CAD_modeler/model/millingMachineSim/gCodeParser.hpp>
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+
+
+namespace
+{
+    constexpr int linesCnt = 300000;
+    constexpr float scale = 0.01f;
+
+
+    std::string GenerateProgram()
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "%G71\r\nN1G40G90\r\nN2S10000M03\r\nN3G01X0.000Y0.000Z66.000\r\n";
+
+        for (int i = 0; i < linesCnt; ++i) {
+            out << 'N' << i + 4 << "G01X" << (i % 1000) * 0.15f - 75.f << "Y" << (i / 1000) * 0.5f - 75.f;
+            if (i % 3 == 0)
+                out << "Z" << 20.f + (i % 7) * 0.5f;
+            out << "\r\n";
+        }
+
+        return out.str();
+    }
+
+
+    /// Parser used before introducing GCodeParser
+    MillingMachinePath ParseWithRegex(const std::string& gCode)
+    {
+        MillingMachinePath result;
+        const std::regex lineRegex(R"(^N(\d+)G01((X)(-?\d+\.\d+))?((Y)(-?\d+\.\d+))?((Z)(-?\d+\.\d+))?\r?$)");
+
+        std::istringstream stream(gCode);
+        std::string lineStr;
+        while (std::getline(stream, lineStr)) {
+            std::smatch match;
+            if (!std::regex_match(lineStr, match, lineRegex))
+                continue;
+
+            const int id = std::stoi(match[1].str());
+            const float x = match[3].matched ? std::stof(match[4].str()) * scale : result.Commands().back().destination.GetZ();
+            const float y = match[6].matched ? std::stof(match[7].str()) * scale : result.Commands().back().destination.GetX();
+            const float z = match[9].matched ? std::stof(match[10].str()) * scale : result.Commands().back().destination.GetY();
+
+            result.AddCommand(id, y, z, x);
+        }
+
+        return result;
+    }
+
+
+    template <typename Func>
+    double MeasureMs(Func func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+
+int main()
+{
+    const std::string gCode = GenerateProgram();
+
+    MillingMachinePath regexPath;
+    const double regexMs = MeasureMs([&] { regexPath = ParseWithRegex(gCode); });
+
+    MillingMachinePath parserPath;
+    const double parserMs = MeasureMs([&] {
+        GCodeParser parser(scale);
+        parserPath = parser.Parse(gCode);
+    });
+
+    bool identical = regexPath.Size() == parserPath.Size();
+    for (size_t i = 0; identical && i < regexPath.Size(); ++i) {
+        identical = regexPath.Commands()[i].id == parserPath.Commands()[i].id &&
+                    regexPath.Commands()[i].destination.vec == parserPath.Commands()[i].destination.vec;
+    }
+
+    std::cout << "Parsing " << linesCnt << " lines (" << gCode.size() / 1024 << " KiB): regex " << regexMs
+        << " ms, GCodeParser " << parserMs << " ms, speedup " << regexMs / parserMs << "x, paths "
+        << (identical ? "identical" : "DIFFERENT") << '\n';
+
+    const std::string toolpathPath = (std::filesystem::temp_directory_path() / "gCodeBenchmarks.ctp").string();
+    ToolpathFile::Save(toolpathPath, parserPath, MillingCutter(0.08f, MillingCutter::Type::Round));
+
+    size_t loadedCnt = 0;
+    const double loadMs = MeasureMs([&] {
+        const auto toolpath = ToolpathFile::Load(toolpathPath);
+        loadedCnt = toolpath.path.Size();
+    });
+    std::filesystem::remove(toolpathPath);
+
+    identical &= loadedCnt == parserPath.Size();
+
+    std::cout << "Loading the same path from the toolpath file: " << loadMs << " ms\n";
+
+    return identical ? 0 : 1;
+}
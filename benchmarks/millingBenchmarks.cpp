@@ -0,0 +1,266 @@
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/tiledMiller.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    constexpr int resolution = 1000;
+    constexpr float materialLen = 1.5f;
+    constexpr float initHeight = 0.5f;
+    constexpr int positionsCnt = 20000;
+
+    constexpr int pathResolution = 2000;
+    constexpr int pathSectionsCnt = 200000;
+
+    constexpr int sparseResolution = 4000;
+
+    constexpr int finishingResolution = 1500;
+
+
+    void MillReference(MaterialHeightMap& heightMap, const MillingCutter& cutter, const alg::Vec3& cutterPos)
+    {
+        const float pixelXLen = heightMap.PixelXLen();
+        const float pixelZLen = heightMap.PixelZLen();
+
+        const int posPixelX = static_cast<int>(std::round((cutterPos.X() - heightMap.MinX()) / pixelXLen));
+        const int posPixelZ = static_cast<int>(std::round((cutterPos.Z() - heightMap.MinZ()) / pixelZLen));
+
+        const int radiusInPixelsX = static_cast<int>(std::ceil(cutter.radius / pixelXLen));
+        const int radiusInPixelsZ = static_cast<int>(std::ceil(cutter.radius / pixelZLen));
+
+        const Position pos(cutterPos);
+        MillingResult result;
+
+        for (int x = posPixelX - radiusInPixelsX; x <= posPixelX + radiusInPixelsX; x++) {
+            for (int z = posPixelZ - radiusInPixelsZ; z <= posPixelZ + radiusInPixelsZ; z++) {
+                if (x < 0 || x >= heightMap.XResolution() || z < 0 || z >= heightMap.ZResolution())
+                    continue;
+
+                const float cutterY = cutter.YCoordinate(pos, heightMap.GlobalX(x), heightMap.GlobalZ(z));
+                MillPixel(heightMap, x, z, cutterY, cutter.height, result);
+            }
+        }
+    }
+
+
+    bool SameHeights(const MaterialHeightMap& first, const MaterialHeightMap& second)
+    {
+        for (int z = 0; z < first.ZResolution(); ++z) {
+            for (int x = 0; x < first.XResolution(); ++x) {
+                if (first.HeightAt(x, z) != second.HeightAt(x, z))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    double MeasureMs(const std::function<void()>& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+
+    bool BenchmarkCutter(const char* name, const MillingCutter& cutter, const std::vector<alg::Vec3>& positions)
+    {
+        MaterialHeightMap reference(resolution, resolution, materialLen, materialLen, initHeight);
+        MaterialHeightMap stamped(resolution, resolution, materialLen, materialLen, initHeight);
+
+        const double referenceMs = MeasureMs([&] {
+            for (const auto& pos : positions)
+                MillReference(reference, cutter, pos);
+        });
+
+        const double stampMs = MeasureMs([&] {
+            const CutterStamp stamp(cutter, stamped.PixelXLen(), stamped.PixelZLen());
+            for (const auto& pos : positions)
+                stamp.Mill(stamped, pos);
+        });
+
+        const bool identical = SameHeights(reference, stamped);
+
+        std::cout << name << ": reference " << referenceMs << " ms, stamp " << stampMs << " ms, speedup "
+            << referenceMs / stampMs << "x, heights " << (identical ? "identical" : "DIFFERENT") << '\n';
+
+        return identical;
+    }
+
+
+    /// Zigzag finishing path with short sections, similar to the ones generated by the paths designer
+    std::vector<MillingSection> FinishingPath()
+    {
+        std::vector<MillingSection> sections;
+        sections.reserve(pathSectionsCnt);
+
+        constexpr int sectionsInRow = 500;
+        constexpr float step = materialLen / sectionsInRow;
+        const int rowsCnt = pathSectionsCnt / sectionsInRow;
+        const float rowsDist = materialLen / static_cast<float>(rowsCnt);
+
+        alg::Vec3 prev(-materialLen/2.f, 0.3f, -materialLen/2.f);
+        for (int row = 0; row < rowsCnt; ++row) {
+            const float dir = row % 2 == 0 ? 1.f : -1.f;
+
+            for (int i = 0; i < sectionsInRow; ++i) {
+                alg::Vec3 next = prev + alg::Vec3(0.f, 0.f, dir * step);
+                if (i == sectionsInRow - 1)
+                    next = next + alg::Vec3(rowsDist, 0.f, 0.f);
+                next.Y() = 0.3f + 0.1f * std::sin(next.X() * 5.f) * std::cos(next.Z() * 5.f);
+
+                sections.push_back({ .start = prev, .end = next });
+                prev = next;
+            }
+        }
+
+        return sections;
+    }
+
+
+    bool BenchmarkTiledMilling(const MillingCutter& cutter)
+    {
+        const auto sections = FinishingPath();
+
+        MaterialHeightMap singleThread(pathResolution, pathResolution, materialLen, materialLen, initHeight);
+        MaterialHeightMap multiThread(pathResolution, pathResolution, materialLen, materialLen, initHeight);
+
+        const double singleMs = MeasureMs([&] {
+            const TiledMiller miller(64, 1);
+            miller.Mill(singleThread, cutter, sections);
+        });
+
+        const unsigned int threadsCnt = std::thread::hardware_concurrency();
+        const double multiMs = MeasureMs([&] {
+            const TiledMiller miller(64, threadsCnt);
+            miller.Mill(multiThread, cutter, sections);
+        });
+
+        const bool identical = SameHeights(singleThread, multiThread);
+
+        std::cout << "Tiled milling of " << sections.size() << " sections on " << pathResolution << "x" << pathResolution
+            << ": 1 thread " << singleMs << " ms, " << threadsCnt << " threads " << multiMs << " ms, speedup "
+            << singleMs / multiMs << "x, heights " << (identical ? "identical" : "DIFFERENT") << '\n';
+
+        return identical;
+    }
+
+
+    /// Finishing pass over a small pocket of a high resolution block, which touches only a part of the tiles
+    void BenchmarkSparseStorage(const MillingCutter& cutter)
+    {
+        MaterialHeightMap heightMap(sparseResolution, sparseResolution, materialLen, materialLen, initHeight);
+
+        std::vector<MillingSection> sections;
+        constexpr float pocketLen = materialLen / 5.f;
+        constexpr int rowsCnt = 100;
+
+        alg::Vec3 prev(0.f, 0.35f, 0.f);
+        for (int row = 0; row < rowsCnt; ++row) {
+            const float x = pocketLen * static_cast<float>(row) / rowsCnt;
+            const float z = row % 2 == 0 ? pocketLen : 0.f;
+            const alg::Vec3 next(x, 0.35f, z);
+
+            sections.push_back({ .start = prev, .end = next });
+            sections.push_back({ .start = next, .end = alg::Vec3(x + pocketLen / rowsCnt, 0.35f, z) });
+            prev = sections.back().end;
+        }
+
+        const double millMs = MeasureMs([&] {
+            const TiledMiller miller(64, std::thread::hardware_concurrency());
+            miller.Mill(heightMap, cutter, sections);
+        });
+
+        const size_t tilesCnt = static_cast<size_t>(heightMap.TilesX()) * heightMap.TilesZ();
+        const size_t materializedCnt = heightMap.MaterializedTilesCnt();
+        constexpr double tileMiB = MaterialHeightMap::tileSize * MaterialHeightMap::tileSize * sizeof(float) / (1024.0 * 1024.0);
+
+        const double resetMs = MeasureMs([&] { heightMap.Fill(initHeight); });
+
+        std::cout << "Pocket on " << sparseResolution << "x" << sparseResolution << " material: milled in " << millMs
+            << " ms, " << materializedCnt << " of " << tilesCnt << " tiles allocated (" << materializedCnt * tileMiB
+            << " MiB instead of " << tilesCnt * tileMiB << " MiB), reset " << resetMs << " ms\n";
+    }
+
+
+    /// Zigzag over the whole material at the given height
+    std::vector<MillingSection> ZigzagPath(const float y, const int rowsCnt, const int sectionsInRow)
+    {
+        std::vector<MillingSection> sections;
+        alg::Vec3 prev(-materialLen/2.f, y, -materialLen/2.f);
+
+        for (int row = 0; row < rowsCnt; ++row) {
+            const float x = -materialLen/2.f + materialLen * static_cast<float>(row) / static_cast<float>(rowsCnt);
+
+            for (int i = 1; i <= sectionsInRow; ++i) {
+                const float z = (row % 2 == 0 ? -1.f : 1.f) * (-materialLen/2.f + materialLen * static_cast<float>(i) / static_cast<float>(sectionsInRow));
+                const alg::Vec3 next(x, y, z);
+
+                sections.push_back({ .start = prev, .end = next });
+                prev = next;
+            }
+        }
+
+        return sections;
+    }
+
+
+    /// Finishing pass after roughing, which moves above the already milled material over half of the block
+    void BenchmarkFinishingAboveMaterial()
+    {
+        MaterialHeightMap heightMap(finishingResolution, finishingResolution, materialLen, materialLen, initHeight);
+        const TiledMiller miller(64, std::thread::hardware_concurrency());
+
+        miller.Mill(heightMap, MillingCutter(0.08f, MillingCutter::Type::Flat), ZigzagPath(0.2f, 20, 50));
+
+        auto finishing = ZigzagPath(0.25f, 150, 400);
+        for (auto& section : finishing) {
+            if (section.start.X() > 0.f)
+                section.start.Y() = section.end.Y() = 0.15f;
+        }
+
+        const double finishingMs = MeasureMs([&] {
+            miller.Mill(heightMap, MillingCutter(0.02f, MillingCutter::Type::Round), finishing);
+        });
+
+        std::cout << "Finishing " << finishing.size() << " sections, half of them above the material: "
+            << finishingMs << " ms\n";
+    }
+}
+
+
+int main()
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> posDist(-0.75f, 0.75f);
+    std::uniform_real_distribution<float> heightDist(0.1f, 0.5f);
+
+    std::vector<alg::Vec3> positions;
+    positions.reserve(positionsCnt);
+    for (int i = 0; i < positionsCnt; ++i)
+        positions.emplace_back(posDist(gen), heightDist(gen), posDist(gen));
+
+    std::cout << "Milling " << positionsCnt << " positions on " << resolution << "x" << resolution << " material\n";
+
+    bool identical = BenchmarkCutter("Round cutter r=0.08", MillingCutter(0.08f, MillingCutter::Type::Round), positions);
+    identical &= BenchmarkCutter("Flat cutter r=0.05", MillingCutter(0.05f, MillingCutter::Type::Flat), positions);
+    identical &= BenchmarkCutter("Bull-nose cutter r=0.08", MillingCutter(CutterProfile::BullNose(0.08f, 0.02f)), positions);
+
+    identical &= BenchmarkTiledMilling(MillingCutter(0.04f, MillingCutter::Type::Round));
+
+    BenchmarkSparseStorage(MillingCutter(0.04f, MillingCutter::Type::Flat));
+    BenchmarkFinishingAboveMaterial();
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/deviationAnalysis.hpp>
+#include <CAD_modeler/model/millingMachineSim/heightMapExport.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathValidation.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/tiledMiller.hpp>
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
+#include <CAD_modeler/model/systems/millingMachinePathsSystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    constexpr std::string_view usage =
+        "Usage: mill_sim_cli <toolpath> [options]\n"
+        "\n"
+        "Mills the toolpath without rendering. The toolpath is either a G-code file with the cutter\n"
+        "extension (.k16, .f10, ...) or a compiled toolpath file (.ctp). Lengths are in the modeler units.\n"
+        "\n"
+        "Options:\n"
+        "  --resolution <x> <z>   height map resolution (default 1000 1000)\n"
+        "  --size <x> <z>         material size (default 1.5 1.5)\n"
+        "  --thickness <value>    initial material thickness (default 0.5)\n"
+        "  --base <level>         material base level (default 0)\n"
+        "  --cutter-height <h>    height of the cutter cutting part (default 1)\n"
+        "  --bull-nose <r>        replaces the cutter with the bull-nose one of the same radius and the given\n"
+        "                         corner radius\n"
+        "  --tapered <r> <angle>  replaces the cutter with the tapered one of the same radius, the given tip radius\n"
+        "                         and the half angle in degrees\n"
+        "  --threads <count>      milling threads (default: hardware concurrency)\n"
+        "  --tile <size>          milling tile size in pixels (default 64)\n"
+        "  --pgm <file>           writes the final heights as a 16-bit PGM image\n"
+        "  --raw <file>           writes the final heights as raw 32-bit floats\n"
+        "  --fail-on-warnings     exits with code 2 if milling produced any warning\n"
+        "  --validate-only        only checks the path against the material, without milling it, and prints\n"
+        "                         the potential warnings. Milling never gives warnings not found by the validation.\n"
+        "  --target <file>        compares the milled material with the target heights (.thm) exported by the designer\n"
+        "  --tolerance <value>    deviation from the target counted as neither undercut nor overcut (default 0.001)\n"
+        "  --deviation-image <f>  writes the deviations from the target as a PPM image\n"
+        "  --deviation-json <f>   writes the deviation statistics as JSON\n";
+
+
+    class Options {
+    public:
+        std::string toolpath;
+
+        int xResolution = 1000;
+        int zResolution = 1000;
+        float xLen = 1.5f;
+        float zLen = 1.5f;
+        float thickness = 0.5f;
+        float baseLevel = 0.f;
+        std::optional<float> cutterHeight;
+        std::optional<float> bullNoseCornerRadius;
+        std::optional<std::pair<float, float>> taperedTipAndAngle;
+
+        unsigned int threads = std::thread::hardware_concurrency();
+        int tileSize = 64;
+
+        std::string pgmPath;
+        std::string rawPath;
+        bool failOnWarnings = false;
+        bool validateOnly = false;
+
+        std::string targetPath;
+        float tolerance = DeviationSettings().tolerance;
+        std::string deviationImagePath;
+        std::string deviationJsonPath;
+    };
+
+
+    Options ParseOptions(const int argc, char** argv)
+    {
+        Options options;
+        int i = 1;
+
+        auto next = [&] (const std::string_view option) -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value of " + std::string(option));
+
+            return argv[++i];
+        };
+
+        for (; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+
+            if (arg == "--resolution") {
+                options.xResolution = std::stoi(next(arg));
+                options.zResolution = std::stoi(next(arg));
+            }
+            else if (arg == "--size") {
+                options.xLen = std::stof(next(arg));
+                options.zLen = std::stof(next(arg));
+            }
+            else if (arg == "--thickness")
+                options.thickness = std::stof(next(arg));
+            else if (arg == "--base")
+                options.baseLevel = std::stof(next(arg));
+            else if (arg == "--cutter-height")
+                options.cutterHeight = std::stof(next(arg));
+            else if (arg == "--bull-nose")
+                options.bullNoseCornerRadius = std::stof(next(arg));
+            else if (arg == "--tapered") {
+                const float tipRadius = std::stof(next(arg));
+                options.taperedTipAndAngle = std::make_pair(tipRadius, std::stof(next(arg)));
+            }
+            else if (arg == "--threads")
+                options.threads = static_cast<unsigned int>(std::stoul(next(arg)));
+            else if (arg == "--tile")
+                options.tileSize = std::stoi(next(arg));
+            else if (arg == "--pgm")
+                options.pgmPath = next(arg);
+            else if (arg == "--raw")
+                options.rawPath = next(arg);
+            else if (arg == "--fail-on-warnings")
+                options.failOnWarnings = true;
+            else if (arg == "--validate-only")
+                options.validateOnly = true;
+            else if (arg == "--target")
+                options.targetPath = next(arg);
+            else if (arg == "--tolerance")
+                options.tolerance = std::stof(next(arg));
+            else if (arg == "--deviation-image")
+                options.deviationImagePath = next(arg);
+            else if (arg == "--deviation-json")
+                options.deviationJsonPath = next(arg);
+            else if (arg.starts_with("--"))
+                throw std::invalid_argument("Unknown option " + std::string(arg));
+            else if (options.toolpath.empty())
+                options.toolpath = arg;
+            else
+                throw std::invalid_argument("Only one toolpath can be milled");
+        }
+
+        if (options.toolpath.empty())
+            throw std::invalid_argument("Missing toolpath");
+
+        if (options.xResolution <= 0 || options.zResolution <= 0 || options.tileSize <= 0)
+            throw std::invalid_argument("Resolution and tile size have to be positive");
+
+        if (options.xLen <= 0.f || options.zLen <= 0.f || options.thickness <= 0.f)
+            throw std::invalid_argument("Material size and thickness have to be positive");
+
+        if (options.targetPath.empty() && (!options.deviationImagePath.empty() || !options.deviationJsonPath.empty()))
+            throw std::invalid_argument("Deviation outputs require the target");
+
+        return options;
+    }
+
+
+    ToolpathFile::Toolpath LoadToolpath(const std::string& filePath)
+    {
+        if (ToolpathFile::HasToolpathExtension(filePath))
+            return ToolpathFile::Load(filePath);
+
+        return {
+            .path = MillingMachinePathsSystem::ParseGCode(filePath),
+            .cutter = MillingMachinePathsSystem::ParseCutter(filePath)
+        };
+    }
+
+
+    /// @brief Number of pixels in the footprints of all the sections, which is the area the miller has to visit
+    size_t FootprintsPixels(const MaterialHeightMap& heightMap, const MillingCutter& cutter, const std::vector<MillingSection>& sections)
+    {
+        const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+        size_t pixels = 0;
+
+        for (const auto& section : sections) {
+            const PixelRect footprint = SectionFootprint(heightMap, stamp, section.start, section.end);
+            pixels += static_cast<size_t>(footprint.Width()) * footprint.Height();
+        }
+
+        return pixels;
+    }
+
+
+    void PrintWarnings(const MillingWarningsRepo& warnings)
+    {
+        if (warnings.Empty()) {
+            std::cout << "No warnings\n";
+            return;
+        }
+
+        for (const auto& [commandId, warningsTypes] : warnings.GetWarnings()) {
+            if (warningsTypes & MillingWarningsRepo::MillingStraightDown)
+                std::cout << "Milling straight down during " << commandId << " command\n";
+
+            if (warningsTypes & MillingWarningsRepo::MillingTooDeep)
+                std::cout << "Milling too deep during " << commandId << " command\n";
+
+            if (warningsTypes & MillingWarningsRepo::MillingUnderTheBase)
+                std::cout << "Milling under the base during " << commandId << " command\n";
+        }
+    }
+
+
+    void PrintDeviation(const DeviationReport& report, const double analysisSec)
+    {
+        const auto percent = [&report] (const size_t pixels) {
+            return 100.0 * static_cast<double>(pixels) / static_cast<double>(report.pixelsCnt);
+        };
+
+        std::cout << "Deviation from the target, computed in " << analysisSec * 1000.0 << " ms:\n";
+        std::cout << "  undercut: " << percent(report.undercutPixels) << "% of pixels, max " << report.maxUndercut
+                  << ", volume " << report.undercutVolume << '\n';
+        std::cout << "  overcut: " << percent(report.overcutPixels) << "% of pixels, max " << report.maxOvercut
+                  << ", volume " << report.overcutVolume << '\n';
+        std::cout << "  mean " << report.meanDeviation << ", mean abs " << report.meanAbsDeviation
+                  << ", rms " << report.rmsDeviation << '\n';
+        std::cout << "  removed volume " << report.removedVolume << '\n';
+    }
+
+
+    double SecondsSince(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+
+    int Run(const Options& options)
+    {
+        const auto loadStart = std::chrono::steady_clock::now();
+        auto [path, cutter] = LoadToolpath(options.toolpath);
+        const double loadSec = SecondsSince(loadStart);
+
+        if (options.cutterHeight.has_value())
+            cutter.height = *options.cutterHeight;
+
+        if (options.bullNoseCornerRadius.has_value())
+            cutter = MillingCutter(CutterProfile::BullNose(cutter.radius, *options.bullNoseCornerRadius), cutter.height);
+
+        if (options.taperedTipAndAngle.has_value()) {
+            const auto [tipRadius, angle] = *options.taperedTipAndAngle;
+            const auto profile = CutterProfile::Tapered(cutter.radius, tipRadius, angle * std::numbers::pi_v<float> / 180.f);
+            cutter = MillingCutter(profile, cutter.height);
+        }
+
+        MaterialHeightMap heightMap(options.xResolution, options.zResolution, options.xLen, options.zLen, options.thickness);
+        heightMap.SetBaseLevel(options.baseLevel);
+
+        MillingWarningsRepo warnings;
+        warnings.Reset(path);
+
+        if (options.validateOnly) {
+            const auto validationStart = std::chrono::steady_clock::now();
+            ValidatePath(heightMap, cutter, path, warnings, options.threads);
+            const double validationSec = SecondsSince(validationStart);
+
+            warnings.UpdateView();
+
+            std::cout << "Commands: " << path.Size() << ", loaded in " << loadSec * 1000.0 << " ms\n";
+            std::cout << "Validated in " << validationSec * 1000.0 << " ms, potential warnings:\n";
+            PrintWarnings(warnings);
+
+            return options.failOnWarnings && !warnings.Empty() ? 2 : EXIT_SUCCESS;
+        }
+
+        const TiledMiller miller(options.tileSize, options.threads);
+
+        const auto millStart = std::chrono::steady_clock::now();
+        MillPath(miller, heightMap, cutter, path, warnings);
+        const double millSec = SecondsSince(millStart);
+
+        warnings.UpdateView();
+
+        const size_t sectionsCnt = path.Size() > 0 ? path.Size() - 1 : 0;
+        const size_t pixels = FootprintsPixels(heightMap, cutter, PathSections(path));
+
+        std::cout << "Commands: " << path.Size() << ", loaded in " << loadSec * 1000.0 << " ms\n";
+        std::cout << "Milled " << sectionsCnt << " segments in " << millSec * 1000.0 << " ms using "
+                  << std::max(options.threads, 1u) << " threads\n";
+
+        // Tiny paths might be milled below the clock resolution
+        if (millSec > 0.0) {
+            std::cout << "Throughput: " << static_cast<double>(sectionsCnt) / millSec << " segments/s, "
+                      << static_cast<double>(pixels) / millSec << " pixels/s\n";
+        }
+
+        PrintWarnings(warnings);
+
+        if (!options.pgmPath.empty())
+            SaveHeightMapPGM(heightMap, options.pgmPath, options.thickness);
+
+        if (!options.rawPath.empty())
+            SaveHeightMapRaw(heightMap, options.rawPath);
+
+        if (!options.targetPath.empty()) {
+            const auto target = TargetHeights::Load(options.targetPath);
+
+            DeviationSettings settings;
+            settings.tolerance = options.tolerance;
+            settings.threadsCnt = options.threads;
+
+            const auto analysisStart = std::chrono::steady_clock::now();
+            const auto report = AnalyzeDeviation(heightMap, target, options.thickness, settings);
+            PrintDeviation(report, SecondsSince(analysisStart));
+
+            if (!options.deviationImagePath.empty())
+                SaveDeviationImage(heightMap, target, options.deviationImagePath, settings.tolerance, settings.histogramRange);
+
+            if (!options.deviationJsonPath.empty())
+                SaveDeviationReportJson(report, options.deviationJsonPath);
+        }
+
+        return options.failOnWarnings && !warnings.Empty() ? 2 : EXIT_SUCCESS;
+    }
+}
+
+
+int main(const int argc, char** argv)
+{
+    Options options;
+
+    try {
+        options = ParseOptions(argc, argv);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n\n" << usage;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        return Run(options);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+/// @brief Shape of the cutter bottom, given as the height above the cutter tip in the function of the distance
+/// from the cutter axis. The profile is split into segments, each of them is a line or a circle arc, so that
+/// every profile is evaluated with the same formula. Segment covering the distance is found in the lookup table,
+/// so evaluation does not depend on the number of segments.
+/// Profiles are non-decreasing and convex, which the swept cutter relies on.
+class CutterProfile {
+public:
+    enum class Type {
+        Round,
+        Flat,
+        BullNose,
+        Tapered,
+        Table
+    };
+
+    class Point {
+    public:
+        float radius;
+        float height;
+
+        bool operator==(const Point&) const = default;
+    };
+
+    [[nodiscard]]
+    static CutterProfile Round(float radius);
+
+    [[nodiscard]]
+    static CutterProfile Flat(float radius);
+
+    /// @brief Flat cutter with rounded corner
+    [[nodiscard]]
+    static CutterProfile BullNose(float radius, float cornerRadius);
+
+    /// @brief Cone with the flat tip, which widens under the given angle from the cutter axis
+    [[nodiscard]]
+    static CutterProfile Tapered(float radius, float tipRadius, float halfAngle);
+
+    /// @brief Profile linearly interpolated between the points. The first point has to lie on the cutter axis
+    /// at the tip height (0, 0) and the radius of the last one is the cutter radius.
+    [[nodiscard]]
+    static CutterProfile Table(const std::vector<Point>& points);
+
+    [[nodiscard]]
+    Type GetType() const
+        { return type; }
+
+    [[nodiscard]]
+    float Radius() const
+        { return radius; }
+
+    /// @brief Corner radius of the bull-nose cutter or the tip radius of the tapered one
+    [[nodiscard]]
+    float SecondaryRadius() const
+        { return secondaryRadius; }
+
+    /// @brief Angle between the cone side and the axis of the tapered cutter, in radians
+    [[nodiscard]]
+    float HalfAngle() const
+        { return halfAngle; }
+
+    /// @brief Points of the table profile
+    [[nodiscard]]
+    const std::vector<Point>& Points() const
+        { return points; }
+
+    /// @brief Height of the cutter bottom above its tip in the given squared distance from the cutter axis,
+    /// or infinity if the distance is bigger than the cutter radius
+    [[nodiscard]]
+    float HeightAt(const float distSq) const {
+        if (distSq > radiusSq)
+            return std::numeric_limits<float>::infinity();
+
+        const float dist = std::sqrt(distSq);
+        const auto cell = std::min(static_cast<size_t>(dist * cellsPerUnit), cellsSegments.size() - 1);
+
+        // Cells are not longer than the shortest segment, unless there are too many segments,
+        // so the loop makes at most a single step for all the analytic profiles
+        size_t segmentIdx = cellsSegments[cell];
+        while (dist > segments[segmentIdx].end && segmentIdx + 1 < segments.size())
+            ++segmentIdx;
+
+        const Segment& segment = segments[segmentIdx];
+        const float diff = dist - segment.f;
+
+        return segment.a + segment.b * dist - std::sqrt(std::max(segment.c - segment.e * diff * diff, 0.f));
+    }
+
+    bool operator==(const CutterProfile& other) const;
+
+private:
+    /// @brief Height is a + b*r - sqrt(c - e*(r - f)^2) up to the end radius. Lines have c = e = 0
+    /// and arcs of the circle with the radius rc centered in (cr, ch) have a = ch, b = 0, c = rc^2, e = 1 and f = cr.
+    class Segment {
+    public:
+        float end;
+        float a, b, c, e, f;
+    };
+
+    static constexpr size_t maxCells = 1024;
+
+    Type type;
+    float radius;
+    float radiusSq;
+    float secondaryRadius = 0.f;
+    float halfAngle = 0.f;
+    std::vector<Point> points;
+
+    std::vector<Segment> segments;
+    std::vector<unsigned int> cellsSegments;
+    float cellsPerUnit = 0.f;
+
+    CutterProfile(Type type, float radius, std::vector<Segment> segments);
+
+    [[nodiscard]]
+    static Segment Line(float end, float startRadius, float startHeight, float slope);
+
+    [[nodiscard]]
+    static Segment Arc(float end, float centerR, float centerH, float arcRadius);
+};
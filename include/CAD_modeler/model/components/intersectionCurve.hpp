@@ -2,7 +2,7 @@
 
 #include <algebra/vec4.hpp>
 
-#include <ecs/eventsManager.hpp>
+#include "../systems/intersectionSystem/solversTelemetry.hpp"
 
 #include <vector>
 #include <deque>
@@ -62,11 +62,11 @@ private:
 
 class IntersectionCurve {
 public:
-    IntersectionCurve(std::vector<IntersectionPoint>&& points, const bool isOpen, const HandlerId deletionHandler):
-        isOpen(isOpen), intersectionPoints(std::move(points)), deletionHandler(deletionHandler) {}
+    IntersectionCurve(std::vector<IntersectionPoint>&& points, const bool isOpen):
+        isOpen(isOpen), intersectionPoints(std::move(points)) {}
 
-    IntersectionCurve(const std::deque<IntersectionPoint>& points, const bool isOpen, const HandlerId deletionHandler):
-        isOpen(isOpen), intersectionPoints(points.begin(), points.end()), deletionHandler(deletionHandler) {}
+    IntersectionCurve(const std::deque<IntersectionPoint>& points, const bool isOpen):
+        isOpen(isOpen), intersectionPoints(points.begin(), points.end()) {}
 
     [[nodiscard]]
     size_t Size() const
@@ -78,5 +78,5 @@ public:
 
     bool isOpen;
     std::vector<IntersectionPoint> intersectionPoints;
-    HandlerId deletionHandler;
+    interSys::SolversTelemetry telemetry;
 };
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <algebra/vec3.hpp>
+
+#include <vector>
+
+
+/// @brief Points of the intersection curve in the world space, stored without creating an entity per point
+class IntersectionPolyline {
+public:
+    IntersectionPolyline(std::vector<alg::Vec3>&& points, const bool isOpen):
+        isOpen(isOpen), points(std::move(points)) {}
+
+    [[nodiscard]]
+    size_t Size() const
+        { return points.size(); }
+
+    const alg::Vec3& operator[](const size_t idx) const
+        { return points.at(idx); }
+
+    bool isOpen;
+    std::vector<alg::Vec3> points;
+};
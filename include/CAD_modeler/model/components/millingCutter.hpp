@@ -1,17 +1,23 @@
 #pragma once
 
 #include "position.hpp"
+#include "cutterProfile.hpp"
+
+#include <memory>
 
 
 class MillingCutter {
 public:
-    enum class Type {
-        Round,
-        Flat
-    };
+    using Type = CutterProfile::Type;
+
+    /// @brief Creates the round or the flat cutter, other types require the profile parameters
+    MillingCutter(float radius, Type type, float height = 1.f);
 
-    MillingCutter(const float radius, const Type type, const float height = 1.f):
-        radius(radius), height(height), type(type) {}
+    explicit MillingCutter(const CutterProfile& profile, float height = 1.f);
+
+    [[nodiscard]]
+    const CutterProfile& Profile() const
+        { return *profile; }
 
     [[nodiscard]]
     float YCoordinate(const Position& pos, float x, float z) const;
@@ -19,7 +25,12 @@ public:
     [[nodiscard]]
     float CalcMinYCoord(float cutterX, float cutterZ, const Position& pointPos) const;
 
+    /// @brief Radius and type describe the profile, so they must not be changed
     float radius;
     float height;
     Type type;
+
+private:
+    /// @brief Shared, so that copying the cutter for every milled section does not copy the profile
+    std::shared_ptr<const CutterProfile> profile;
 };
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include "position.hpp"
+#include "../../utilities/mappedFile.hpp"
 
 
 class MoveCommand {
@@ -21,32 +25,57 @@ public:
 
 class MillingMachinePath {
 public:
-    [[nodiscard]]
-    auto begin()
-        { return commands.begin(); }
+    MillingMachinePath() = default;
+
+    /// @brief Path of the commands stored in the memory mapped toolpath file, which is kept alive by the path
+    MillingMachinePath(std::shared_ptr<const MappedFile> mappedFile, std::span<const MoveCommand> mappedCommands):
+        mappedFile(std::move(mappedFile)), mappedCommands(mappedCommands) {}
 
+    /// @brief Commands of the path, which are stored either in the vector or in the memory mapped toolpath file
     [[nodiscard]]
-    auto end()
-        { return commands.end(); }
+    std::span<const MoveCommand> Commands() const
+        { return mappedFile ? mappedCommands : std::span<const MoveCommand>(commands); }
+
+    /// @brief Appends the command constructed from the arguments. Mapped paths are read-only.
+    template <typename... Args>
+    void AddCommand(Args&&... args) {
+        ThrowIfMapped();
+        commands.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void RemoveLastCommand() {
+        ThrowIfMapped();
+        commands.pop_back();
+    }
 
     [[nodiscard]]
     auto begin() const
-        { return commands.begin(); }
+        { return Commands().begin(); }
 
     [[nodiscard]]
     auto end() const
-        { return commands.end(); }
+        { return Commands().end(); }
 
     [[nodiscard]]
     auto cbegin() const
-        { return commands.cbegin(); }
+        { return Commands().begin(); }
 
     [[nodiscard]]
     auto cend() const
-        { return commands.cend(); }
+        { return Commands().end(); }
 
     size_t Size() const
-        { return commands.size(); }
+        { return Commands().size(); }
 
+private:
     std::vector<MoveCommand> commands;
-};
\ No newline at end of file
+
+    /// @brief File, which memory holds the mapped commands. Shared, so the path can be copied cheaply.
+    std::shared_ptr<const MappedFile> mappedFile;
+    std::span<const MoveCommand> mappedCommands;
+
+    void ThrowIfMapped() const {
+        if (mappedFile)
+            throw std::runtime_error("Commands of the mapped toolpath cannot be changed");
+    }
+};
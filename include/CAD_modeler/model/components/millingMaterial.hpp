@@ -5,6 +5,9 @@
 #include "../systems/shaders/millingMaterial/millingMaterialTopShader.hpp"
 #include "../systems/shaders/millingMaterial/millingMaterialSideShader.hpp"
 #include "../systems/shaders/millingMaterial/millingMaterialBottomShader.hpp"
+#include "../millingMachineSim/heightMapLod.hpp"
+#include "../millingMachineSim/heightPyramid.hpp"
+#include "../millingMachineSim/materialHeightMap.hpp"
 
 #include <algebra/vec3.hpp>
 #include <algebra/mat4x4.hpp>
@@ -16,11 +19,11 @@ public:
 
     [[nodiscard]]
     int XResolution() const
-        { return heightMap.GetWidth(); }
+        { return heights.XResolution(); }
 
     [[nodiscard]]
     int ZResolution() const
-        { return heightMap.GetHeight(); }
+        { return heights.ZResolution(); }
 
     void SetResolution(int xRes, int zRes);
 
@@ -34,11 +37,11 @@ public:
 
     [[nodiscard]]
     float XLength() const
-        { return xLen; }
+        { return heights.XLength(); }
 
     [[nodiscard]]
     float ZLength() const
-        { return zLen; }
+        { return heights.ZLength(); }
 
     [[nodiscard]]
     float InitThickness() const
@@ -46,55 +49,67 @@ public:
 
     [[nodiscard]]
     float BaseLevel() const
-        { return mainHeightMapCorner.Y(); }
+        { return heights.BaseLevel(); }
 
     [[nodiscard]]
     float PixelXLen() const
-        { return xLen / static_cast<float>(XResolution()); }
+        { return heights.PixelXLen(); }
 
     [[nodiscard]]
     float PixelZLen() const
-        { return zLen / static_cast<float>(ZResolution()); }
+        { return heights.PixelZLen(); }
 
     [[nodiscard]]
     float MinX() const
-        { return mainHeightMapCorner.X(); }
+        { return heights.MinX(); }
 
     [[nodiscard]]
     float MinZ() const
-        { return mainHeightMapCorner.Z(); }
+        { return heights.MinZ(); }
 
     [[nodiscard]]
-    float GlobalX(int x) const;
+    float GlobalX(const int x) const
+        { return heights.GlobalX(x); }
 
     [[nodiscard]]
-    float GlobalZ(int z) const;
+    float GlobalZ(const int z) const
+        { return heights.GlobalZ(z); }
 
     [[nodiscard]]
     float HeightAt(const int x, const int z) const
-        { return textureData[z*XResolution() + x]; }
+        { return heights.HeightAt(x, z); }
 
     void ChangeHeightAt(const int x, const int z, const float height)
-        { textureData[z*XResolution() + x] = height; }
+        { heights.ChangeHeightAt(x, z, height); }
 
-    void SyncVisualization()
-        { heightMap.Update(textureData.data(), Texture2D::Red); }
+    [[nodiscard]]
+    MaterialHeightMap& Heights()
+        { return heights; }
 
-    void Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos) const;
+    [[nodiscard]]
+    const MaterialHeightMap& Heights() const
+        { return heights; }
 
-private:
-    Texture2D heightMap;
-    std::vector<float> textureData;
+    /// @brief Uploads to the texture the region of heights changed since the last synchronization
+    void SyncVisualization();
 
-    alg::Vec3 mainHeightMapCorner;
+    /// @brief Uploads to the texture heights of the given region
+    void SyncVisualization(const PixelRect& region) const;
 
-    float xLen;
-    float zLen;
+    void Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos);
+
+private:
+    Texture2D heightMap;
+    MaterialHeightMap heights;
 
     float initThickness;
 
+    /// @brief Copy of the heights pyramid taken while synchronizing, so that rendering does not race with milling
+    HeightPyramid lodPyramid;
+    HeightMapLod lod;
+
     // Meshes
-    Mesh top;
+    Mesh topPatch;
     Mesh bottom;
     Mesh sideX;
     Mesh sideZ;
@@ -106,8 +121,10 @@ private:
 
     void UpdateMeshes();
 
-    [[nodiscard]] std::vector<float> GenerateMaterialTopVertices() const;
-    [[nodiscard]] std::vector<uint32_t> GenerateMaterialTopIndices() const;
+    void RenderTop(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos);
+
+    [[nodiscard]] static std::vector<float> GenerateTopPatchVertices();
+    [[nodiscard]] static std::vector<uint32_t> GenerateTopPatchIndices();
 
     [[nodiscard]] std::vector<float> GenerateMaterialBottomVertices() const;
     [[nodiscard]] std::vector<uint32_t> GenerateMaterialBottomIndices() const;
@@ -1,6 +1,11 @@
 #pragma once
 
-#include <map>
+#include "millingMachinePath.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 
 class MillingWarningsRepo {
@@ -11,19 +16,40 @@ public:
         MillingStraightDown = 1 << 2
     };
 
-    void AddWarning(int commandId, WarningType warningType);
+    class CommandWarnings {
+    public:
+        int commandId;
+        int warnings;
+    };
+
+    /// @brief Prepares warnings flags for every command of the path. Must not be called while milling.
+    void Reset(const MillingMachinePath& path);
+
+    /// @brief Thread safe and lock free, command is identified by its index in the path
+    void AddWarning(size_t commandIdx, WarningType warningType);
 
-    void Clear()
-        { warnings.clear(); }
+    void Clear();
 
+    /// @brief Removes warnings of the command and all the following ones, which are going to be milled again.
+    /// Must not be called while milling.
+    void ClearFrom(size_t commandIdx);
+
+    /// @brief Rebuilds the view returned by GetWarnings, if new warnings were added since the last call
+    void UpdateView();
+
+    /// @brief Commands with warnings sorted by the commands ids
     [[nodiscard]]
-    const auto& GetWarnings() const
-        { return warnings; }
+    const std::vector<CommandWarnings>& GetWarnings() const
+        { return view; }
 
     [[nodiscard]]
     bool Empty() const
-        { return warnings.empty(); }
+        { return view.empty(); }
 
 private:
-    std::map<int, int> warnings;
-};
\ No newline at end of file
+    std::unique_ptr<std::atomic_uint8_t[]> flags;
+    std::vector<int> commandsIds;
+
+    std::atomic_bool viewOutdated = false;
+    std::vector<CommandWarnings> view;
+};
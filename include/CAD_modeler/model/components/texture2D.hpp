@@ -20,6 +20,10 @@ public:
 
     void Update(const float *data, InputDataFormat inputFormat) const;
 
+    /// @brief Uploads only the rectangle of the texture. Data starts at the first pixel of the rectangle
+    /// and its rows are dataRowLength pixels long.
+    void UpdateRegion(const float *data, int dataRowLength, int x, int y, int regionWidth, int regionHeight, InputDataFormat inputFormat) const;
+
     void ChangeSize(int texWidth, int texHeight, const float *data, InputDataFormat inputFormat);
 
     void Use() const
@@ -58,6 +58,28 @@ public:
     void StartInstantSimulation() const
         { millingMachineSystem->StartInstantMilling(); }
 
+    [[nodiscard]]
+    bool InstantSimulationRuns() const
+        { return millingMachineSystem->InstantMillingRuns(); }
+
+    void SeekToCommand(const size_t command) const
+        { millingMachineSystem->SeekToCommand(command); }
+
+    [[nodiscard]]
+    size_t GetCurrentCommand() const
+        { return millingMachineSystem->GetCurrentCommand(); }
+
+    [[nodiscard]]
+    size_t GetCommandsCnt() const
+        { return millingMachineSystem->GetCommandsCnt(); }
+
+    [[nodiscard]]
+    const HeightMapCheckpoints& GetCheckpoints() const
+        { return millingMachineSystem->GetCheckpoints(); }
+
+    void SetCheckpointsMemoryBudget(const size_t budget) const
+        { millingMachineSystem->SetCheckpointsMemoryBudget(budget); }
+
     float GetCutterSpeed() const
         { return millingMachineSystem->GetCuterSpeed(); }
 
@@ -67,6 +89,9 @@ public:
     void SetCutterHeight(const float height)
         { millingMachineSystem->SetCutterHeight(height); }
 
+    void SetCutterProfile(const CutterProfile& profile)
+        { millingMachineSystem->SetCutterProfile(profile); }
+
     [[nodiscard]]
     std::optional<MillingCutter> GetMillingCutter() const
         { return millingMachineSystem->GetMillingCutter(); }
@@ -82,6 +107,13 @@ public:
     void ClearMillingWarnings()
         { millingMachineSystem->ClearWarnings(); }
 
+    void ValidateMillingPath() const
+        { millingMachineSystem->ValidatePaths(); }
+
+    [[nodiscard]]
+    const auto& GetValidationWarnings() const
+        { return millingMachineSystem->GetValidationWarnings(); }
+
 private:
     void RenderSystemsObjects(const alg::Mat4x4 &viewMtx, const alg::Mat4x4 &persMtx, float nearPlane,
         float farPlane) const override;
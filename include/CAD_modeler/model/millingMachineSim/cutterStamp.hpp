@@ -0,0 +1,60 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+#include "millingResult.hpp"
+
+#include "../components/millingCutter.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <vector>
+
+
+/// @brief Footprint of the cutter on the height map grid, precomputed for the cutter shape and the pixel size.
+/// Milling with the stamp gives exactly the same heights as evaluating MillingCutter::YCoordinate for each pixel.
+class CutterStamp {
+public:
+    CutterStamp(const MillingCutter& cutter, float pixelXLen, float pixelZLen);
+
+    [[nodiscard]]
+    bool Matches(const MillingCutter& cutter, float pixelXLen, float pixelZLen) const;
+
+    [[nodiscard]]
+    int RadiusInPixelsX() const
+        { return radiusInPixelsX; }
+
+    [[nodiscard]]
+    int RadiusInPixelsZ() const
+        { return radiusInPixelsZ; }
+
+    /// @brief Lowers the height map to the cutter, which tip is placed in the given position
+    MillingResult Mill(MaterialHeightMap& heightMap, const alg::Vec3& cutterPos) const
+        { return Mill(heightMap, cutterPos, heightMap.Bounds()); }
+
+    /// @brief Lowers the height map to the cutter, changing only pixels inside the clip rectangle
+    MillingResult Mill(MaterialHeightMap& heightMap, const alg::Vec3& cutterPos, const PixelRect& clip) const;
+
+private:
+    MillingCutter cutter;
+
+    float pixelXLen;
+    float pixelZLen;
+
+    int radiusInPixelsX;
+    int radiusInPixelsZ;
+
+    /// @brief For each row of the stamp, the biggest distance in pixels from the middle column,
+    /// on which the cutter might touch the material (-1 if the row is never touched)
+    std::vector<int> rowsHalfWidths;
+
+    /// @brief Flat and round cutters are computed in closed form, which can be vectorized,
+    /// other ones are evaluated with their profile lookup
+    enum class Kernel {
+        Flat,
+        Round,
+        Profile
+    };
+
+    template <Kernel kernel>
+    MillingResult MillRows(MaterialHeightMap& heightMap, const alg::Vec3& cutterPos, const PixelRect& clip) const;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+#include "targetHeights.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class DeviationSettings {
+public:
+    /// @brief Deviations not bigger than the tolerance are counted as neither undercut nor overcut
+    float tolerance = 0.001f;
+
+    /// @brief Histogram covers the deviations from -histogramRange to histogramRange,
+    /// deviations outside of it are counted in the outer bins
+    float histogramRange = 0.05f;
+    int histogramBins = 50;
+
+    unsigned int threadsCnt = std::thread::hardware_concurrency();
+};
+
+
+/// @brief Comparison of the milled material with the target heights. Deviation of a pixel is the milled height
+/// minus the target one, so the positive deviation is the material left to remove (undercut)
+/// and the negative one is the material removed below the model (overcut).
+class DeviationReport {
+public:
+    float tolerance = 0.f;
+
+    size_t pixelsCnt = 0;
+    size_t undercutPixels = 0;
+    size_t overcutPixels = 0;
+
+    /// @brief Both are non-negative lengths
+    float maxUndercut = 0.f;
+    float maxOvercut = 0.f;
+
+    double meanDeviation = 0.0;
+    double meanAbsDeviation = 0.0;
+    double rmsDeviation = 0.0;
+
+    /// @brief Volume milled from the initial material
+    double removedVolume = 0.0;
+    double undercutVolume = 0.0;
+    double overcutVolume = 0.0;
+
+    float histogramRange = 0.f;
+    std::vector<size_t> histogram;
+};
+
+
+/// @brief Compares the milled heights with the target, processing rows of the height map in parallel.
+/// The result does not depend on the threads count. Throws std::invalid_argument if the grids do not match.
+[[nodiscard]]
+DeviationReport AnalyzeDeviation(
+    const MaterialHeightMap& heightMap,
+    const TargetHeights& target,
+    float initHeight,
+    const DeviationSettings& settings = {}
+);
+
+
+/// @brief Writes the deviations as a binary PPM image. Pixels within the tolerance are green, undercut pixels go from
+/// white to blue and overcut ones from white to red, reaching the full color at the given range.
+/// Image rows follow the z axis and columns the x axis.
+void SaveDeviationImage(
+    const MaterialHeightMap& heightMap,
+    const TargetHeights& target,
+    const std::string& filePath,
+    float tolerance,
+    float range
+);
+
+
+/// @brief Writes the report as a JSON object, so that different toolpaths can be compared by scripts
+void SaveDeviationReportJson(const DeviationReport& report, const std::string& filePath);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../components/millingMachinePath.hpp"
+
+#include <optional>
+#include <string_view>
+
+
+/// @brief Streaming parser of the milling programs. Supports N, G00, G01, X, Y and Z words in any order,
+/// modal motion and coordinates, comments and both LF and CRLF line endings. Other words are skipped.
+class GCodeParser {
+public:
+    /// @brief Converts G-code coordinates to the modeler ones, scaling them by the given factor
+    explicit GCodeParser(float scale);
+
+    /// @brief Parses the whole program, throws std::invalid_argument with the line number on errors
+    [[nodiscard]]
+    MillingMachinePath Parse(std::string_view gCode);
+
+private:
+    float scale;
+
+    std::optional<float> x;
+    std::optional<float> y;
+    std::optional<float> z;
+
+    std::optional<int> motion;
+
+    void ParseLine(std::string_view line, int lineNumber, MillingMachinePath& path);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../components/millingMachinePath.hpp"
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+
+/// @brief Writes milling paths as G01 moves. Numbers are formatted with std::to_chars into a reusable buffer,
+/// which is flushed to the stream in big chunks. Coordinates, which did not change, are omitted.
+class GCodeWriter {
+public:
+    /// @brief Converts the modeler coordinates to the G-code ones, dividing them by the given scale
+    explicit GCodeWriter(float scale);
+
+    /// @brief Throws std::invalid_argument, if any coordinate is too big to be formatted
+    void Write(const MillingMachinePath& path, std::ostream& out);
+
+private:
+    static constexpr size_t flushThreshold = 1 << 20;
+    static constexpr int precision = 3;
+
+    class FormattedFloat {
+    public:
+        std::array<char, 32> chars{};
+        size_t length = 0;
+
+        bool operator==(const FormattedFloat& other) const
+            { return std::string_view(chars.data(), length) == std::string_view(other.chars.data(), other.length); }
+    };
+
+    float scale;
+    std::string buffer;
+
+    static FormattedFloat Format(float value);
+
+    void Append(const FormattedFloat& value)
+        { buffer.append(value.chars.data(), value.length); }
+
+    void AppendInt(int value);
+};
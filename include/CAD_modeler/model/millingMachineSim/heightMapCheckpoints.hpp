@@ -0,0 +1,120 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+/// @brief Snapshots of the height map taken while milling a path, so that the simulation can jump back
+/// to any command without milling the path from its beginning. Every checkpoint stores only the tiles changed
+/// since the previous one, and tiles with all heights equal are stored as a single value.
+/// When the snapshots exceed the memory budget, checkpoints are merged into their successors.
+class HeightMapCheckpoints {
+public:
+    static constexpr size_t defaultCommandsInterval = 2000;
+    static constexpr double defaultTimeInterval = 60.0;
+    static constexpr size_t defaultMemoryBudget = 256ull << 20;
+
+    explicit HeightMapCheckpoints(
+        size_t commandsInterval = defaultCommandsInterval,
+        double timeInterval = defaultTimeInterval,
+        size_t memoryBudget = defaultMemoryBudget
+    );
+
+    /// @brief Drops all the checkpoints and saves the height map as the first one
+    void Reset(const MaterialHeightMap& heightMap, size_t command, double simulatedTime = 0.0);
+
+    /// @brief Drops all the checkpoints, Reset has to be called before taking new ones
+    void Clear();
+
+    [[nodiscard]]
+    bool Empty() const
+        { return checkpoints.empty(); }
+
+    /// @brief Checks, if the state before milling the command should be saved
+    [[nodiscard]]
+    bool Due(size_t command, double simulatedTime) const;
+
+    /// @brief Saves the height map as the state before milling the command. The command has to be after the last checkpoint.
+    void Take(const MaterialHeightMap& heightMap, size_t command, double simulatedTime);
+
+    class Restored {
+    public:
+        size_t command;
+        double simulatedTime;
+    };
+
+    /// @brief Restores the latest checkpoint not after the command and drops all the later ones,
+    /// because milling continues from the restored state. Height ranges of the height map are refreshed.
+    Restored Restore(MaterialHeightMap& heightMap, size_t command);
+
+    [[nodiscard]]
+    size_t CheckpointsCnt() const
+        { return checkpoints.size(); }
+
+    [[nodiscard]]
+    size_t CheckpointCommand(const size_t idx) const
+        { return checkpoints[idx].command; }
+
+    [[nodiscard]]
+    size_t MemoryUsage() const
+        { return memoryUsage; }
+
+    [[nodiscard]]
+    size_t MemoryBudget() const
+        { return memoryBudget; }
+
+    void SetMemoryBudget(size_t budget);
+
+    [[nodiscard]]
+    size_t CommandsInterval() const
+        { return commandsInterval; }
+
+    void SetCommandsInterval(const size_t interval)
+        { commandsInterval = interval; }
+
+    [[nodiscard]]
+    double TimeInterval() const
+        { return timeInterval; }
+
+    void SetTimeInterval(const double interval)
+        { timeInterval = interval; }
+
+private:
+    /// @brief Heights of the tile: empty for the untouched tile, a single value if all the heights are equal
+    class TileSnapshot {
+    public:
+        int tile;
+        std::vector<float> heights;
+    };
+
+    class Checkpoint {
+    public:
+        size_t command;
+        double simulatedTime;
+        std::vector<TileSnapshot> tiles;
+    };
+
+    std::vector<Checkpoint> checkpoints;
+
+    std::vector<std::uint32_t> savedVersions;
+    float fillHeight = 0.f;
+    int tilesX = 0;
+    int tilesZ = 0;
+
+    size_t commandsInterval;
+    double timeInterval;
+    size_t memoryBudget;
+    size_t memoryUsage = 0;
+
+    void SaveTile(const MaterialHeightMap& heightMap, int tile, Checkpoint& checkpoint);
+
+    /// @brief Merges checkpoints, which are the closest to their neighbours, until the memory budget is met
+    void FitInBudget();
+
+    void MergeIntoNext(size_t idx);
+
+    [[nodiscard]]
+    static size_t MemoryOf(const TileSnapshot& snapshot);
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+
+#include <string>
+
+
+/// @brief Writes the heights as a 16-bit binary PGM image, with the heights from the base level to the top height
+/// mapped to the whole gray range. Image rows follow the z axis and columns the x axis.
+void SaveHeightMapPGM(const MaterialHeightMap& heightMap, const std::string& filePath, float topHeight);
+
+
+/// @brief Writes the heights as raw 32-bit floats in the machine byte order, row after row along the z axis
+void SaveHeightMapRaw(const MaterialHeightMap& heightMap, const std::string& filePath);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "heightPyramid.hpp"
+#include "materialHeightMap.hpp"
+#include "pixelRect.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <vector>
+
+
+/// @brief Quadtree level of detail for rendering the height map. The height map is covered by square patches,
+/// each drawn with the same grid of patchCells x patchCells quads, so patches close to the camera are small and detailed.
+/// Height ranges from the pyramid give the patches bounding boxes, which are used to measure the distance to the camera.
+class HeightMapLod {
+public:
+    static constexpr int patchCells = 32;
+
+    /// @brief Patch is split if the camera is closer to it than detail times its size
+    explicit HeightMapLod(float detail = 3.f);
+
+    /// @brief Patches covering the height map. Each one is a square of pixels with power of two size,
+    /// at least patchCells pixels wide, and might extend beyond the height map.
+    const std::vector<PixelRect>& SelectPatches(const MaterialHeightMap& heightMap, const HeightPyramid& pyramid, const alg::Vec3& cameraPos);
+
+private:
+    float detail;
+    std::vector<PixelRect> patches;
+
+    void SelectPatches(const MaterialHeightMap& heightMap, const HeightPyramid& pyramid, const alg::Vec3& cameraPos, const PixelRect& node);
+
+    [[nodiscard]]
+    static float DistanceToBox(const alg::Vec3& point, const alg::Vec3& boxMin, const alg::Vec3& boxMax);
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "pixelRect.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+/// @brief Minimal and maximal height of a part of the material
+class HeightRange {
+public:
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+
+    [[nodiscard]]
+    bool Empty() const
+        { return min > max; }
+
+    HeightRange& operator|=(const HeightRange& other) {
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+
+        return *this;
+    }
+};
+
+
+/// @brief Min/max mip pyramid over the height map tiles. The first level holds the range of every tile
+/// and each next level joins 2x2 cells of the previous one, up to a single cell covering the whole height map.
+class HeightPyramid {
+public:
+    void Reset(int tilesX, int tilesZ, float height);
+
+    /// @brief Sets the range of the tile and updates all the cells above it
+    void SetTile(int tileX, int tileZ, const HeightRange& range);
+
+    [[nodiscard]]
+    const HeightRange& Tile(const int tileX, const int tileZ) const
+        { return levels.front().At(tileX, tileZ); }
+
+    /// @brief Range of all the tiles in the rectangle given in the tiles coordinates
+    [[nodiscard]]
+    HeightRange RangeOfTiles(const PixelRect& tiles) const;
+
+    [[nodiscard]]
+    int LevelsCnt() const
+        { return static_cast<int>(levels.size()); }
+
+    /// @brief Range of the cell, which covers 2^level x 2^level tiles
+    [[nodiscard]]
+    const HeightRange& Cell(const int level, const int x, const int z) const
+        { return levels[level].At(x, z); }
+
+private:
+    class Level {
+    public:
+        int width;
+        int height;
+        std::vector<HeightRange> ranges;
+
+        [[nodiscard]]
+        const HeightRange& At(const int x, const int z) const
+            { return ranges[z*width + x]; }
+
+        [[nodiscard]]
+        HeightRange& At(const int x, const int z)
+            { return ranges[z*width + x]; }
+    };
+
+    std::vector<Level> levels;
+
+    void RangeOfTiles(int level, int x, int z, const PixelRect& tiles, HeightRange& result) const;
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "heightPyramid.hpp"
+#include "pixelRect.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+/// @brief Heights of the milled material top stored on CPU, together with its placement in the world.
+/// Heights are stored in square tiles. A tile, which was never written since the last fill, is not allocated
+/// and all its heights are equal to the fill height, so memory and reset cost depend only on the machined area.
+class MaterialHeightMap {
+public:
+    static constexpr int tileSizeLog2 = 6;
+    static constexpr int tileSize = 1 << tileSizeLog2;
+
+    MaterialHeightMap(int xResolution, int zResolution, float xLen, float zLen, float initHeight);
+
+    [[nodiscard]]
+    int XResolution() const
+        { return xResolution; }
+
+    [[nodiscard]]
+    int ZResolution() const
+        { return zResolution; }
+
+    void SetResolution(int xRes, int zRes, float height);
+
+    [[nodiscard]]
+    PixelRect Bounds() const
+        { return { .minX = 0, .minZ = 0, .maxX = xResolution, .maxZ = zResolution }; }
+
+    [[nodiscard]]
+    float XLength() const
+        { return xLen; }
+
+    [[nodiscard]]
+    float ZLength() const
+        { return zLen; }
+
+    void SetSize(float xLen, float zLen);
+
+    [[nodiscard]]
+    float BaseLevel() const
+        { return corner.Y(); }
+
+    void SetBaseLevel(const float level)
+        { corner.Y() = level; }
+
+    /// @brief Corner of the material with the minimal x and z coordinates, placed on the base level
+    [[nodiscard]]
+    const alg::Vec3& Corner() const
+        { return corner; }
+
+    [[nodiscard]]
+    float PixelXLen() const
+        { return xLen / static_cast<float>(xResolution); }
+
+    [[nodiscard]]
+    float PixelZLen() const
+        { return zLen / static_cast<float>(zResolution); }
+
+    [[nodiscard]]
+    float MinX() const
+        { return corner.X(); }
+
+    [[nodiscard]]
+    float MinZ() const
+        { return corner.Z(); }
+
+    [[nodiscard]]
+    float GlobalX(const int x) const
+        { return corner.X() + PixelXLen()/2.f + PixelXLen() * x; }
+
+    [[nodiscard]]
+    float GlobalZ(const int z) const
+        { return corner.Z() + PixelZLen()/2.f + PixelZLen() * z; }
+
+    [[nodiscard]]
+    float HeightAt(const int x, const int z) const
+        { const auto& tile = tiles[TileIdx(x, z)]; return tile.empty() ? fillHeight : tile[PixelInTileIdx(x, z)]; }
+
+    void ChangeHeightAt(const int x, const int z, const float height)
+        { MaterializedTile(x, z)[PixelInTileIdx(x, z)] = height; }
+
+    /// @brief Sets all the heights, releasing memory of all the tiles
+    void Fill(float height);
+
+    /// @brief Height of all the pixels in tiles, which were not written since the last fill
+    [[nodiscard]]
+    float FillHeight() const
+        { return fillHeight; }
+
+    [[nodiscard]]
+    int TilesX() const
+        { return tilesX; }
+
+    [[nodiscard]]
+    int TilesZ() const
+        { return tilesZ; }
+
+    [[nodiscard]]
+    bool IsTileMaterialized(const int tileX, const int tileZ) const
+        { return !tiles[tileZ*tilesX + tileX].empty(); }
+
+    [[nodiscard]]
+    size_t MaterializedTilesCnt() const;
+
+    /// @brief Pixels of the tile, clipped to the height map bounds
+    [[nodiscard]]
+    PixelRect TileRect(int tileX, int tileZ) const;
+
+    /// @brief Tiles, which have at least one pixel in the region, given in the tiles coordinates
+    [[nodiscard]]
+    static PixelRect TilesOf(const PixelRect& region);
+
+    /// @brief Counter increased every time the tile is marked changed or the height map is filled
+    [[nodiscard]]
+    std::uint32_t TileVersion(const int tileX, const int tileZ) const
+        { return tileVersions[tileZ*tilesX + tileX]; }
+
+    /// @brief Replaces heights of the tile with the given ones, stored row after row like in TileData.
+    /// Empty heights release the tile, so it contains only the fill height. The tile has to be marked changed afterwards.
+    void RestoreTile(int tileX, int tileZ, const std::vector<float>& heights);
+
+    /// @brief Allocates all the tiles overlapping the region, so they can be written from many threads at once
+    void Materialize(const PixelRect& region);
+
+    /// @brief Pointer to the pixel in the tile, which is allocated if needed. Following pixels of the tile row
+    /// are placed just after it. Allocating a tile is not thread safe.
+    [[nodiscard]]
+    float* MaterializedRow(const int x, const int z)
+        { return MaterializedTile(x, z).data() + PixelInTileIdx(x, z); }
+
+    /// @brief Heights of the tile stored row after row, each row is tileSize pixels long
+    [[nodiscard]]
+    const float* TileData(const int tileX, const int tileZ) const
+        { const auto& tile = tiles[tileZ*tilesX + tileX]; return tile.empty() ? fillTile.data() : tile.data(); }
+
+    /// @brief Recomputes height ranges of the tiles, which were marked changed since the last refresh
+    void RefreshHeightRanges();
+
+    /// @brief Upper bound of the heights in the region. Milling only lowers the material, so it stays valid
+    /// also when ranges were not refreshed after milling. Returns -infinity for an empty region.
+    [[nodiscard]]
+    float MaxHeight(const PixelRect& region) const;
+
+    /// @brief The lowest height in the region, exact if the height ranges are refreshed. Returns infinity for an empty region.
+    [[nodiscard]]
+    float MinHeight(const PixelRect& region) const;
+
+    /// @brief Min/max pyramid over the tiles, valid after refreshing the height ranges
+    [[nodiscard]]
+    const HeightPyramid& Pyramid() const
+        { return pyramid; }
+
+    /// @brief Copies heights of the whole row to the destination, which has space for XResolution values
+    void CopyRow(int z, float* destination) const;
+
+    /// @brief Region, which might have been changed since the last time it was cleared
+    [[nodiscard]]
+    const PixelRect& ChangedRegion() const
+        { return changedRegion; }
+
+    /// @brief Marks the region as changed for the visualization and its tiles height ranges as outdated
+    void MarkChanged(const PixelRect& region);
+
+    void ClearChangedRegion()
+        { changedRegion = {}; }
+
+private:
+    /// @brief Empty tiles are not allocated and contain only the fill height
+    std::vector<std::vector<float>> tiles;
+    std::vector<float> fillTile;
+    float fillHeight;
+
+    int xResolution;
+    int zResolution;
+
+    int tilesX;
+    int tilesZ;
+
+    alg::Vec3 corner;
+
+    float xLen;
+    float zLen;
+
+    PixelRect changedRegion;
+
+    HeightPyramid pyramid;
+    std::vector<std::uint8_t> outdatedRanges;
+    std::vector<int> outdatedTiles;
+
+    std::vector<std::uint32_t> tileVersions;
+
+    [[nodiscard]]
+    HeightRange ComputeTileRange(int tileX, int tileZ) const;
+
+    [[nodiscard]]
+    int TileIdx(const int x, const int z) const
+        { return (z >> tileSizeLog2) * tilesX + (x >> tileSizeLog2); }
+
+    [[nodiscard]]
+    static int PixelInTileIdx(const int x, const int z)
+        { return (z & (tileSize - 1)) * tileSize + (x & (tileSize - 1)); }
+
+    std::vector<float>& MaterializedTile(int x, int z);
+};
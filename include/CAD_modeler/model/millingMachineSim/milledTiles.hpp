@@ -0,0 +1,72 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+#include "pixelRect.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+/// @brief Tiles of the height map, which were completely milled by the worker threads and were not yet
+/// taken by the rendering thread. Heights of the published tile do not change until the milling ends
+/// or the tiles are retracted, so they can be read without synchronization by the thread, which took the tile.
+/// Every tile is guarded by its own state flag instead of the heights snapshots, which would double the memory
+/// of the height map: the release store of Published makes the heights visible to the reading thread and the
+/// release store of Idle after the read makes the read finish before the worker writes the tile again.
+class MilledTiles {
+public:
+    /// @brief Prepares tiles grid for the height map. Must not be called while milling.
+    void Reset(const MaterialHeightMap& heightMap, int tileSize);
+
+    [[nodiscard]]
+    int TilesX() const
+        { return tilesX; }
+
+    [[nodiscard]]
+    int TilesZ() const
+        { return tilesZ; }
+
+    /// @brief Called by the worker thread, after all sections touching the tile were milled
+    void Publish(const int tile)
+        { states[tile].store(Published, std::memory_order_release); }
+
+    /// @brief Calls the function for every tile published since the last call
+    template <typename Func>
+    void TakePublished(Func func) {
+        for (int tile = 0; tile < tilesX*tilesZ; ++tile) {
+            std::uint8_t expected = Published;
+            if (!states[tile].compare_exchange_strong(expected, Taken, std::memory_order_acquire))
+                continue;
+
+            func(TileRect(tile));
+            states[tile].store(Idle, std::memory_order_release);
+        }
+    }
+
+    /// @brief Called by the worker thread before it changes heights of the published tiles again. Waits until
+    /// the tiles being taken are read and withdraws the ones not taken yet, which are appended to the retracted tiles.
+    /// Worker waits at every tile at most for its single upload to the texture, so one call waits at most as long,
+    /// as uploading the whole height map. It is called once per part of the path between the checkpoints.
+    void Retract(std::vector<int>& retracted);
+
+    [[nodiscard]]
+    PixelRect TileRect(int tile) const;
+
+private:
+    enum TileState : std::uint8_t {
+        Idle,
+        Published,
+        Taken
+    };
+
+    std::unique_ptr<std::atomic_uint8_t[]> states;
+
+    int tileSize = 0;
+    int tilesX = 0;
+    int tilesZ = 0;
+
+    int xResolution = 0;
+    int zResolution = 0;
+};
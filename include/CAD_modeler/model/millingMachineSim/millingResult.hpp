@@ -0,0 +1,38 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+
+#include <algorithm>
+
+
+/// @brief Summary of the material removed by a milling operation, used to report warnings once per operation
+class MillingResult {
+public:
+    bool materialRemoved = false;
+    bool underTheBase = false;
+    bool tooDeep = false;
+
+    MillingResult& operator|=(const MillingResult& other) {
+        materialRemoved |= other.materialRemoved;
+        underTheBase |= other.underTheBase;
+        tooDeep |= other.tooDeep;
+
+        return *this;
+    }
+};
+
+
+/// @brief Lowers a single pixel of the height map to the cutter level
+inline void MillPixel(MaterialHeightMap& heightMap, const int x, const int z, const float cutterY, const float cutterHeight, MillingResult& result)
+{
+    const float oldHeight = heightMap.HeightAt(x, z);
+    if (oldHeight <= cutterY)
+        return;
+
+    // Pixel is set to the cutter height, subtracting the difference might leave it above because of the rounding
+    heightMap.ChangeHeightAt(x, z, cutterY);
+
+    result.materialRemoved = true;
+    result.underTheBase |= cutterY < heightMap.BaseLevel();
+    result.tooDeep |= oldHeight - cutterY > cutterHeight;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+#include "milledTiles.hpp"
+#include "millingResult.hpp"
+#include "tiledMiller.hpp"
+
+#include "../components/millingCutter.hpp"
+#include "../components/millingMachinePath.hpp"
+#include "../components/millingWarningsRepo.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <limits>
+#include <stop_token>
+#include <vector>
+
+
+/// @brief End command meaning, that the path is milled to its last command
+inline constexpr size_t pathEnd = std::numeric_limits<size_t>::max();
+
+
+/// @brief Sections between consecutive commands, which end in the commands from the first one up to,
+/// but excluding, the end command
+[[nodiscard]]
+std::vector<MillingSection> PathSections(const MillingMachinePath& path, size_t firstCommand = 1, size_t endCommand = pathEnd);
+
+
+/// @brief Length of the sections ending in the commands from the first one up to, but excluding, the end command
+[[nodiscard]]
+float PathLength(const MillingMachinePath& path, size_t firstCommand = 1, size_t endCommand = pathEnd);
+
+
+/// @brief Mills the path from the given command up to the end command and reports warnings of the milled commands
+void MillPath(
+    const TiledMiller& miller,
+    MaterialHeightMap& heightMap,
+    const MillingCutter& cutter,
+    const MillingMachinePath& path,
+    MillingWarningsRepo& warnings,
+    size_t firstCommand = 1,
+    size_t endCommand = pathEnd,
+    const std::stop_token& stoken = {},
+    MilledTiles* milledTiles = nullptr
+);
+
+
+/// @brief Adds warnings of the command, which milling gave the result
+void ReportMillingWarnings(MillingWarningsRepo& warnings, size_t commandIdx, const MillingResult& result, bool straightDown);
+
+
+[[nodiscard]]
+bool IsStraightDown(const alg::Vec3& oldCutterPos, const alg::Vec3& newCutterPos);
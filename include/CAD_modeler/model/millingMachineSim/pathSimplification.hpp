@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../components/millingMachinePath.hpp"
+
+
+/// @brief Removes commands, which are closer than the tolerance to the path without them (Douglas-Peucker in 3D).
+/// Collinear moves are merged into a single one, the first and the last command are always kept.
+[[nodiscard]]
+MillingMachinePath SimplifyPath(const MillingMachinePath& path, float tolerance);
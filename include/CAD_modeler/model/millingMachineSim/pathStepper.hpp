@@ -0,0 +1,102 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+
+#include "../components/millingCutter.hpp"
+#include "../components/millingMachinePath.hpp"
+#include "../components/millingWarningsRepo.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+
+/// @brief Moves the cutter along the path and mills the material on its own thread, consuming the simulated time
+/// added by the rendering thread. Milling is done in slices limited by the wall-clock budget and the height map
+/// is unlocked between them, so the rendering thread never waits longer than a single slice. If milling is slower
+/// than the simulated time passes, the remaining time is kept and caught up in the next slices.
+class PathStepper {
+public:
+    /// @brief Called on the stepper thread, with the height map locked, every time the cutter reaches a command destination
+    using CommandMilledCallback = std::function<void(size_t nextCommand, double simulatedTime)>;
+
+    class Progress {
+    public:
+        /// @brief Command, to which destination the cutter moves
+        size_t command = 1;
+        alg::Vec3 cutterPos;
+        double simulatedTime = 0.0;
+
+        /// @brief Simulated time added to the stepper, which was not milled yet
+        double pendingTime = 0.0;
+
+        bool finished = false;
+    };
+
+    explicit PathStepper(std::chrono::microseconds sliceBudget = std::chrono::milliseconds(4));
+
+    PathStepper(const PathStepper&) = delete;
+    PathStepper& operator=(const PathStepper&) = delete;
+
+    /// @brief Starts moving the cutter from the given progress. All the objects have to live until the stepper is stopped.
+    void Start(
+        MaterialHeightMap& heightMap,
+        const MillingCutter& cutter,
+        const MillingMachinePath& path,
+        MillingWarningsRepo& warnings,
+        const Progress& start,
+        CommandMilledCallback onCommandMilled = {}
+    );
+
+    /// @brief Stops the stepper thread and returns its final progress
+    Progress Stop();
+
+    [[nodiscard]]
+    bool Runs() const
+        { return thread.joinable(); }
+
+    /// @brief Cutter speed in the modeler units per second of the simulated time
+    void SetSpeed(float speed);
+
+    /// @brief Adds the simulated time, which the stepper should mill
+    void AddTime(double dt);
+
+    [[nodiscard]]
+    Progress GetProgress() const;
+
+    /// @brief Locks the height map, so that it can be read by another thread in between the milling slices.
+    /// The actual slice is ended early, so the caller waits at most for a single section to be milled.
+    [[nodiscard]]
+    std::unique_lock<std::mutex> LockHeightMap();
+
+private:
+    std::chrono::microseconds sliceBudget;
+
+    /// @brief Held by the stepper thread while milling a slice
+    std::mutex heightMapMutex;
+    std::atomic_bool heightMapRequested = false;
+
+    /// @brief Guards the progress and the speed, never held while milling
+    mutable std::mutex stateMutex;
+    std::condition_variable_any timeAdded;
+
+    Progress progress;
+    float speed = 0.f;
+
+    std::jthread thread;
+
+    void Run(
+        const std::stop_token& stoken,
+        MaterialHeightMap& heightMap,
+        const MillingCutter& cutter,
+        const MillingMachinePath& path,
+        MillingWarningsRepo& warnings,
+        const CommandMilledCallback& onCommandMilled
+    );
+};
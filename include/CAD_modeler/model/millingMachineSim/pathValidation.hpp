@@ -0,0 +1,22 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+
+#include "../components/millingCutter.hpp"
+#include "../components/millingMachinePath.hpp"
+#include "../components/millingWarningsRepo.hpp"
+
+#include <thread>
+
+
+/// @brief Checks the path against the material heights without milling it and adds the warnings, which milling
+/// the commands could give. Commands are checked independently and in parallel, comparing the cutter with the highest
+/// material under its footprint taken from the height pyramid. Material removed by the earlier commands is not taken
+/// into account, so the warnings are potential ones: milling never reports a warning not found by the validation.
+void ValidatePath(
+    const MaterialHeightMap& heightMap,
+    const MillingCutter& cutter,
+    const MillingMachinePath& path,
+    MillingWarningsRepo& warnings,
+    unsigned int threadsCnt = std::thread::hardware_concurrency()
+);
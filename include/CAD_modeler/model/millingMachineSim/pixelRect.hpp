@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+
+
+/// @brief Rectangle of the height map pixels, minimal coordinates are inclusive and maximal exclusive
+class PixelRect {
+public:
+    int minX = 0;
+    int minZ = 0;
+    int maxX = 0;
+    int maxZ = 0;
+
+    [[nodiscard]]
+    bool Empty() const
+        { return minX >= maxX || minZ >= maxZ; }
+
+    [[nodiscard]]
+    bool Contains(const int x, const int z) const
+        { return x >= minX && x < maxX && z >= minZ && z < maxZ; }
+
+    [[nodiscard]]
+    PixelRect Intersection(const PixelRect& other) const {
+        return {
+            .minX = std::max(minX, other.minX),
+            .minZ = std::max(minZ, other.minZ),
+            .maxX = std::min(maxX, other.maxX),
+            .maxZ = std::min(maxZ, other.maxZ)
+        };
+    }
+
+    /// @brief The smallest rectangle containing both rectangles
+    [[nodiscard]]
+    PixelRect Union(const PixelRect& other) const {
+        if (Empty())
+            return other;
+
+        if (other.Empty())
+            return *this;
+
+        return {
+            .minX = std::min(minX, other.minX),
+            .minZ = std::min(minZ, other.minZ),
+            .maxX = std::max(maxX, other.maxX),
+            .maxZ = std::max(maxZ, other.maxZ)
+        };
+    }
+
+    [[nodiscard]]
+    int Width() const
+        { return maxX - minX; }
+
+    [[nodiscard]]
+    int Height() const
+        { return maxZ - minZ; }
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "cutterStamp.hpp"
+#include "materialHeightMap.hpp"
+#include "millingResult.hpp"
+#include "pixelRect.hpp"
+
+#include "../components/millingCutter.hpp"
+
+#include <algebra/vec3.hpp>
+
+
+/// @brief Mills the material along the straight cutter move, changing only pixels inside the clip rectangle.
+/// Each pixel is lowered once to the bottom of the volume swept by the cutter.
+/// Milling the same section with disjoint clip rectangles gives the same heights as milling it at once.
+MillingResult MillPathSection(
+    MaterialHeightMap& heightMap,
+    const MillingCutter& cutter,
+    const CutterStamp& stamp,
+    const alg::Vec3& oldCutterPos,
+    const alg::Vec3& newCutterPos,
+    const PixelRect& clip
+);
+
+
+/// @brief Pixels of the height map, which might be changed by milling the section
+[[nodiscard]]
+PixelRect SectionFootprint(
+    const MaterialHeightMap& heightMap,
+    const CutterStamp& stamp,
+    const alg::Vec3& oldCutterPos,
+    const alg::Vec3& newCutterPos
+);
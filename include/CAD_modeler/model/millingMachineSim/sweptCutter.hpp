@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../components/millingCutter.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+
+/// @brief Range of the x coordinates covered by the cutter in a single row of the height map
+class RowSpan {
+public:
+    float minX;
+    float maxX;
+};
+
+
+/// @brief Volume swept by the cutter, which tip moves along a straight line.
+/// Heights of its bottom are computed in closed form for flat and round cutters, without sampling the move.
+/// For the other profiles, the lowest point is found by minimizing the convex height along the move.
+class SweptCutter {
+public:
+    SweptCutter(const MillingCutter& cutter, const alg::Vec3& start, const alg::Vec3& end);
+
+    /// @brief True if the cutter moves only vertically
+    [[nodiscard]]
+    bool IsPlunge() const
+        { return dirX == 0.f && dirZ == 0.f; }
+
+    [[nodiscard]]
+    float MinZ() const
+        { return std::min(start.Z(), end.Z()) - cutter.radius; }
+
+    [[nodiscard]]
+    float MaxZ() const
+        { return std::max(start.Z(), end.Z()) + cutter.radius; }
+
+    /// @brief Range of x coordinates covered by the cutter in the given z, if any
+    [[nodiscard]]
+    std::optional<RowSpan> Span(float z) const;
+
+    /// @brief Lowest point of the swept cutter above the given point or infinity if the cutter does not pass over it
+    [[nodiscard]]
+    float LowestPoint(float x, float z) const;
+
+private:
+    MillingCutter cutter;
+
+    alg::Vec3 start;
+    alg::Vec3 end;
+
+    float dirX;
+    float dirZ;
+
+    /// @brief Range of the move parameters, in which the cutter is over the given point
+    [[nodiscard]]
+    std::optional<std::pair<double, double>> CoveringRange(float x, float z) const;
+
+    [[nodiscard]]
+    float FlatLowestPoint(float x, float z) const;
+
+    [[nodiscard]]
+    float RoundLowestPoint(float x, float z) const;
+
+    [[nodiscard]]
+    float ProfileLowestPoint(float x, float z) const;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/// @brief Heights of the designed model over the material, sampled in the same grid as the material height map.
+/// It is the reference, to which the milled material is compared. Rows follow the z axis and columns the x axis.
+class TargetHeights {
+public:
+    static constexpr std::string_view extension = ".thm";
+
+    TargetHeights(int xResolution, int zResolution, float xLen, float zLen, float height = 0.f);
+
+    [[nodiscard]]
+    int XResolution() const
+        { return xResolution; }
+
+    [[nodiscard]]
+    int ZResolution() const
+        { return zResolution; }
+
+    [[nodiscard]]
+    float XLength() const
+        { return xLen; }
+
+    [[nodiscard]]
+    float ZLength() const
+        { return zLen; }
+
+    [[nodiscard]]
+    float HeightAt(const int x, const int z) const
+        { return heights[z * xResolution + x]; }
+
+    void SetHeightAt(const int x, const int z, const float height)
+        { heights[z * xResolution + x] = height; }
+
+    [[nodiscard]]
+    const float* Row(const int z) const
+        { return heights.data() + z * xResolution; }
+
+    /// @brief Writes the header with the grid description, followed by the heights as 32-bit floats row after row
+    void Save(const std::string& filePath) const;
+
+    /// @brief Throws std::invalid_argument if the file is not a valid target heights file
+    [[nodiscard]]
+    static TargetHeights Load(const std::string& filePath);
+
+private:
+    static constexpr std::uint32_t magic = 0x314D4854; // "THM1"
+    static constexpr std::uint32_t version = 1;
+
+    class Header {
+    public:
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t xResolution;
+        std::int32_t zResolution;
+        float xLen;
+        float zLen;
+    };
+
+    int xResolution;
+    int zResolution;
+    float xLen;
+    float zLen;
+
+    std::vector<float> heights;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "materialHeightMap.hpp"
+#include "milledTiles.hpp"
+#include "millingResult.hpp"
+
+#include "../components/millingCutter.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+/// @brief Straight move of the cutter tip
+class MillingSection {
+public:
+    alg::Vec3 start;
+    alg::Vec3 end;
+};
+
+
+/// @brief Mills many path sections in parallel. The height map is split into square tiles and each tile
+/// mills the sections, which touch it, in the paths order, so heights and warnings are the same as in sequential milling.
+class TiledMiller {
+public:
+    explicit TiledMiller(int tileSize = 64, unsigned int threadsCnt = std::thread::hardware_concurrency());
+
+    [[nodiscard]]
+    int TileSize() const
+        { return tileSize; }
+
+    /// @brief Mills all the sections and returns the milling result of each of them.
+    /// If milled tiles are given, they have to be reset with this miller tile size, and every tile is published once it is milled.
+    std::vector<MillingResult> Mill(
+        MaterialHeightMap& heightMap,
+        const MillingCutter& cutter,
+        const std::vector<MillingSection>& sections,
+        const std::stop_token& stoken = {},
+        MilledTiles* milledTiles = nullptr
+    ) const;
+
+private:
+    int tileSize;
+    unsigned int threadsCnt;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../components/millingMachinePath.hpp"
+#include "../components/millingCutter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+/// @brief Compiled toolpath, which can be loaded without parsing. The file consists of the header with the cutter
+/// description and its profile parameters with the table profile points, followed by the commands stored
+/// in the MoveCommand memory layout (int32 id, float32 x, y, z), already in the modeler coordinates.
+/// Loaded commands are viewed directly in the memory mapped file. Files of the first version,
+/// without the profile, are still loaded.
+class ToolpathFile {
+public:
+    static constexpr std::string_view extension = ".ctp";
+
+    static void Save(const std::string& filePath, const MillingMachinePath& path, const MillingCutter& cutter);
+
+    class Toolpath {
+    public:
+        MillingMachinePath path;
+        MillingCutter cutter;
+    };
+
+    /// @brief Maps the file into the memory, throws std::invalid_argument if it is not a valid toolpath file
+    [[nodiscard]]
+    static Toolpath Load(const std::string& filePath);
+
+    [[nodiscard]]
+    static bool HasToolpathExtension(const std::string& filePath);
+
+private:
+    static constexpr std::uint32_t magic = 0x31505443; // "CTP1"
+    static constexpr std::uint32_t version = 2;
+
+    class Header {
+    public:
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t cutterType;
+        float cutterRadius;
+        float cutterHeight;
+        std::uint32_t reserved;
+        std::uint64_t commandsCnt;
+    };
+
+    /// @brief Follows the header since the second version
+    class ProfileHeader {
+    public:
+        float secondaryRadius;
+        float halfAngle;
+        std::uint32_t pointsCnt;
+        std::uint32_t reserved;
+    };
+
+    [[nodiscard]]
+    static CutterProfile ReadProfile(const Header& header, const ProfileHeader& profileHeader, const std::byte* points);
+};
@@ -11,6 +11,7 @@
 #include "systems/nameSystem.hpp"
 #include "systems/intersectionsSystem.hpp"
 #include "systems/interpolationCurvesRenderingSystem.hpp"
+#include "systems/intersectionPolylinesRenderingSystem.hpp"
 #include "systems/equidistanceC2SurfaceSystem.hpp"
 #include "systems/polylineSystem.hpp"
 
@@ -19,6 +20,7 @@
 #include "millingPathsDesigner/materialParameters.hpp"
 #include "millingPathsDesigner/millingSettings.hpp"
 #include "millingPathsDesigner/broadPhaseHeightMap.hpp"
+#include "millingPathsDesigner/cutterOffsetHeightMap.hpp"
 
 #include "../utilities/circularVector.hpp"
 
@@ -37,6 +39,10 @@ public:
 
     void GenerateMainPhase();
 
+    /// @brief Renders the model heights in the grid of the material height map and saves them
+    /// as the target, to which the simulated milling is compared
+    void ExportTargetHeights(const std::string& filePath, int xResolution, int zResolution);
+
 protected:
     void RenderSystemsObjects(
         const alg::Mat4x4 &viewMtx, const alg::Mat4x4 &persMtx, float nearPlane, float farPlane
@@ -59,6 +65,7 @@ private:
 
     std::shared_ptr<IntersectionSystem> intersectionSystem;
     std::shared_ptr<InterpolationCurvesRenderingSystem> interpolationCurvesRendering;
+    std::shared_ptr<IntersectionPolylinesRenderingSystem> intersectionPolylinesRendering;
 
     std::shared_ptr<PolylineSystem> polylineSystem;
 
@@ -67,11 +74,15 @@ private:
     MillingSettings millingSettings;
 
     BroadPhaseHeightMap GenerateBroadPhaseHeightMap();
-    float MinYCutterPos(const BroadPhaseHeightMap& heightMap, const MillingCutter& cutter, float cutterX, float cutterZ) const;
+
+    /// @brief Heights of the model seen from above, rasterized on the CPU without any graphics context
+    BroadPhaseHeightMap RenderModelHeightMap(int xResolution, int zResolution) const;
+
+    float MinYCutterPos(const BroadPhaseHeightMap& heightMap, const CutterOffsetHeightMap& offsets, float cutterX, float cutterZ) const;
 
     std::vector<Position> FindBoundary(float dist);
 
     CircularVector<Position> BoundaryPoints(Entity entity, float dist);
 
-    Position BoundaryPoint(const IntersectionPoint& p, const C2Patches& patches, float dist) const;
+    Position BoundaryPoint(const alg::Vec2& params, const C2Patches& patches, float dist) const;
 };
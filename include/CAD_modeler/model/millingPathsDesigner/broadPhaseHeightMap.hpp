@@ -26,7 +26,7 @@ public:
         { return -MaxX(); }
 
     float MinZ() const
-        { return -MaxX(); }
+        { return -MaxZ(); }
 
     float MaxX() const
         { return xSize / 2.f; }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "broadPhaseHeightMap.hpp"
+
+#include "../components/millingCutter.hpp"
+#include "../../utilities/flatVec2D.hpp"
+
+#include <span>
+#include <thread>
+#include <vector>
+
+
+/// @brief Lowest cutter tip heights, at which the cutter placed over the pixel centers does not cut into
+/// the height map. It is the grey-scale dilation of the heights by the cutter profile, computed once,
+/// so that each cutter position is found with a single lookup instead of scanning the cutter footprint.
+/// The map is extended by the cutter radius around the height map, where the cutter still touches it.
+/// Only the height map pixels are taken into account, its default height has to be applied by the caller.
+///
+/// The disc-shaped footprint is decomposed into rows, each of which is a one-dimensional dilation.
+/// Flat cutters use the van Herk/Gil-Werman max filter, which is linear in the row length.
+/// Other profiles are convex, so every row kernel is concave and the dilation is the upper envelope
+/// of the kernels translated to the pixels, as in the lower envelope algorithm for the distance transforms.
+///
+/// Neither the disc nor the cutter profiles are separable, so every row of the map combines the dilations of all
+/// the footprint rows and costs O(Z*R), or O(Z*R*log R) for the non flat cutters, where Z is the row length
+/// and R the cutter radius in pixels. Paths visit only a few rows, so only the rows under the given cutter positions
+/// are computed. For the passes spaced by the cutter radius it costs O(N), or O(N*log R), for the height map of N pixels.
+class CutterOffsetHeightMap {
+public:
+    /// @brief Computes the rows, in which the cutter is placed over the given X coordinates
+    CutterOffsetHeightMap(
+        const BroadPhaseHeightMap& heightMap,
+        const MillingCutter& cutter,
+        std::span<const float> cutterXs,
+        unsigned int threadsCnt = std::thread::hardware_concurrency()
+    );
+
+    /// @brief Lowest cutter tip height in the pixel nearest to the given point or minus infinity, if the cutter
+    /// placed there does not touch the height map
+    [[nodiscard]]
+    float MinCutterY(float x, float z) const;
+
+    /// @brief Value for the pixel of the height map, which can lie outside of it by the padding.
+    /// Throws std::invalid_argument for the pixels in the rows, which were not computed.
+    [[nodiscard]]
+    float At(int x, int z) const;
+
+    [[nodiscard]]
+    int PaddingX() const
+        { return paddingX; }
+
+    [[nodiscard]]
+    int PaddingZ() const
+        { return paddingZ; }
+
+private:
+    float minX, minZ;
+    float pixelXLen, pixelZLen;
+
+    int paddingX, paddingZ;
+
+    /// @brief Index of the computed row in the offsets for every row of the extended height map or -1
+    std::vector<int> rowsIndices;
+    FlatVec2D<float> offsets;
+
+    [[nodiscard]]
+    int PixelX(float x) const;
+};
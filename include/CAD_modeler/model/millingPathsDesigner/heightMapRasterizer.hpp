@@ -0,0 +1,43 @@
+#pragma once
+
+#include "broadPhaseHeightMap.hpp"
+
+#include "../systems/intersectionSystem/surface.hpp"
+
+#include <algebra/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+/// @brief Renders surfaces seen from above into the height map on the CPU, keeping the highest point over
+/// every pixel center, as the depth buffer of the orthographic camera looking down would. Surfaces are tessellated
+/// into triangles with their evaluation, so no graphics context is needed and the resolution is not limited.
+/// The height map is split into tiles, each of them rasterized by a single thread with the triangles binned to it,
+/// so the pixels are written without synchronization.
+class HeightMapRasterizer {
+public:
+    explicit HeightMapRasterizer(unsigned int threadsCnt = std::thread::hardware_concurrency(), int tileSize = 64);
+
+    /// @brief Tessellates the surface over its sampling domain into the grid with the given number of segments
+    /// for the unit of each parameter, which is a single patch of the C0 and C2 surfaces. Evaluation is parallel,
+    /// so the surface has to be safe to evaluate from many threads.
+    void AddSurface(interSys::Surface& surface, int segmentsPerUnit);
+
+    /// @brief Raises the pixels of the height map to the highest triangle point over their centers.
+    /// Pixels not covered by any triangle are left unchanged.
+    void Render(BroadPhaseHeightMap& heightMap) const;
+
+    [[nodiscard]]
+    size_t TrianglesCnt() const
+        { return triangles.size(); }
+
+private:
+    unsigned int threadsCnt;
+    int tileSize;
+
+    std::vector<alg::Vec3> vertices;
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+};
@@ -19,10 +19,10 @@ public:
 
     [[nodiscard]]
     const Position& GetLastPosition() const
-        { return path.commands.back().destination; }
+        { return path.Commands().back().destination; }
 
     void PopLastPosition()
-        { path.commands.pop_back(); }
+        { path.RemoveLastCommand(); }
 
     MillingMachinePath GetPaths()
         { return { std::move(path) }; }
@@ -8,5 +8,9 @@ public:
     float baseThickness = 0.17f;
     float broadPhaseAdditionalThickness = 0.02f;
 
+    /// @brief Resolution in both directions of the model height map, from which the broad phase paths are generated.
+    /// It is rasterized on the CPU, so it is not limited by the graphics context.
+    int heightMapResolution = 2000;
+
     alg::Vec3 initCutterPos = alg::Vec3(0.0f, 0.66f, 0.0f);
 };
@@ -27,6 +27,7 @@
 #include "systems/gregoryPatchesSystem.hpp"
 #include "systems/vectorSystem.hpp"
 #include "systems/intersectionsSystem.hpp"
+#include "systems/intersectionPolylinesRenderingSystem.hpp"
 
 #include "components/scale.hpp"
 #include "components/rotation.hpp"
@@ -341,6 +342,7 @@ private:
     std::shared_ptr<GregoryPatchesSystem> gregoryPatchesSystem;
     std::shared_ptr<VectorSystem> vectorSystem;
     std::shared_ptr<IntersectionSystem> intersectionSystem;
+    std::shared_ptr<IntersectionPolylinesRenderingSystem> intersectionPolylinesRenderingSystem;
 
     SaveManager saveManager;
     NameGenerator nameGenerator;
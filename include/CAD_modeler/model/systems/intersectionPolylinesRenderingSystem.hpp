@@ -0,0 +1,25 @@
+#pragma once
+
+#include <ecs/system.hpp>
+
+#include <algebra/mat4x4.hpp>
+
+#include "../components/intersectionPolyline.hpp"
+
+#include <vector>
+
+
+/// @brief Draws intersection curves directly as line strips through the traced points
+class IntersectionPolylinesRenderingSystem final : public System {
+public:
+    static void RegisterSystem(Coordinator& coordinator);
+
+    /// @brief Creates mesh of the intersection polyline, which is already attached to the entity
+    void AddPolyline(Entity entity);
+
+    void Render(const alg::Mat4x4& cameraMtx) const;
+
+private:
+    std::vector<float> GenerateMeshVertices(const IntersectionPolyline& polyline) const;
+    std::vector<uint32_t> GenerateMeshIndices(const IntersectionPolyline& polyline) const;
+};
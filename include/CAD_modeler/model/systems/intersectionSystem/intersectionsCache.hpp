@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ecs/entitiesManager.hpp>
+
+#include <algebra/vec3.hpp>
+
+#include "../../components/intersectionCurve.hpp"
+
+#include <unordered_map>
+#include <optional>
+#include <deque>
+
+
+namespace interSys
+{
+    /// @brief Traced intersections indexed by the intersected surfaces and hashes of their geometry
+    class IntersectionsCache {
+    public:
+        class Key {
+        public:
+            Entity surface1;
+            Entity surface2;
+            size_t surface1Hash;
+            size_t surface2Hash;
+            float step;
+            std::optional<alg::Vec3> guidance;
+            bool selfIntersection;
+
+            bool operator==(const Key&) const = default;
+        };
+
+        class Entry {
+        public:
+            std::deque<IntersectionPoint> points;
+            bool isOpen;
+        };
+
+        [[nodiscard]]
+        const Entry* Find(const Key& key) const;
+
+        void Insert(const Key& key, Entry entry);
+
+        /// @brief Removes all entries computed for the surface
+        void Invalidate(Entity surface);
+
+        /// @brief Stores actual hash of the surface geometry. If the geometry has changed,
+        /// entries computed for the previous one are removed.
+        void UpdateSurfaceHash(Entity surface, size_t hash);
+
+        [[nodiscard]]
+        bool TracksSurface(const Entity surface) const
+            { return surfacesHashes.contains(surface); }
+
+        /// @brief Removes all entries computed for the deleted surface and stops tracking its geometry
+        void RemoveSurface(Entity surface);
+
+        /// @brief Removes all entries, surfaces stay tracked
+        void Clear();
+
+        [[nodiscard]]
+        size_t Size() const
+            { return entries.size(); }
+
+    private:
+        struct KeyHash {
+            size_t operator() (const Key& key) const;
+        };
+
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        std::unordered_map<Entity, size_t> surfacesHashes;
+    };
+}
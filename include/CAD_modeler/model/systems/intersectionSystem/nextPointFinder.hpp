@@ -1,13 +1,14 @@
 #pragma once
 
 #include "surface.hpp"
+#include "solversTelemetry.hpp"
 #include "../../components/intersectionCurve.hpp"
 
 
 namespace interSys {
     class NextPointFinder {
     public:
-        NextPointFinder(Surface& s1, Surface& s2, const IntersectionPoint& firstPoint, float step);
+        NextPointFinder(Surface& s1, Surface& s2, const IntersectionPoint& firstPoint, float step, SolversTelemetry* telemetry = nullptr);
 
         bool FindNext();
 
@@ -27,6 +28,8 @@ namespace interSys {
         IntersectionPoint actPoint;
         float step;
 
+        SolversTelemetry* telemetry;
+
         bool wasLastPoint = false;
         bool firstPoint = true;
 
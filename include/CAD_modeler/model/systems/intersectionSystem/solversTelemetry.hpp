@@ -0,0 +1,44 @@
+#pragma once
+
+#include <rootFinding/solverStats.hpp>
+#include <optimization/solverStats.hpp>
+
+
+namespace interSys
+{
+    /// @brief Totals of numerical solvers work done while computing a single intersection curve
+    class SolversTelemetry {
+    public:
+        void Record(const root::SolverStats& stats) {
+            ++newtonCalls;
+            newtonIterations += stats.iterations;
+            newtonFunctionEvaluations += stats.functionEvaluations;
+            newtonJacobianEvaluations += stats.jacobianEvaluations;
+
+            if (stats.terminationReason != root::TerminationReason::Converged)
+                ++newtonFailures;
+        }
+
+        void Record(const opt::SolverStats& stats) {
+            ++gradientMethodCalls;
+            gradientMethodIterations += stats.iterations;
+            gradientMethodFunctionEvaluations += stats.functionEvaluations;
+            gradientMethodGradientEvaluations += stats.gradientEvaluations;
+
+            if (stats.terminationReason != opt::TerminationReason::StopConditionMet)
+                ++gradientMethodFailures;
+        }
+
+        int newtonCalls = 0;
+        int newtonFailures = 0;
+        int newtonIterations = 0;
+        int newtonFunctionEvaluations = 0;
+        int newtonJacobianEvaluations = 0;
+
+        int gradientMethodCalls = 0;
+        int gradientMethodFailures = 0;
+        int gradientMethodIterations = 0;
+        int gradientMethodFunctionEvaluations = 0;
+        int gradientMethodGradientEvaluations = 0;
+    };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "surface.hpp"
+
+#include "../../../utilities/flatVec2D.hpp"
+
+#include <algebra/vec2.hpp>
+#include <algebra/vec3.hpp>
+
+#include <vector>
+
+
+namespace interSys
+{
+    /// @brief Single connected part of the surface and plane intersection
+    class SliceContour {
+    public:
+        /// @brief Offset of the plane along its normal, for which the contour was found
+        float level;
+        bool isOpen;
+
+        /// @brief Points of the contour in the surface parameters space
+        std::vector<alg::Vec2> parameters;
+        std::vector<alg::Vec3> points;
+    };
+
+
+    /// @brief Intersects a surface with planes. The problem is reduced to finding contours of the scalar field
+    /// dot(S(u,v) - p0, n) with marching squares on a sampled parameters grid, refined with 1D Newton method.
+    /// The grid is sampled once, so slicing with many parallel planes is cheap.
+    class SurfaceSlicer {
+    public:
+        SurfaceSlicer(Surface& surface, int samplesU, int samplesV);
+
+        /// @brief Contours of the surface intersection with planes passing through
+        /// planePoint + level * normal for each of the levels.
+        [[nodiscard]]
+        std::vector<SliceContour> Slice(const alg::Vec3& planePoint, const alg::Vec3& normal, const std::vector<float>& levels);
+
+        [[nodiscard]]
+        std::vector<SliceContour> Slice(const alg::Vec3& planePoint, const alg::Vec3& normal)
+            { return Slice(planePoint, normal, { 0.f }); }
+
+    private:
+        Surface& surface;
+
+        const bool wrapU;
+        const bool wrapV;
+
+        /// @brief Number of cells of the grid in each direction
+        const int cellsU;
+        const int cellsV;
+
+        const float minU;
+        const float minV;
+        const float deltaU;
+        const float deltaV;
+
+        /// @brief Surface points in the grid nodes
+        FlatVec2D<alg::Vec3> points;
+
+        /// @brief Contours of the level of the field, which holds signed distances of grid nodes to the plane
+        [[nodiscard]]
+        std::vector<SliceContour> Contours(const FlatVec2D<float>& field, float level, const alg::Vec3& planePoint, const alg::Vec3& normal);
+
+        [[nodiscard]]
+        int NodesU() const
+            { return wrapU ? cellsU : cellsU + 1; }
+
+        [[nodiscard]]
+        int NodesV() const
+            { return wrapV ? cellsV : cellsV + 1; }
+
+        /// @brief Index of the grid edge between nodes (i, j) and (i+1, j)
+        [[nodiscard]]
+        int EdgeU(const int i, const int j) const
+            { return 2 * (j * cellsU + i); }
+
+        /// @brief Index of the grid edge between nodes (i, j) and (i, j+1)
+        [[nodiscard]]
+        int EdgeV(const int i, const int j) const
+            { return 2 * (i * cellsV + j) + 1; }
+
+        /// @brief Point, where the contour crosses the grid edge, refined with Newton method
+        alg::Vec2 EdgeCrossing(int edge, const FlatVec2D<float>& field, float level, const alg::Vec3& planePoint, const alg::Vec3& normal);
+    };
+}
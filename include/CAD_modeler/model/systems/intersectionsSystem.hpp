@@ -1,17 +1,21 @@
 #pragma once
 
 #include <ecs/system.hpp>
+#include <ecs/eventHandler.hpp>
 
 #include <optional>
 #include <memory>
 #include <tuple>
 #include <deque>
 
-#include "CAD_modeler/model/components/curveControlPoints.hpp"
 #include "CAD_modeler/model/components/position.hpp"
 #include "CAD_modeler/model/components/intersectionCurve.hpp"
+#include "CAD_modeler/model/components/intersectionPolyline.hpp"
 
 #include "intersectionSystem/surface.hpp"
+#include "intersectionSystem/solversTelemetry.hpp"
+#include "intersectionSystem/intersectionsCache.hpp"
+#include "intersectionSystem/surfaceSlicer.hpp"
 
 
 class IntersectionSystem final : public System {
@@ -28,7 +32,46 @@ public:
 
     std::optional<Entity> FindSelfIntersection(Entity e, float step, const Position& guidance);
 
+    /// @brief Contours of the surface intersection with planes parallel to the one given by planePoint and normal,
+    /// shifted along the normal by each of the levels. Much faster than tracing intersection with a plane surface.
+    [[nodiscard]]
+    std::vector<interSys::SliceContour> Slice(
+        Entity e, const alg::Vec3& planePoint, const alg::Vec3& normal, const std::vector<float>& levels, int samplesInOneDim = 200
+    ) const;
+
+    /// @brief Solvers statistics gathered during the last intersection search
+    [[nodiscard]]
+    const interSys::SolversTelemetry& LastTelemetry() const
+        { return telemetry; }
+
+    /// @brief Intersections traced so far, indexed by surfaces geometry
+    [[nodiscard]]
+    const interSys::IntersectionsCache& Cache() const
+        { return cache; }
+
+    void ClearCache()
+        { cache.Clear(); }
+
 private:
+    interSys::SolversTelemetry telemetry;
+    interSys::IntersectionsCache cache;
+
+    /// @brief Key under which the actually traced intersection is stored, if it is not taken from the cache
+    std::optional<interSys::IntersectionsCache::Key> cacheKey;
+
+    /// @brief Hash of the surface geometry, e.g. positions of its control points
+    [[nodiscard]]
+    size_t SurfaceHash(Entity entity) const;
+
+    interSys::IntersectionsCache::Key CacheKey(Entity e1, Entity e2, float step, const std::optional<alg::Vec3>& guidance);
+
+    /// @brief Updates the surface geometry hash in the cache. Cached intersections of a surface, which was not
+    /// tracked yet, are evicted, when the component defining its type is deleted with the surface.
+    void TrackSurface(Entity entity, size_t hash);
+
+    template <typename Comp>
+    void SubscribeToDeletion(Entity entity);
+
     [[nodiscard]]
     std::unique_ptr<interSys::Surface> GetSurface(Entity entity) const;
 
@@ -38,9 +81,9 @@ private:
     IntersectionPoint FindFirstApproximationForSelfIntersection(interSys::Surface& s) const;
 
     [[nodiscard]]
-    std::optional<IntersectionPoint> FindFirstIntersectionPoint(interSys::Surface& s1, interSys::Surface& s2, const IntersectionPoint& initSol) const;
+    std::optional<IntersectionPoint> FindFirstIntersectionPoint(interSys::Surface& s1, interSys::Surface& s2, const IntersectionPoint& initSol);
 
-    std::optional<std::tuple<float, float>> NearestPoint(interSys::Surface& s, const Position& guidance, float initU, float initV) const;
+    std::optional<std::tuple<float, float>> NearestPoint(interSys::Surface& s, const Position& guidance, float initU, float initV);
     std::tuple<float, float> NearestPointApproximation(interSys::Surface& s, const Position& guidance) const;
 
     std::tuple<float, float> SecondNearestPointApproximation(interSys::Surface& s, const Position& guidance, float u, float v) const;
@@ -53,13 +96,15 @@ private:
 
     Entity CreateCurve(interSys::Surface& s1, interSys::Surface& s2, const std::deque<IntersectionPoint>& interPoints, bool isOpen);
 
-    class DeletionHandler final : public EventHandler<CurveControlPoints> {
+    template <typename Comp>
+    class SurfaceDeletionHandler final : public EventHandler<Comp> {
     public:
-        explicit DeletionHandler(Coordinator& coordinator):
-            coordinator(coordinator) {}
+        explicit SurfaceDeletionHandler(interSys::IntersectionsCache& cache):
+            cache(cache) {}
+
+        void HandleEvent(Entity entity, const Comp& component, EventType eventType) override;
 
-        void HandleEvent(Entity entity, const CurveControlPoints &component, EventType eventType) override;
     private:
-        Coordinator& coordinator;
+        interSys::IntersectionsCache& cache;
     };
 };
@@ -13,8 +13,17 @@ public:
 
     static MillingCutter ParseCutter(const std::string& filePath);
 
-    static void CreateGCodeFile(const MillingMachinePath& paths, std::string_view path);
+    /// @brief Saves the paths, merging moves closer than the chord tolerance to the simplified path
+    static void CreateGCodeFile(const MillingMachinePath& paths, std::string_view path, float chordTolerance = defaultChordTolerance);
+
+    /// @brief Saves the simplified paths, the same as in the GCode file, as the compiled toolpath file
+    static void CreateToolpathFile(
+        const MillingMachinePath& paths, const MillingCutter& cutter, const std::string& path, float chordTolerance = defaultChordTolerance
+    );
 
 private:
     static constexpr float scale = 0.01f;
+
+    /// @brief 0.01 mm in the modeler units
+    static constexpr float defaultChordTolerance = 0.01f * scale;
 };
@@ -12,6 +12,10 @@
 #include "../components/millingMachinePath.hpp"
 #include "../components/millingCutter.hpp"
 #include "../components/millingWarningsRepo.hpp"
+#include "../millingMachineSim/heightMapCheckpoints.hpp"
+#include "../millingMachineSim/milledTiles.hpp"
+#include "../millingMachineSim/pathStepper.hpp"
+#include "../millingMachineSim/tiledMiller.hpp"
 #include "../../utilities/asyncWorker.hpp"
 
 
@@ -22,20 +26,21 @@ public:
     MillingMachineSystem();
 
     void Init(int xResolution, int zResolution);
-    void AddPaths(MillingMachinePath&& paths, const MillingCutter& cutter) const;
+    void AddPaths(MillingMachinePath&& paths, const MillingCutter& cutter);
 
-    void StartMachine()
-        { cutterRuns = true; }
+    /// @brief Starts moving the cutter on the stepper thread, which mills the material as the simulated time passes
+    void StartMachine();
 
     [[nodiscard]]
     bool MachineRuns() const
         { return cutterRuns; }
 
-    void StopMachine()
-        { cutterRuns = false; }
+    void StopMachine();
 
     void StartInstantMilling();
 
+    /// @brief Stops the instant milling worker and waits for it, does nothing if it does not run.
+    /// Material and checkpoints can be changed on the UI thread only after that.
     void StopInstantMilling();
 
     bool InstantMillingRuns() const
@@ -50,7 +55,7 @@ public:
         { return material.ZResolution(); }
 
     void SetMaterialResolution(const int xRes, const int zRes)
-        { material.SetResolution(xRes, zRes); }
+        { StopInstantMilling(); material.SetResolution(xRes, zRes); ResetCheckpoints(); ValidatePaths(); }
 
     [[nodiscard]]
     float GetMaterialXLength() const
@@ -61,38 +66,60 @@ public:
         { return material.ZLength(); }
 
     void SetMaterialSize(const float xLen, const float zLen)
-        { material.SetSize(xLen, zLen); }
+        { StopInstantMilling(); material.SetSize(xLen, zLen); ResetCheckpoints(); ValidatePaths(); }
 
     [[nodiscard]]
     float GetInitMaterialThickness() const
         { return material.InitThickness(); }
 
     void SetInitMaterialThickness(const float thickness)
-        { material.SetThickness(thickness); }
+        { StopInstantMilling(); material.SetThickness(thickness); ResetCheckpoints(); ValidatePaths(); }
 
     float GetBaseLevel() const
         { return material.BaseLevel(); }
 
     void SetBaseLevel(const float level)
-        { material.SetBaseLevel(level); }
+        { material.SetBaseLevel(level); ValidatePaths(); }
 
     void SetCutterSpeed(const float newSpeed)
-        { cutterSpeed = newSpeed; }
+        { cutterSpeed = newSpeed; stepper.SetSpeed(newSpeed); }
 
     [[nodiscard]]
     float GetCuterSpeed() const
         { return cutterSpeed; }
 
     void ResetMaterial()
-        { material.Reset(); }
+        { StopInstantMilling(); material.Reset(); ResetCheckpoints(); ValidatePaths(); }
 
     void ResetSimulation();
 
+    /// @brief Moves the cutter to the destination of the command, with the material milled by all the commands up to it.
+    /// The material is restored from the latest checkpoint before the command and the rest of the path is milled again.
+    void SeekToCommand(size_t command);
+
+    /// @brief Index of the last command, which was milled completely
+    [[nodiscard]]
+    size_t GetCurrentCommand() const
+        { return static_cast<size_t>(actCommand) - 1; }
+
+    [[nodiscard]]
+    size_t GetCommandsCnt() const;
+
+    [[nodiscard]]
+    const HeightMapCheckpoints& GetCheckpoints() const
+        { return checkpoints; }
+
+    void SetCheckpointsMemoryBudget(const size_t budget)
+        { checkpoints.SetMemoryBudget(budget); }
+
     [[nodiscard]]
     std::optional<MillingCutter> GetMillingCutter() const;
 
     void SetCutterHeight(float height) const;
 
+    /// @brief Replaces the cutter shape, keeping its height. Does nothing while the machine runs.
+    void SetCutterProfile(const CutterProfile& profile);
+
     void Update(double dt);
 
     void Render(const alg::Mat4x4& view, const alg::Mat4x4& perspective, const alg::Vec3& camPos);
@@ -104,6 +131,15 @@ public:
     void ClearWarnings()
         { millingWarnings.Clear(); }
 
+    /// @brief Checks the path against the actual material without milling it. Done whenever the path, the cutter
+    /// or the material settings change, so the warnings never describe an outdated material. Skipped while the material is being milled.
+    void ValidatePaths();
+
+    /// @brief Warnings, which milling the path from the validated material state could give
+    [[nodiscard]]
+    const auto& GetValidationWarnings() const
+        { return validationWarnings; }
+
 private:
     MillingMaterial material;
 
@@ -114,14 +150,33 @@ private:
     int actCommand = 1;
 
     AsyncWorker instantWorker;
+    TiledMiller tiledMiller;
+    MilledTiles milledTiles;
 
     MillingWarningsRepo millingWarnings;
+    MillingWarningsRepo validationWarnings;
+
+    HeightMapCheckpoints checkpoints;
+    double simulatedTime = 0.0;
+
+    /// @brief Declared last, so its thread is stopped before the objects it mills are destroyed
+    PathStepper stepper;
+
 
     void InstantMillingThreadFunc(std::stop_token stoken);
 
-    void MillSection(const Position& oldCutterPos, const Position& newCutterPos);
+    /// @brief Mills whole commands from the actual one up to the end command with the tiled miller,
+    /// taking checkpoints on the way
+    void MillCommands(size_t endCommand, const std::stop_token& stoken, MilledTiles* tiles);
+
+    /// @brief The first command after the actual one, before which a checkpoint is due, or the end command if there is none
+    [[nodiscard]]
+    size_t NextCheckpointCommand(const MillingMachinePath& path, size_t endCommand) const;
+
+    void TakeCheckpointIfDue();
+
+    void ResetCheckpoints();
 
-    float UpdateHeightMap(int x, int z, float cutterY, float cutterHeight, bool pathToDown);
 
     void RenderPaths(const alg::Mat4x4& cameraMtx) const;
     void RenderCutter(const alg::Mat4x4& cameraMtx) const;
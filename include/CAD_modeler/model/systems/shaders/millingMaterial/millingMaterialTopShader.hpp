@@ -25,4 +25,11 @@ public:
 
     void SetCameraPosition(const alg::Vec3& pos) const
         { SetVec3("cameraPos", pos); }
+
+    /// @brief Sets the square of height map pixels covered by the drawn patch
+    void SetPatch(const int minX, const int minZ, const int pixels) const {
+        SetFloat("patchMinX", static_cast<float>(minX));
+        SetFloat("patchMinZ", static_cast<float>(minZ));
+        SetFloat("patchPixels", static_cast<float>(pixels));
+    }
 };
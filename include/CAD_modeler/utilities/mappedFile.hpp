@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+
+/// @brief Read-only view of the whole file mapped into the memory
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filePath);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]]
+    const std::byte* Data() const
+        { return data; }
+
+    [[nodiscard]]
+    size_t Size() const
+        { return size; }
+
+private:
+    const std::byte* data = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
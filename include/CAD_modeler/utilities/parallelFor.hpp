@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <thread>
+#include <vector>
+
+
+/// @brief Number of threads, on which ParallelFor runs the given number of tasks
+inline unsigned int ParallelWorkersCnt(const size_t tasksCnt, const unsigned int threadsCnt)
+{
+    return static_cast<unsigned int>(std::min<size_t>(std::max(threadsCnt, 1u), tasksCnt));
+}
+
+
+/// @brief Runs the task for every index from 0 to tasksCnt - 1 on up to threadsCnt threads, the calling thread is one of them.
+/// Every thread takes the next index, when it is done with the previous one, so the tasks of different costs are balanced.
+/// The task can also take the index of its worker, from 0 to ParallelWorkersCnt() - 1, to use the buffers of its thread.
+template <typename Task>
+void ParallelFor(const size_t tasksCnt, const unsigned int threadsCnt, const Task& task)
+{
+    std::atomic_size_t next = 0;
+
+    auto worker = [&] (const unsigned int workerIdx) {
+        size_t i;
+        while ((i = next.fetch_add(1, std::memory_order_relaxed)) < tasksCnt) {
+            if constexpr (std::invocable<const Task&, size_t, unsigned int>)
+                task(i, workerIdx);
+            else
+                task(i);
+        }
+    };
+
+    const unsigned int workersCnt = ParallelWorkersCnt(tasksCnt, threadsCnt);
+
+    std::vector<std::jthread> threads;
+    threads.reserve(workersCnt);
+
+    for (unsigned int i = 1; i < workersCnt; ++i)
+        threads.emplace_back(worker, i);
+
+    worker(0);
+}
@@ -12,5 +12,8 @@ public:
 private:
     std::string filePath;
 
+    int targetXResolution = 1000;
+    int targetZResolution = 1000;
+
     MillingPathsDesigner& model;
 };
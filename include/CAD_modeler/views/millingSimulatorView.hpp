@@ -19,6 +19,9 @@ private:
     void RenderFileSelection();
     void RenderMaterialOptions() const;
     void RenderSimulationOptions() const;
+    void RenderTimeline() const;
     void RenderCutterInformation() const;
     void RenderWarnings() const;
+
+    static void RenderWarningsList(const MillingWarningsRepo& warningsRepo);
 };
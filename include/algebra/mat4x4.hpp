@@ -28,6 +28,11 @@ namespace alg
         [[nodiscard]]
         std::optional<Mat4x4> Inverse() const;
 
+        /// @brief Solves linear system with this matrix and vector of constant terms
+        /// using LU decomposition with partial pivoting
+        [[nodiscard]]
+        std::optional<Vec4> Solve(const Vec4& constants) const;
+
         void TransposeSelf();
 
         float* Data()
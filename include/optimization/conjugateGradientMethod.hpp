@@ -5,9 +5,19 @@
 
 #include "lineSearch.hpp"
 #include "stopCondition.hpp"
+#include "solverStats.hpp"
 
 
 namespace opt {
+    std::optional<std::vector<float>> ConjugateGradientMethod(
+        FunctionToOptimize& fun,
+        LineSearchMethod& lineSearch,
+        const std::vector<float> &initSol,
+        unsigned int maxIt,
+        StopCondition& stopCondition,
+        SolverStats& stats
+    );
+
     std::optional<std::vector<float>> ConjugateGradientMethod(
         FunctionToOptimize& fun,
         LineSearchMethod& lineSearch,
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <limits>
+
+
+namespace opt
+{
+    enum class TerminationReason {
+        StopConditionMet,
+        MaxIterationsExceeded
+    };
+
+
+    class SolverStats {
+    public:
+        int iterations = 0;
+        int functionEvaluations = 0;
+        int gradientEvaluations = 0;
+
+        /// @brief Squared length of the gradient in the last solution
+        float finalResidual = std::numeric_limits<float>::infinity();
+
+        TerminationReason terminationReason = TerminationReason::MaxIterationsExceeded;
+    };
+}
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "functionToFindRoot.hpp"
+#include "solverStats.hpp"
 
 #include <optional>
 
 
 namespace root
 {
-    std::optional<alg::Vec4> NewtonMethod(FunctionToFindRoot& fun, const alg::Vec4& initSol, float eps, int maxIter = 100);
-}
\ No newline at end of file
+    /// @brief Damped Newton method. If a step increases the residual, it is halved
+    /// at most maxBacktracks times.
+    std::optional<alg::Vec4> NewtonMethod(FunctionToFindRoot& fun, const alg::Vec4& initSol, float eps, SolverStats& stats, int maxIter = 100, int maxBacktracks = 4);
+
+    std::optional<alg::Vec4> NewtonMethod(FunctionToFindRoot& fun, const alg::Vec4& initSol, float eps, int maxIter = 100, int maxBacktracks = 4);
+}
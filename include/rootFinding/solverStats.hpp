@@ -0,0 +1,28 @@
+#pragma once
+
+#include <limits>
+
+
+namespace root
+{
+    enum class TerminationReason {
+        Converged,
+        MaxIterationsExceeded,
+        SingularJacobian,
+        NonFiniteResidual
+    };
+
+
+    class SolverStats {
+    public:
+        int iterations = 0;
+        int functionEvaluations = 0;
+        int jacobianEvaluations = 0;
+        int backtrackingSteps = 0;
+
+        /// @brief Squared length of the function value in the last evaluated point
+        float finalResidual = std::numeric_limits<float>::infinity();
+
+        TerminationReason terminationReason = TerminationReason::MaxIterationsExceeded;
+    };
+}
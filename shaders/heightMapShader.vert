@@ -1,5 +1,6 @@
 #version 410 core
 
+// Position in the patch: x and z are in [0, 1], y is 1 for the skirt vertices
 layout (location = 0) in vec3 aPos;
 
 
@@ -13,17 +14,23 @@ uniform float heightMapZLen;
 
 uniform vec3 mainHeightMapCorner;
 
+// Square of the height map pixels covered by the patch
+uniform float patchMinX;
+uniform float patchMinZ;
+uniform float patchPixels;
+
 out vec3 worldPos;
 out vec3 normal;
 
 
-vec3 PointPosition(vec3 pos)
+vec3 PixelPosition(vec2 pixel, ivec2 texSize)
 {
-    vec2 texCoord;
-    texCoord.x = (pos.x - mainHeightMapCorner.x) / heightMapXLen;
-    texCoord.y = (pos.z - mainHeightMapCorner.z) / heightMapZLen;
+    pixel = clamp(pixel, vec2(0.0), vec2(texSize - 1));
 
-    pos.y += texture(heightMap, texCoord).r;
+    vec3 pos;
+    pos.x = mainHeightMapCorner.x + (pixel.x + 0.5) * heightMapXLen / float(texSize.x);
+    pos.z = mainHeightMapCorner.z + (pixel.y + 0.5) * heightMapZLen / float(texSize.y);
+    pos.y = mainHeightMapCorner.y + texelFetch(heightMap, ivec2(pixel), 0).r;
 
     return pos;
 }
@@ -32,23 +39,29 @@ vec3 PointPosition(vec3 pos)
 void main()
 {
     ivec2 texSize = textureSize(heightMap, 0);
-    float pixelXLen = heightMapXLen / float(texSize.x);
-    float pixelZLen = heightMapZLen / float(texSize.y);
 
-    worldPos = PointPosition(aPos);
+    vec2 pixel = floor(vec2(patchMinX, patchMinZ) + aPos.xz * patchPixels);
+
+    worldPos = PixelPosition(pixel, texSize);
 
-    vec3 xShifted = aPos;
-    xShifted.x += pixelXLen;
-    xShifted = PointPosition(xShifted);
+    vec3 xShifted = PixelPosition(pixel + vec2(1.0, 0.0), texSize);
+    vec3 zShifted = PixelPosition(pixel + vec2(0.0, 1.0), texSize);
 
-    vec3 zShifted = aPos;
-    zShifted.z += pixelZLen;
-    zShifted = PointPosition(zShifted);
+    // At the last pixel the shifted points are clamped to the same position, so previous pixels are used instead
+    if (pixel.x >= float(texSize.x - 1))
+        xShifted = 2.0 * worldPos - PixelPosition(pixel - vec2(1.0, 0.0), texSize);
+
+    if (pixel.y >= float(texSize.y - 1))
+        zShifted = 2.0 * worldPos - PixelPosition(pixel - vec2(0.0, 1.0), texSize);
 
     vec3 tangent = normalize(xShifted - worldPos);
     vec3 bitangent = normalize(zShifted - worldPos);
 
     normal = cross(bitangent, tangent);
 
+    // Skirt hangs down to the material base, covering cracks between patches of different detail
+    if (aPos.y > 0.5)
+        worldPos.y = mainHeightMapCorner.y;
+
     gl_Position = MVP * vec4(worldPos, 1.0);
 }
@@ -1,6 +1,7 @@
 #include <algebra/mat4x4.hpp>
 
 #include <cassert>
+#include <cmath>
 
 
 alg::Mat4x4::Mat4x4(
@@ -144,6 +145,59 @@ std::optional<alg::Mat4x4> alg::Mat4x4::Inverse() const
 }
 
 
+std::optional<alg::Vec4> alg::Mat4x4::Solve(const Vec4 &constants) const
+{
+    Mat4x4 lu = *this;
+    Vec4 result = constants;
+
+    // Decomposition, forward substitution is done at the same time
+    for (int k = 0; k < Rows; ++k) {
+        int pivotRow = k;
+        float pivotAbs = std::abs(lu(k, k));
+
+        for (int row = k + 1; row < Rows; ++row) {
+            if (const float val = std::abs(lu(row, k)); val > pivotAbs) {
+                pivotAbs = val;
+                pivotRow = row;
+            }
+        }
+
+        // Checking if system has exactly one solution
+        if (pivotAbs == 0.f)
+            return std::nullopt;
+
+        if (pivotRow != k) {
+            for (int col = 0; col < Cols; ++col)
+                std::swap(lu(k, col), lu(pivotRow, col));
+
+            std::swap(result[k], result[pivotRow]);
+        }
+
+        for (int row = k + 1; row < Rows; ++row) {
+            const float factor = lu(row, k) / lu(k, k);
+            lu(row, k) = factor;
+
+            for (int col = k + 1; col < Cols; ++col)
+                lu(row, col) -= factor * lu(k, col);
+
+            result[row] -= factor * result[k];
+        }
+    }
+
+    // Backward substitution
+    for (int row = Rows - 1; row >= 0; --row) {
+        float sum = result[row];
+
+        for (int col = row + 1; col < Cols; ++col)
+            sum -= lu(row, col) * result[col];
+
+        result[row] = sum / lu(row, row);
+    }
+
+    return result;
+}
+
+
 void alg::Mat4x4::TransposeSelf()
 {
     std::swap(data[1], data[4]);
@@ -0,0 +1,144 @@
+#include <CAD_modeler/model/components/cutterProfile.hpp>
+
+#include <numbers>
+#include <stdexcept>
+
+
+CutterProfile CutterProfile::Round(const float radius)
+{
+    if (radius <= 0.f)
+        throw std::invalid_argument("Cutter radius has to be positive");
+
+    return { Type::Round, radius, { Arc(radius, 0.f, radius, radius) } };
+}
+
+
+CutterProfile CutterProfile::Flat(const float radius)
+{
+    if (radius <= 0.f)
+        throw std::invalid_argument("Cutter radius has to be positive");
+
+    return { Type::Flat, radius, { Line(radius, 0.f, 0.f, 0.f) } };
+}
+
+
+CutterProfile CutterProfile::BullNose(const float radius, const float cornerRadius)
+{
+    if (radius <= 0.f || cornerRadius <= 0.f || cornerRadius > radius)
+        throw std::invalid_argument("Corner radius has to be positive and not bigger than the cutter radius");
+
+    const float flatRadius = radius - cornerRadius;
+
+    std::vector<Segment> segments;
+    if (flatRadius > 0.f)
+        segments.push_back(Line(flatRadius, 0.f, 0.f, 0.f));
+
+    segments.push_back(Arc(radius, flatRadius, cornerRadius, cornerRadius));
+
+    CutterProfile profile(Type::BullNose, radius, std::move(segments));
+    profile.secondaryRadius = cornerRadius;
+
+    return profile;
+}
+
+
+CutterProfile CutterProfile::Tapered(const float radius, const float tipRadius, const float halfAngle)
+{
+    if (radius <= 0.f || tipRadius < 0.f || tipRadius >= radius)
+        throw std::invalid_argument("Tip radius has to be smaller than the cutter radius");
+
+    if (halfAngle <= 0.f || halfAngle >= std::numbers::pi_v<float> / 2.f)
+        throw std::invalid_argument("Taper angle has to be between 0 and 90 degrees");
+
+    std::vector<Segment> segments;
+    if (tipRadius > 0.f)
+        segments.push_back(Line(tipRadius, 0.f, 0.f, 0.f));
+
+    segments.push_back(Line(radius, tipRadius, 0.f, 1.f / std::tan(halfAngle)));
+
+    CutterProfile profile(Type::Tapered, radius, std::move(segments));
+    profile.secondaryRadius = tipRadius;
+    profile.halfAngle = halfAngle;
+
+    return profile;
+}
+
+
+CutterProfile CutterProfile::Table(const std::vector<Point> &points)
+{
+    if (points.size() < 2 || points.front() != Point{ .radius = 0.f, .height = 0.f })
+        throw std::invalid_argument("Profile has to start in the cutter tip and have at least two points");
+
+    std::vector<Segment> segments;
+    float prevSlope = 0.f;
+
+    for (size_t i = 1; i < points.size(); ++i) {
+        const auto& prev = points[i - 1];
+        const auto& act = points[i];
+
+        if (act.radius <= prev.radius)
+            throw std::invalid_argument("Profile points radii have to be increasing");
+
+        const float slope = (act.height - prev.height) / (act.radius - prev.radius);
+        if (slope < prevSlope)
+            throw std::invalid_argument("Profile has to be non-decreasing and convex");
+
+        segments.push_back(Line(act.radius, prev.radius, prev.height, slope));
+        prevSlope = slope;
+    }
+
+    CutterProfile profile(Type::Table, points.back().radius, std::move(segments));
+    profile.points = points;
+
+    return profile;
+}
+
+
+bool CutterProfile::operator==(const CutterProfile &other) const
+{
+    return type == other.type &&
+           radius == other.radius &&
+           secondaryRadius == other.secondaryRadius &&
+           halfAngle == other.halfAngle &&
+           points == other.points;
+}
+
+
+CutterProfile::CutterProfile(const Type type, const float radius, std::vector<Segment> segments):
+    type(type), radius(radius), radiusSq(radius * radius), segments(std::move(segments))
+{
+    float shortestSegment = radius;
+    float segmentStart = 0.f;
+
+    for (const auto& segment : this->segments) {
+        shortestSegment = std::min(shortestSegment, segment.end - segmentStart);
+        segmentStart = segment.end;
+    }
+
+    const auto cellsCnt = std::clamp(static_cast<size_t>(std::ceil(radius / shortestSegment)), size_t{ 1 }, maxCells);
+    cellsPerUnit = static_cast<float>(cellsCnt) / radius;
+    cellsSegments.resize(cellsCnt);
+
+    // Each cell starts the search at the segment containing its beginning
+    unsigned int segmentIdx = 0;
+    for (size_t cell = 0; cell < cellsCnt; ++cell) {
+        const float cellStart = static_cast<float>(cell) / cellsPerUnit;
+
+        while (cellStart > this->segments[segmentIdx].end && segmentIdx + 1 < this->segments.size())
+            ++segmentIdx;
+
+        cellsSegments[cell] = segmentIdx;
+    }
+}
+
+
+CutterProfile::Segment CutterProfile::Line(const float end, const float startRadius, const float startHeight, const float slope)
+{
+    return { .end = end, .a = startHeight - slope * startRadius, .b = slope, .c = 0.f, .e = 0.f, .f = 0.f };
+}
+
+
+CutterProfile::Segment CutterProfile::Arc(const float end, const float centerR, const float centerH, const float arcRadius)
+{
+    return { .end = end, .a = centerH, .b = 0.f, .c = arcRadius * arcRadius, .e = 1.f, .f = centerR };
+}
@@ -1,27 +1,47 @@
 #include <CAD_modeler/model/components/millingCutter.hpp>
 
+#include <stdexcept>
 
-float MillingCutter::YCoordinate(const Position &pos, const float x, const float z) const
+
+namespace
 {
-    const float diffX = x - pos.GetX();
-    const float diffZ = z - pos.GetZ();
+    CutterProfile ProfileOf(const float radius, const MillingCutter::Type type)
+    {
+        switch (type) {
+            case MillingCutter::Type::Flat:
+                return CutterProfile::Flat(radius);
+
+            case MillingCutter::Type::Round:
+                return CutterProfile::Round(radius);
+
+            default:
+                throw std::invalid_argument("Cutter type requires the profile parameters");
+        }
+    }
+}
 
-    const float lenSq = diffX*diffX + diffZ*diffZ;
 
-    const float radiusSq = radius * radius;
-    if (lenSq > radiusSq)
-        return std::numeric_limits<float>::infinity();
+MillingCutter::MillingCutter(const float radius, const Type type, const float height):
+    MillingCutter(ProfileOf(radius, type), height)
+{
+}
 
-    switch (type) {
-        case Type::Flat:
-            return pos.GetY();
 
-        case Type::Round:
-            return radius - std::sqrt(radiusSq - lenSq) + pos.GetY();
+MillingCutter::MillingCutter(const CutterProfile &profile, const float height):
+    radius(profile.Radius()),
+    height(height),
+    type(profile.GetType()),
+    profile(std::make_shared<const CutterProfile>(profile))
+{
+}
 
-        default:
-            throw std::runtime_error("Unknown cutter type");
-    }
+
+float MillingCutter::YCoordinate(const Position &pos, const float x, const float z) const
+{
+    const float diffX = x - pos.GetX();
+    const float diffZ = z - pos.GetZ();
+
+    return pos.GetY() + profile->HeightAt(diffX*diffX + diffZ*diffZ);
 }
 
 
@@ -30,20 +50,6 @@ float MillingCutter::CalcMinYCoord(const float cutterX, const float cutterZ, con
     const float diffX = cutterX - pointPos.GetX();
     const float diffZ = cutterZ - pointPos.GetZ();
 
-    const float lenSq = diffX*diffX + diffZ*diffZ;
-    const float radiusSq = radius * radius;
-
-    if (lenSq > radiusSq)
-        return -std::numeric_limits<float>::infinity();
-
-    switch (type) {
-        case Type::Flat:
-            return pointPos.GetY();
-
-        case Type::Round:
-            return pointPos.GetY() - radius + std::sqrt(radiusSq - lenSq);
-
-        default:
-            throw std::runtime_error("Unknown cutter type");
-    }
+    // Point outside of the cutter does not limit its position
+    return pointPos.GetY() - profile->HeightAt(diffX*diffX + diffZ*diffZ);
 }
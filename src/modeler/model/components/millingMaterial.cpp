@@ -6,10 +6,13 @@
 
 MillingMaterial::MillingMaterial(const int xResolution, const int zResolution, const float xLen, const float zLen, const float thickness):
     heightMap(xResolution, zResolution, nullptr, Texture2D::Red32BitFloat, Texture2D::Red),
-    mainHeightMapCorner(-xLen/2.f, 0.f, -zLen/2.f), xLen(xLen), zLen(zLen), initThickness(thickness)
+    heights(xResolution, zResolution, xLen, zLen, thickness), initThickness(thickness), lodPyramid(heights.Pyramid())
 {
-    textureData.resize(xResolution * zResolution);
-    std::ranges::fill(textureData, initThickness);
+    // Patch is the same for every level of detail and every resolution, so it is generated only once
+    topPatch.Update(
+        GenerateTopPatchVertices(),
+        GenerateTopPatchIndices()
+    );
 
     UpdateMeshes();
 }
@@ -17,9 +20,9 @@ MillingMaterial::MillingMaterial(const int xResolution, const int zResolution, c
 
 void MillingMaterial::SetResolution(const int xRes, const int zRes)
 {
-    textureData.resize(xRes * zRes);
-    std::ranges::fill(textureData, initThickness);
-    heightMap.ChangeSize(xRes, zRes, textureData.data(), Texture2D::Red);
+    heights.SetResolution(xRes, zRes, initThickness);
+    heightMap.ChangeSize(xRes, zRes, nullptr, Texture2D::Red);
+    SyncVisualization();
 
     UpdateMeshes();
 }
@@ -27,11 +30,7 @@ void MillingMaterial::SetResolution(const int xRes, const int zRes)
 
 void MillingMaterial::SetSize(const float xLen, const float zLen)
 {
-    this->xLen = xLen;
-    this->zLen = zLen;
-
-    mainHeightMapCorner.X() = -xLen / 2.f;
-    mainHeightMapCorner.Z() = -zLen / 2.f;
+    heights.SetSize(xLen, zLen);
 
     UpdateMeshes();
 }
@@ -46,7 +45,7 @@ void MillingMaterial::SetThickness(const float thickness)
 
 void MillingMaterial::SetBaseLevel(const float level)
 {
-    mainHeightMapCorner.Y() = level;
+    heights.SetBaseLevel(level);
 
     UpdateMeshes();
 }
@@ -54,40 +53,48 @@ void MillingMaterial::SetBaseLevel(const float level)
 
 void MillingMaterial::Reset()
 {
-    std::ranges::fill(textureData, initThickness);
-
-    heightMap.Update(textureData.data(), Texture2D::Red);
+    heights.Fill(initThickness);
+    SyncVisualization();
 }
 
 
-float MillingMaterial::GlobalX(const int x) const
+void MillingMaterial::SyncVisualization()
 {
-    const float pixelXLen = PixelXLen();
-    return mainHeightMapCorner.X() + pixelXLen/2.f + pixelXLen * x;
-}
+    const PixelRect& region = heights.ChangedRegion();
+    if (region.Empty())
+        return;
 
+    SyncVisualization(region);
+    heights.ClearChangedRegion();
 
-float MillingMaterial::GlobalZ(const int z) const
-{
-    const float pixelZLen = PixelZLen();
-    return mainHeightMapCorner.Z() + pixelZLen/2.f + pixelZLen * z;
+    lodPyramid = heights.Pyramid();
 }
 
 
-void MillingMaterial::Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos) const
+void MillingMaterial::SyncVisualization(const PixelRect &region) const
 {
-    // Render material top
-    topShader.Use();
-    heightMap.Use();
-    topShader.SetCameraPosition(camPos);
+    constexpr int tileSize = MaterialHeightMap::tileSize;
 
-    topShader.SetHeightMapZLen(zLen);
-    topShader.SetHeightMapXLen(xLen);
-    topShader.SetMainHeightmapCorner(mainHeightMapCorner);
-    topShader.SetMVP(cameraMtx);
+    const PixelRect clipped = region.Intersection(heights.Bounds());
+    if (clipped.Empty())
+        return;
+
+    // Heights are stored in separate tiles, so each of them is uploaded on its own
+    for (int tileZ = clipped.minZ / tileSize; tileZ <= (clipped.maxZ - 1) / tileSize; ++tileZ) {
+        for (int tileX = clipped.minX / tileSize; tileX <= (clipped.maxX - 1) / tileSize; ++tileX) {
+            const PixelRect part = clipped.Intersection(heights.TileRect(tileX, tileZ));
+            const float* data = heights.TileData(tileX, tileZ) +
+                (part.minZ - tileZ*tileSize) * tileSize + (part.minX - tileX*tileSize);
+
+            heightMap.UpdateRegion(data, tileSize, part.minX, part.minZ, part.Width(), part.Height(), Texture2D::Red);
+        }
+    }
+}
 
-    top.Use();
-    glDrawElements(GL_TRIANGLES, top.GetElementsCnt(), GL_UNSIGNED_INT, nullptr);
+
+void MillingMaterial::Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos)
+{
+    RenderTop(cameraMtx, camPos);
 
     // Render material bottom
     bottomShader.Use();
@@ -103,9 +110,9 @@ void MillingMaterial::Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camP
     sideShader.Use();
     heightMap.Use();
     sideShader.SetCameraPosition(camPos);
-    sideShader.SetHeightMapZLen(zLen);
-    sideShader.SetHeightMapXLen(xLen);
-    sideShader.SetMainHeightmapCorner(mainHeightMapCorner);
+    sideShader.SetHeightMapZLen(ZLength());
+    sideShader.SetHeightMapXLen(XLength());
+    sideShader.SetMainHeightmapCorner(heights.Corner());
     sideShader.SetVP(cameraMtx);
 
     // Positive X side
@@ -134,13 +141,28 @@ void MillingMaterial::Render(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camP
 }
 
 
-void MillingMaterial::UpdateMeshes()
+void MillingMaterial::RenderTop(const alg::Mat4x4 &cameraMtx, const alg::Vec3 &camPos)
 {
-    top.Update(
-        GenerateMaterialTopVertices(),
-        GenerateMaterialTopIndices()
-    );
+    topShader.Use();
+    heightMap.Use();
+    topShader.SetCameraPosition(camPos);
+
+    topShader.SetHeightMapZLen(ZLength());
+    topShader.SetHeightMapXLen(XLength());
+    topShader.SetMainHeightmapCorner(heights.Corner());
+    topShader.SetMVP(cameraMtx);
+
+    topPatch.Use();
+
+    for (const auto& patch : lod.SelectPatches(heights, lodPyramid, camPos)) {
+        topShader.SetPatch(patch.minX, patch.minZ, patch.Width());
+        glDrawElements(GL_TRIANGLES, topPatch.GetElementsCnt(), GL_UNSIGNED_INT, nullptr);
+    }
+}
+
 
+void MillingMaterial::UpdateMeshes()
+{
     bottom.Update(
         GenerateMaterialBottomVertices(),
         GenerateMaterialBottomIndices()
@@ -158,25 +180,23 @@ void MillingMaterial::UpdateMeshes()
 }
 
 
-std::vector<float> MillingMaterial::GenerateMaterialTopVertices() const
+std::vector<float> MillingMaterial::GenerateTopPatchVertices()
 {
-    std::vector<float> result;
-    const int pointsInX = XResolution();
-    const int pointsInZ = ZResolution();
-
-    result.reserve(pointsInX * pointsInZ * alg::Vec3::dim);
-
-    const float pixelXLen = PixelXLen();
-    const float pixelZLen = PixelZLen();
+    constexpr int pointsInRow = HeightMapLod::patchCells + 1;
+    constexpr float cellLen = 1.f / HeightMapLod::patchCells;
 
-    for (int row = 0; row < pointsInZ; row++) {
-        for (int col = 0; col < pointsInX; col++) {
-            const float x = pixelXLen/2.f + col * pixelXLen;
-            const float z = pixelZLen/2.f + row * pixelZLen;
-
-            result.push_back(mainHeightMapCorner.X() + x);
-            result.push_back(mainHeightMapCorner.Y());
-            result.push_back(mainHeightMapCorner.Z() + z);
+    std::vector<float> result;
+    result.reserve(2 * pointsInRow * pointsInRow * alg::Vec3::dim);
+
+    // Vertices of the grid in the patch coordinates, followed by the same vertices of the skirt.
+    // The y coordinate is 1 for skirt vertices, which are lowered to the base level to cover cracks between different levels of detail.
+    for (const float skirt : { 0.f, 1.f }) {
+        for (int row = 0; row < pointsInRow; row++) {
+            for (int col = 0; col < pointsInRow; col++) {
+                result.push_back(static_cast<float>(col) * cellLen);
+                result.push_back(skirt);
+                result.push_back(static_cast<float>(row) * cellLen);
+            }
         }
     }
 
@@ -184,39 +204,58 @@ std::vector<float> MillingMaterial::GenerateMaterialTopVertices() const
 }
 
 
-std::vector<uint32_t> MillingMaterial::GenerateMaterialTopIndices() const
+std::vector<uint32_t> MillingMaterial::GenerateTopPatchIndices()
 {
-    std::vector<uint32_t> result;
+    constexpr uint32_t pointsInRow = HeightMapLod::patchCells + 1;
+    constexpr uint32_t skirtOffset = pointsInRow * pointsInRow;
 
-    const int pointsInX = XResolution();
-    const int pointsInZ = ZResolution();
-
-    result.reserve((pointsInZ - 1) * (pointsInX - 1) * 6);
+    std::vector<uint32_t> result;
+    result.reserve((pointsInRow - 1) * (pointsInRow - 1) * 6 + 4 * (pointsInRow - 1) * 6);
 
-    for (int row = 0; row < pointsInZ - 1; row ++) {
-        for (int col = 0; col < pointsInX - 1; col++) {
+    for (uint32_t row = 0; row < pointsInRow - 1; row ++) {
+        for (uint32_t col = 0; col < pointsInRow - 1; col++) {
 
             // First triangle
-            result.push_back(col + pointsInX * row);
-            result.push_back(col + pointsInX * row + 1);
-            result.push_back(col + pointsInX * row + pointsInX + 1);
+            result.push_back(col + pointsInRow * row);
+            result.push_back(col + pointsInRow * row + 1);
+            result.push_back(col + pointsInRow * row + pointsInRow + 1);
 
             // Second triangle
-            result.push_back(col + pointsInX * row);
-            result.push_back(col + pointsInX * row + pointsInX + 1);
-            result.push_back(col + pointsInX * row + pointsInX);
+            result.push_back(col + pointsInRow * row);
+            result.push_back(col + pointsInRow * row + pointsInRow + 1);
+            result.push_back(col + pointsInRow * row + pointsInRow);
         }
     }
 
+    // Skirt quads along the patch edges
+    auto addSkirtQuad = [&result] (const uint32_t first, const uint32_t second) {
+        result.push_back(first);
+        result.push_back(second);
+        result.push_back(second + skirtOffset);
+
+        result.push_back(first);
+        result.push_back(second + skirtOffset);
+        result.push_back(first + skirtOffset);
+    };
+
+    constexpr uint32_t last = pointsInRow - 1;
+
+    for (uint32_t i = 0; i < last; i++) {
+        addSkirtQuad(i, i + 1);
+        addSkirtQuad(last * pointsInRow + i, last * pointsInRow + i + 1);
+        addSkirtQuad(i * pointsInRow, (i + 1) * pointsInRow);
+        addSkirtQuad(i * pointsInRow + last, (i + 1) * pointsInRow + last);
+    }
+
     return result;
 }
 
 
 std::vector<float> MillingMaterial::GenerateMaterialBottomVertices() const
 {
-    const float valX = (xLen - PixelXLen()) / 2.f;
+    const float valX = (XLength() - PixelXLen()) / 2.f;
     const float valY = BaseLevel();
-    const float valZ = (zLen - PixelZLen()) / 2.f;
+    const float valZ = (ZLength() - PixelZLen()) / 2.f;
 
     return std::vector{
         // First vertex
@@ -1,17 +1,64 @@
 #include <CAD_modeler/model/components/millingWarningsRepo.hpp>
 
+#include <algorithm>
 
-void MillingWarningsRepo::AddWarning(int commandId, WarningType warningType)
+
+void MillingWarningsRepo::Reset(const MillingMachinePath &path)
 {
-    const auto idAndWarnings = warnings.find(commandId);
+    commandsIds.clear();
+    commandsIds.reserve(path.Size());
 
-    if (idAndWarnings == warnings.end()) {
-        warnings.insert(std::pair(commandId, warningType));
-        return;
-    }
+    for (const auto& command : path)
+        commandsIds.push_back(command.id);
+
+    flags = std::make_unique<std::atomic_uint8_t[]>(commandsIds.size());
+
+    view.clear();
+    viewOutdated = false;
+}
+
+
+void MillingWarningsRepo::AddWarning(const size_t commandIdx, const WarningType warningType)
+{
+    const auto oldFlags = flags[commandIdx].fetch_or(warningType, std::memory_order_relaxed);
+
+    if ((oldFlags & warningType) == 0)
+        viewOutdated.store(true, std::memory_order_release);
+}
+
+
+void MillingWarningsRepo::Clear()
+{
+    for (size_t i = 0; i < commandsIds.size(); ++i)
+        flags[i].store(0, std::memory_order_relaxed);
 
-    if (idAndWarnings->second & warningType)
+    view.clear();
+    viewOutdated = false;
+}
+
+
+void MillingWarningsRepo::ClearFrom(const size_t commandIdx)
+{
+    for (size_t i = commandIdx; i < commandsIds.size(); ++i)
+        flags[i].store(0, std::memory_order_relaxed);
+
+    viewOutdated = true;
+}
+
+
+void MillingWarningsRepo::UpdateView()
+{
+    if (!viewOutdated.exchange(false, std::memory_order_acquire))
         return;
 
-    idAndWarnings->second |= warningType;
+    view.clear();
+
+    for (size_t i = 0; i < commandsIds.size(); ++i) {
+        const auto warnings = flags[i].load(std::memory_order_relaxed);
+
+        if (warnings != 0)
+            view.push_back({ .commandId = commandsIds[i], .warnings = warnings });
+    }
+
+    std::ranges::stable_sort(view, {}, &CommandWarnings::commandId);
 }
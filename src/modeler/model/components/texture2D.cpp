@@ -24,6 +24,16 @@ void Texture2D::Update(const float *data, const InputDataFormat inputFormat) con
 }
 
 
+void Texture2D::UpdateRegion(const float *data, const int dataRowLength, const int x, const int y,
+                             const int regionWidth, const int regionHeight, const InputDataFormat inputFormat) const
+{
+    Use();
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, dataRowLength);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, regionWidth, regionHeight, inputFormat, GL_FLOAT, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+
 void Texture2D::ChangeSize(const int texWidth, const int texHeight, const float *data, const InputDataFormat inputFormat)
 {
     width = texWidth;
@@ -1,6 +1,7 @@
 #include "CAD_modeler/model/millingMachineSim.hpp"
 
 #include <CAD_modeler/model/systems/millingMachinePathsSystem.hpp>
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
 
 
 MillingMachineSim::MillingMachineSim(const int viewportWidth, const int viewportHeight):
@@ -26,6 +27,12 @@ void MillingMachineSim::Update(const double dt) const
 
 void MillingMachineSim::AddMillingPath(const std::string &filePath) const
 {
+    if (ToolpathFile::HasToolpathExtension(filePath)) {
+        auto [path, cutter] = ToolpathFile::Load(filePath);
+        millingMachineSystem->AddPaths(std::move(path), cutter);
+        return;
+    }
+
     auto paths = MillingMachinePathsSystem::ParseGCode(filePath);
     const auto cutter = MillingMachinePathsSystem::ParseCutter(filePath);
 
@@ -0,0 +1,154 @@
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+CutterStamp::CutterStamp(const MillingCutter &cutter, const float pixelXLen, const float pixelZLen):
+    cutter(cutter),
+    pixelXLen(pixelXLen),
+    pixelZLen(pixelZLen),
+    radiusInPixelsX(static_cast<int>(std::ceil(cutter.radius / pixelXLen))),
+    radiusInPixelsZ(static_cast<int>(std::ceil(cutter.radius / pixelZLen))),
+    rowsHalfWidths(2*radiusInPixelsZ + 1, -1)
+{
+    // The cutter tip lies at most one pixel away from the middle pixel of the stamp,
+    // so the pixel is skipped only if it is outside the cutter for every such shift.
+    // Small relative margin protects from rounding errors in the exact test done while milling.
+    constexpr float margin = 1.001f;
+    const float radiusSq = cutter.radius * cutter.radius * margin;
+
+    for (int dz = -radiusInPixelsZ; dz <= radiusInPixelsZ; ++dz) {
+        const float minDiffZ = static_cast<float>(std::max(std::abs(dz) - 1, 0)) * pixelZLen;
+
+        for (int dx = radiusInPixelsX; dx >= 0; --dx) {
+            const float minDiffX = static_cast<float>(std::max(dx - 1, 0)) * pixelXLen;
+
+            if (minDiffX*minDiffX + minDiffZ*minDiffZ <= radiusSq) {
+                rowsHalfWidths[dz + radiusInPixelsZ] = dx;
+                break;
+            }
+        }
+    }
+}
+
+
+bool CutterStamp::Matches(const MillingCutter &cutter, const float pixelXLen, const float pixelZLen) const
+{
+    return this->cutter.radius == cutter.radius &&
+           this->cutter.height == cutter.height &&
+           this->cutter.Profile() == cutter.Profile() &&
+           this->pixelXLen == pixelXLen &&
+           this->pixelZLen == pixelZLen;
+}
+
+
+MillingResult CutterStamp::Mill(MaterialHeightMap &heightMap, const alg::Vec3 &cutterPos, const PixelRect &clip) const
+{
+    const PixelRect bounds = clip.Intersection(heightMap.Bounds());
+
+    switch (cutter.type) {
+        case MillingCutter::Type::Flat:
+            return MillRows<Kernel::Flat>(heightMap, cutterPos, bounds);
+
+        case MillingCutter::Type::Round:
+            return MillRows<Kernel::Round>(heightMap, cutterPos, bounds);
+
+        default:
+            return MillRows<Kernel::Profile>(heightMap, cutterPos, bounds);
+    }
+}
+
+
+template <CutterStamp::Kernel kernel>
+MillingResult CutterStamp::MillRows(MaterialHeightMap &heightMap, const alg::Vec3 &cutterPos, const PixelRect &clip) const
+{
+    const int middleX = static_cast<int>(std::round((cutterPos.X() - heightMap.MinX()) / pixelXLen));
+    const int middleZ = static_cast<int>(std::round((cutterPos.Z() - heightMap.MinZ()) / pixelZLen));
+
+    const float radius = cutter.radius;
+    const float radiusSq = radius * radius;
+    const CutterProfile& profile = cutter.Profile();
+    const float cutterY = cutterPos.Y();
+    const float cutterHeight = cutter.height;
+    const float baseLevel = heightMap.BaseLevel();
+    const float fillHeight = heightMap.FillHeight();
+
+    // Same as GlobalX, but kept in locals, so the compiler knows that writing heights does not change them
+    const float cutterX = cutterPos.X();
+    const float firstPixelX = heightMap.MinX() + heightMap.PixelXLen()/2.f;
+    const float heightMapPixelXLen = heightMap.PixelXLen();
+
+    bool materialRemoved = false;
+    bool underTheBase = false;
+    bool tooDeep = false;
+
+    for (int dz = -radiusInPixelsZ; dz <= radiusInPixelsZ; ++dz) {
+        const int halfWidth = rowsHalfWidths[dz + radiusInPixelsZ];
+        const int z = middleZ + dz;
+
+        if (halfWidth < 0 || z < clip.minZ || z >= clip.maxZ)
+            continue;
+
+        const float diffZ = heightMap.GlobalZ(z) - cutterPos.Z();
+        const float diffZSq = diffZ * diffZ;
+
+        const int beginX = std::max(middleX - halfWidth, clip.minX);
+        const int endX = std::min(middleX + halfWidth + 1, clip.maxX);
+
+        // The row is split into parts inside single tiles, which are stored separately
+        for (int segmentBegin = beginX; segmentBegin < endX; ) {
+            const int tileX = segmentBegin >> MaterialHeightMap::tileSizeLog2;
+            const int segmentEnd = std::min(endX, (tileX + 1) * MaterialHeightMap::tileSize);
+
+            // Whole cutter is above the untouched tile, so it is left not allocated
+            const bool untouched = !heightMap.IsTileMaterialized(tileX, z >> MaterialHeightMap::tileSizeLog2);
+            if (untouched && cutterY >= fillHeight) {
+                segmentBegin = segmentEnd;
+                continue;
+            }
+
+            float* row = heightMap.MaterializedRow(segmentBegin, z);
+
+            // Loop without branches, so it can be vectorized. Pixels outside the cutter
+            // get infinite cutter height, which does not change the material.
+            for (int x = segmentBegin; x < segmentEnd; ++x) {
+                const float diffX = firstPixelX + heightMapPixelXLen * static_cast<float>(x) - cutterX;
+                const float lenSq = diffX*diffX + diffZSq;
+
+                // Same operations as in the profile evaluation, so the heights are exactly the same
+                float pixelCutterY;
+                if constexpr (kernel == Kernel::Flat)
+                    pixelCutterY = lenSq > radiusSq ? std::numeric_limits<float>::infinity() : cutterY;
+                else if constexpr (kernel == Kernel::Round) {
+                    const float dist = std::sqrt(lenSq);
+                    pixelCutterY = lenSq > radiusSq ? std::numeric_limits<float>::infinity() :
+                        cutterY + (radius - std::sqrt(std::max(radiusSq - dist * dist, 0.f)));
+                }
+                else
+                    pixelCutterY = cutterY + profile.HeightAt(lenSq);
+
+                // Not oldHeight - diff, which might be above the cutter because of the rounding
+                const float oldHeight = row[x - segmentBegin];
+                const float newHeight = std::min(oldHeight, pixelCutterY);
+                const float diff = oldHeight - newHeight;
+                row[x - segmentBegin] = newHeight;
+
+                const bool removed = diff > 0.f;
+                materialRemoved |= removed;
+                underTheBase |= removed & (newHeight < baseLevel);
+                tooDeep |= diff > cutterHeight;
+            }
+
+            segmentBegin = segmentEnd;
+        }
+    }
+
+    return {
+        .materialRemoved = materialRemoved,
+        .underTheBase = underTheBase,
+        .tooDeep = tooDeep
+    };
+}
@@ -0,0 +1,230 @@
+#include <CAD_modeler/model/millingMachineSim/deviationAnalysis.hpp>
+
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+
+namespace
+{
+    /// @brief Sums over a block of rows, merged in the blocks order, so that the result does not depend on the threads
+    class PartialDeviation {
+    public:
+        size_t undercutPixels = 0;
+        size_t overcutPixels = 0;
+
+        float maxUndercut = 0.f;
+        float maxOvercut = 0.f;
+
+        double deviationSum = 0.0;
+        double absDeviationSum = 0.0;
+        double squaredDeviationSum = 0.0;
+
+        double removedSum = 0.0;
+        double undercutSum = 0.0;
+        double overcutSum = 0.0;
+
+        std::vector<size_t> histogram;
+    };
+
+
+    void CheckGridsMatch(const MaterialHeightMap& heightMap, const TargetHeights& target)
+    {
+        if (heightMap.XResolution() != target.XResolution() || heightMap.ZResolution() != target.ZResolution())
+            throw std::invalid_argument("Target heights resolution does not match the material");
+
+        constexpr float relativeEps = 1e-4f;
+        if (std::abs(heightMap.XLength() - target.XLength()) > relativeEps * heightMap.XLength() ||
+            std::abs(heightMap.ZLength() - target.ZLength()) > relativeEps * heightMap.ZLength())
+            throw std::invalid_argument("Target heights size does not match the material");
+    }
+}
+
+
+DeviationReport AnalyzeDeviation(
+    const MaterialHeightMap &heightMap,
+    const TargetHeights &target,
+    const float initHeight,
+    const DeviationSettings &settings
+) {
+    CheckGridsMatch(heightMap, target);
+
+    if (settings.histogramBins <= 0 || settings.histogramRange <= 0.f)
+        throw std::invalid_argument("Histogram has to have positive bins count and range");
+
+    const int width = heightMap.XResolution();
+    const int rows = heightMap.ZResolution();
+
+    // Blocks of rows follow the height map tiles, so every block reads whole tiles
+    constexpr int blockRows = MaterialHeightMap::tileSize;
+    const int blocksCnt = (rows + blockRows - 1) / blockRows;
+
+    std::vector<PartialDeviation> partials(blocksCnt);
+
+    const float binsPerLen = static_cast<float>(settings.histogramBins) / (2.f * settings.histogramRange);
+
+    const unsigned int workersCnt = ParallelWorkersCnt(blocksCnt, settings.threadsCnt);
+    std::vector<std::vector<float>> workersMilled(workersCnt, std::vector<float>(width));
+
+    ParallelFor(blocksCnt, settings.threadsCnt, [&] (const size_t block, const unsigned int workerIdx) {
+        std::vector<float>& milled = workersMilled[workerIdx];
+
+        PartialDeviation& partial = partials[block];
+        partial.histogram.assign(settings.histogramBins, 0);
+
+        const int endRow = std::min((static_cast<int>(block) + 1) * blockRows, rows);
+        for (int z = static_cast<int>(block) * blockRows; z < endRow; ++z) {
+            heightMap.CopyRow(z, milled.data());
+            const float* targetRow = target.Row(z);
+
+            for (int x = 0; x < width; ++x) {
+                const float deviation = milled[x] - targetRow[x];
+
+                if (deviation > settings.tolerance)
+                    ++partial.undercutPixels;
+                else if (deviation < -settings.tolerance)
+                    ++partial.overcutPixels;
+
+                if (deviation > 0.f) {
+                    partial.maxUndercut = std::max(partial.maxUndercut, deviation);
+                    partial.undercutSum += deviation;
+                }
+                else {
+                    partial.maxOvercut = std::max(partial.maxOvercut, -deviation);
+                    partial.overcutSum -= deviation;
+                }
+
+                partial.deviationSum += deviation;
+                partial.absDeviationSum += std::abs(deviation);
+                partial.squaredDeviationSum += static_cast<double>(deviation) * deviation;
+                partial.removedSum += initHeight - milled[x];
+
+                const int bin = static_cast<int>(std::floor((deviation + settings.histogramRange) * binsPerLen));
+                ++partial.histogram[std::clamp(bin, 0, settings.histogramBins - 1)];
+            }
+        }
+    });
+
+    DeviationReport report {
+        .tolerance = settings.tolerance,
+        .pixelsCnt = static_cast<size_t>(width) * rows,
+        .histogramRange = settings.histogramRange,
+        .histogram = std::vector<size_t>(settings.histogramBins, 0)
+    };
+
+    double deviationSum = 0.0, absDeviationSum = 0.0, squaredDeviationSum = 0.0;
+    double removedSum = 0.0, undercutSum = 0.0, overcutSum = 0.0;
+
+    for (const auto& partial : partials) {
+        report.undercutPixels += partial.undercutPixels;
+        report.overcutPixels += partial.overcutPixels;
+        report.maxUndercut = std::max(report.maxUndercut, partial.maxUndercut);
+        report.maxOvercut = std::max(report.maxOvercut, partial.maxOvercut);
+
+        deviationSum += partial.deviationSum;
+        absDeviationSum += partial.absDeviationSum;
+        squaredDeviationSum += partial.squaredDeviationSum;
+        removedSum += partial.removedSum;
+        undercutSum += partial.undercutSum;
+        overcutSum += partial.overcutSum;
+
+        for (int bin = 0; bin < settings.histogramBins; ++bin)
+            report.histogram[bin] += partial.histogram[bin];
+    }
+
+    const auto pixels = static_cast<double>(report.pixelsCnt);
+    const double pixelArea = static_cast<double>(heightMap.PixelXLen()) * heightMap.PixelZLen();
+
+    report.meanDeviation = deviationSum / pixels;
+    report.meanAbsDeviation = absDeviationSum / pixels;
+    report.rmsDeviation = std::sqrt(squaredDeviationSum / pixels);
+    report.removedVolume = removedSum * pixelArea;
+    report.undercutVolume = undercutSum * pixelArea;
+    report.overcutVolume = overcutSum * pixelArea;
+
+    return report;
+}
+
+
+void SaveDeviationImage(
+    const MaterialHeightMap &heightMap,
+    const TargetHeights &target,
+    const std::string &filePath,
+    const float tolerance,
+    const float range
+) {
+    CheckGridsMatch(heightMap, target);
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    const int width = heightMap.XResolution();
+    const int height = heightMap.ZResolution();
+    const float colorRange = std::max(range - tolerance, std::numeric_limits<float>::min());
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<float> milled(width);
+    std::vector<std::uint8_t> row(3 * width);
+
+    for (int z = 0; z < height; ++z) {
+        heightMap.CopyRow(z, milled.data());
+        const float* targetRow = target.Row(z);
+
+        for (int x = 0; x < width; ++x) {
+            const float deviation = milled[x] - targetRow[x];
+            std::uint8_t* pixel = row.data() + 3*x;
+
+            if (std::abs(deviation) <= tolerance) {
+                pixel[0] = 0;
+                pixel[1] = 200;
+                pixel[2] = 0;
+                continue;
+            }
+
+            const float saturation = std::min((std::abs(deviation) - tolerance) / colorRange, 1.f);
+            const auto faded = static_cast<std::uint8_t>(std::lround(255.f * (1.f - saturation)));
+
+            pixel[0] = deviation > 0.f ? faded : 255;
+            pixel[1] = faded;
+            pixel[2] = deviation > 0.f ? 255 : faded;
+        }
+
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+}
+
+
+void SaveDeviationReportJson(const DeviationReport &report, const std::string &filePath)
+{
+    std::ofstream file(filePath);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    nlohmann::json json;
+
+    json["tolerance"] = report.tolerance;
+    json["pixels"] = report.pixelsCnt;
+    json["undercutPixels"] = report.undercutPixels;
+    json["overcutPixels"] = report.overcutPixels;
+    json["maxUndercut"] = report.maxUndercut;
+    json["maxOvercut"] = report.maxOvercut;
+    json["meanDeviation"] = report.meanDeviation;
+    json["meanAbsDeviation"] = report.meanAbsDeviation;
+    json["rmsDeviation"] = report.rmsDeviation;
+    json["removedVolume"] = report.removedVolume;
+    json["undercutVolume"] = report.undercutVolume;
+    json["overcutVolume"] = report.overcutVolume;
+    json["histogram"]["range"] = report.histogramRange;
+    json["histogram"]["bins"] = report.histogram;
+
+    file << json.dump(4) << '\n';
+}
@@ -0,0 +1,162 @@
+#include <CAD_modeler/model/millingMachineSim/gCodeParser.hpp>
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+    [[noreturn]]
+    void ThrowError(const int lineNumber, const std::string& message)
+    {
+        throw std::invalid_argument("Invalid GCode file, line " + std::to_string(lineNumber) + ": " + message);
+    }
+
+
+    template <typename T>
+    T ParseNumber(const char*& begin, const char* end, const char word, const int lineNumber)
+    {
+        // std::from_chars does not accept the plus sign
+        if (begin != end && *begin == '+')
+            ++begin;
+
+        T value;
+        const auto [ptr, ec] = std::from_chars(begin, end, value);
+
+        if (ec != std::errc())
+            ThrowError(lineNumber, std::string("invalid number after '") + word + "'");
+
+        begin = ptr;
+        return value;
+    }
+
+
+    char ToUpper(const char c)
+    {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+}
+
+
+GCodeParser::GCodeParser(const float scale):
+    scale(scale)
+{
+}
+
+
+MillingMachinePath GCodeParser::Parse(const std::string_view gCode)
+{
+    MillingMachinePath result;
+
+    x.reset();
+    y.reset();
+    z.reset();
+    motion.reset();
+
+    int lineNumber = 0;
+    size_t lineStart = 0;
+
+    while (lineStart < gCode.size()) {
+        size_t lineEnd = gCode.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+            lineEnd = gCode.size();
+
+        std::string_view line = gCode.substr(lineStart, lineEnd - lineStart);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        ParseLine(line, ++lineNumber, result);
+
+        lineStart = lineEnd + 1;
+    }
+
+    return result;
+}
+
+
+void GCodeParser::ParseLine(const std::string_view line, const int lineNumber, MillingMachinePath &path)
+{
+    // Program start and end markers
+    if (line.empty() || line.front() == '%')
+        return;
+
+    std::optional<int> id;
+    bool coordinatesFound = false;
+
+    const char* it = line.data();
+    const char* end = line.data() + line.size();
+
+    while (it != end) {
+        const char c = ToUpper(*it);
+
+        if (c == ' ' || c == '\t') {
+            ++it;
+            continue;
+        }
+
+        if (c == ';')
+            break;
+
+        if (c == '(') {
+            while (it != end && *it != ')')
+                ++it;
+
+            if (it == end)
+                ThrowError(lineNumber, "unclosed comment");
+
+            ++it;
+            continue;
+        }
+
+        if (c < 'A' || c > 'Z')
+            ThrowError(lineNumber, std::string("unexpected character '") + *it + "'");
+
+        ++it;
+
+        switch (c) {
+            case 'N':
+                id = ParseNumber<int>(it, end, c, lineNumber);
+                break;
+
+            case 'G': {
+                const int gCode = ParseNumber<int>(it, end, c, lineNumber);
+                if (gCode == 0 || gCode == 1)
+                    motion = gCode;
+                break;
+            }
+
+            case 'X':
+                x = ParseNumber<float>(it, end, c, lineNumber);
+                coordinatesFound = true;
+                break;
+
+            case 'Y':
+                y = ParseNumber<float>(it, end, c, lineNumber);
+                coordinatesFound = true;
+                break;
+
+            case 'Z':
+                z = ParseNumber<float>(it, end, c, lineNumber);
+                coordinatesFound = true;
+                break;
+
+            default:
+                // Words not changing the cutter path, like spindle speed or feed rate
+                ParseNumber<float>(it, end, c, lineNumber);
+                break;
+        }
+    }
+
+    if (!coordinatesFound)
+        return;
+
+    if (!motion.has_value())
+        ThrowError(lineNumber, "coordinates without G00 or G01 motion");
+
+    if (!x.has_value() || !y.has_value() || !z.has_value())
+        ThrowError(lineNumber, "the first move has to specify all the coordinates");
+
+    // Different coordinate systems conventions
+    path.AddCommand(id.value_or(lineNumber), *y * scale, *z * scale, *x * scale);
+}
@@ -0,0 +1,101 @@
+#include <CAD_modeler/model/millingMachineSim/gCodeWriter.hpp>
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+
+GCodeWriter::GCodeWriter(const float scale):
+    scale(scale)
+{
+    buffer.reserve(flushThreshold + 256);
+}
+
+
+void GCodeWriter::Write(const MillingMachinePath &path, std::ostream &out)
+{
+    const auto commands = path.Commands();
+    if (commands.empty())
+        return;
+
+    buffer.clear();
+
+    int id = commands.front().id;
+
+    FormattedFloat lastX, lastY, lastZ;
+    bool first = true;
+
+    for (const auto& command : commands) {
+        // Different coordinates conventions
+        const FormattedFloat actX = Format(command.destination.GetZ() / scale);
+        const FormattedFloat actY = Format(command.destination.GetX() / scale);
+        const FormattedFloat actZ = Format(command.destination.GetY() / scale);
+
+        const bool xChanged = first || !(actX == lastX);
+        const bool yChanged = first || !(actY == lastY);
+        const bool zChanged = first || !(actZ == lastZ);
+
+        if (!xChanged && !yChanged && !zChanged)
+            continue;
+
+        buffer.push_back('N');
+        AppendInt(id++);
+        buffer.append("G01");
+
+        if (xChanged) {
+            buffer.push_back('X');
+            Append(actX);
+        }
+
+        if (yChanged) {
+            buffer.push_back('Y');
+            Append(actY);
+        }
+
+        if (zChanged) {
+            buffer.push_back('Z');
+            Append(actZ);
+        }
+
+        buffer.append("\r\n");
+
+        lastX = actX;
+        lastY = actY;
+        lastZ = actZ;
+        first = false;
+
+        if (buffer.size() >= flushThreshold) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+
+GCodeWriter::FormattedFloat GCodeWriter::Format(const float value)
+{
+    FormattedFloat result;
+
+    const auto [ptr, ec] = std::to_chars(
+        result.chars.data(), result.chars.data() + result.chars.size(), value, std::chars_format::fixed, precision
+    );
+
+    // Values too big for the buffer would leave the coordinate empty
+    if (ec != std::errc())
+        throw std::invalid_argument("Coordinate " + std::to_string(value) + " cannot be written to G-code");
+
+    result.length = static_cast<size_t>(ptr - result.chars.data());
+    return result;
+}
+
+
+void GCodeWriter::AppendInt(const int value)
+{
+    std::array<char, 16> chars{};
+    const auto [ptr, ec] = std::to_chars(chars.data(), chars.data() + chars.size(), value);
+
+    buffer.append(chars.data(), ptr);
+}
@@ -0,0 +1,213 @@
+#include <CAD_modeler/model/millingMachineSim/heightMapCheckpoints.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+HeightMapCheckpoints::HeightMapCheckpoints(const size_t commandsInterval, const double timeInterval, const size_t memoryBudget):
+    commandsInterval(commandsInterval), timeInterval(timeInterval), memoryBudget(memoryBudget)
+{
+}
+
+
+void HeightMapCheckpoints::Reset(const MaterialHeightMap &heightMap, const size_t command, const double simulatedTime)
+{
+    Clear();
+
+    fillHeight = heightMap.FillHeight();
+    tilesX = heightMap.TilesX();
+    tilesZ = heightMap.TilesZ();
+    savedVersions.resize(tilesX * tilesZ);
+
+    Checkpoint checkpoint { .command = command, .simulatedTime = simulatedTime, .tiles = {} };
+
+    for (int tile = 0; tile < tilesX * tilesZ; ++tile) {
+        const int tileX = tile % tilesX;
+        const int tileZ = tile / tilesX;
+
+        if (heightMap.IsTileMaterialized(tileX, tileZ))
+            SaveTile(heightMap, tile, checkpoint);
+
+        savedVersions[tile] = heightMap.TileVersion(tileX, tileZ);
+    }
+
+    checkpoints.push_back(std::move(checkpoint));
+    FitInBudget();
+}
+
+
+void HeightMapCheckpoints::Clear()
+{
+    checkpoints.clear();
+    savedVersions.clear();
+    memoryUsage = 0;
+}
+
+
+bool HeightMapCheckpoints::Due(const size_t command, const double simulatedTime) const
+{
+    if (checkpoints.empty())
+        return false;
+
+    const auto& last = checkpoints.back();
+    if (command <= last.command)
+        return false;
+
+    return command - last.command >= commandsInterval || simulatedTime - last.simulatedTime >= timeInterval;
+}
+
+
+void HeightMapCheckpoints::Take(const MaterialHeightMap &heightMap, const size_t command, const double simulatedTime)
+{
+    if (checkpoints.empty() || heightMap.TilesX() != tilesX || heightMap.TilesZ() != tilesZ)
+        throw std::invalid_argument("Checkpoints were not reset for the height map");
+
+    if (command <= checkpoints.back().command)
+        throw std::invalid_argument("Checkpoint has to be taken after the last one");
+
+    Checkpoint checkpoint { .command = command, .simulatedTime = simulatedTime, .tiles = {} };
+
+    // Only tiles marked changed since the previous checkpoint are saved
+    for (int tile = 0; tile < tilesX * tilesZ; ++tile) {
+        const auto version = heightMap.TileVersion(tile % tilesX, tile / tilesX);
+        if (version == savedVersions[tile])
+            continue;
+
+        SaveTile(heightMap, tile, checkpoint);
+        savedVersions[tile] = version;
+    }
+
+    checkpoints.push_back(std::move(checkpoint));
+    FitInBudget();
+}
+
+
+HeightMapCheckpoints::Restored HeightMapCheckpoints::Restore(MaterialHeightMap &heightMap, const size_t command)
+{
+    if (checkpoints.empty() || heightMap.TilesX() != tilesX || heightMap.TilesZ() != tilesZ)
+        throw std::invalid_argument("Checkpoints were not reset for the height map");
+
+    const auto next = std::ranges::upper_bound(checkpoints, command, {}, &Checkpoint::command);
+    if (next == checkpoints.begin())
+        throw std::invalid_argument("There is no checkpoint before the command");
+
+    const size_t restoredIdx = std::distance(checkpoints.begin(), next) - 1;
+
+    // Every checkpoint holds tiles changed since the previous one, so the latest snapshot of each tile is used
+    std::vector<const TileSnapshot*> latest(tilesX * tilesZ, nullptr);
+    for (size_t i = 0; i <= restoredIdx; ++i) {
+        for (const auto& snapshot : checkpoints[i].tiles)
+            latest[snapshot.tile] = &snapshot;
+    }
+
+    heightMap.Fill(fillHeight);
+
+    std::vector<float> heights;
+    for (int tile = 0; tile < tilesX * tilesZ; ++tile) {
+        if (latest[tile] == nullptr)
+            continue;
+
+        const auto& snapshotHeights = latest[tile]->heights;
+        if (snapshotHeights.size() == 1)
+            heights.assign(MaterialHeightMap::tileSize * MaterialHeightMap::tileSize, snapshotHeights.front());
+        else
+            heights = snapshotHeights;
+
+        heightMap.RestoreTile(tile % tilesX, tile / tilesX, heights);
+    }
+
+    heightMap.MarkChanged(heightMap.Bounds());
+    heightMap.RefreshHeightRanges();
+
+    for (int tile = 0; tile < tilesX * tilesZ; ++tile)
+        savedVersions[tile] = heightMap.TileVersion(tile % tilesX, tile / tilesX);
+
+    for (size_t i = restoredIdx + 1; i < checkpoints.size(); ++i) {
+        for (const auto& snapshot : checkpoints[i].tiles)
+            memoryUsage -= MemoryOf(snapshot);
+    }
+
+    checkpoints.resize(restoredIdx + 1);
+
+    return { .command = checkpoints.back().command, .simulatedTime = checkpoints.back().simulatedTime };
+}
+
+
+void HeightMapCheckpoints::SetMemoryBudget(const size_t budget)
+{
+    memoryBudget = budget;
+    FitInBudget();
+}
+
+
+void HeightMapCheckpoints::SaveTile(const MaterialHeightMap &heightMap, const int tile, Checkpoint &checkpoint)
+{
+    TileSnapshot snapshot { .tile = tile, .heights = {} };
+
+    const int tileX = tile % tilesX;
+    const int tileZ = tile / tilesX;
+
+    if (heightMap.IsTileMaterialized(tileX, tileZ)) {
+        constexpr int pixels = MaterialHeightMap::tileSize * MaterialHeightMap::tileSize;
+        const float* data = heightMap.TileData(tileX, tileZ);
+
+        if (std::all_of(data, data + pixels, [first = data[0]](const float h) { return h == first; })) {
+            // Tile milled back to the fill height is the same as the untouched one
+            if (data[0] != fillHeight)
+                snapshot.heights.push_back(data[0]);
+        }
+        else
+            snapshot.heights.assign(data, data + pixels);
+    }
+
+    memoryUsage += MemoryOf(snapshot);
+    checkpoint.tiles.push_back(std::move(snapshot));
+}
+
+
+void HeightMapCheckpoints::FitInBudget()
+{
+    // The first checkpoint is the starting state and the last one is the base of the next deltas, so they are kept
+    while (memoryUsage > memoryBudget && checkpoints.size() > 2) {
+        size_t mergedIdx = 1;
+        size_t shortestGap = std::numeric_limits<size_t>::max();
+
+        for (size_t i = 1; i + 1 < checkpoints.size(); ++i) {
+            const size_t gap = checkpoints[i + 1].command - checkpoints[i - 1].command;
+            if (gap < shortestGap) {
+                shortestGap = gap;
+                mergedIdx = i;
+            }
+        }
+
+        MergeIntoNext(mergedIdx);
+    }
+}
+
+
+void HeightMapCheckpoints::MergeIntoNext(const size_t idx)
+{
+    auto& merged = checkpoints[idx];
+    auto& next = checkpoints[idx + 1];
+
+    std::vector<bool> inNext(tilesX * tilesZ, false);
+    for (const auto& snapshot : next.tiles)
+        inNext[snapshot.tile] = true;
+
+    // Snapshots overwritten by the next checkpoint are not needed anymore
+    for (auto& snapshot : merged.tiles) {
+        if (inNext[snapshot.tile])
+            memoryUsage -= MemoryOf(snapshot);
+        else
+            next.tiles.push_back(std::move(snapshot));
+    }
+
+    checkpoints.erase(checkpoints.begin() + static_cast<std::ptrdiff_t>(idx));
+}
+
+
+size_t HeightMapCheckpoints::MemoryOf(const TileSnapshot &snapshot)
+{
+    return sizeof(TileSnapshot) + snapshot.heights.capacity() * sizeof(float);
+}
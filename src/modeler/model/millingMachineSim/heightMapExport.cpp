@@ -0,0 +1,56 @@
+#include <CAD_modeler/model/millingMachineSim/heightMapExport.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+void SaveHeightMapPGM(const MaterialHeightMap &heightMap, const std::string &filePath, const float topHeight)
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    constexpr int maxGray = 65535;
+
+    const int width = heightMap.XResolution();
+    const int height = heightMap.ZResolution();
+    const float baseLevel = heightMap.BaseLevel();
+    const float range = std::max(topHeight - baseLevel, std::numeric_limits<float>::min());
+
+    file << "P5\n" << width << " " << height << "\n" << maxGray << "\n";
+
+    // 16-bit PGM samples are stored with the most significant byte first
+    std::vector<std::uint8_t> row(2 * width);
+
+    for (int z = 0; z < height; ++z) {
+        for (int x = 0; x < width; ++x) {
+            const float normalized = std::clamp((heightMap.HeightAt(x, z) - baseLevel) / range, 0.f, 1.f);
+            const auto gray = static_cast<std::uint16_t>(std::lround(normalized * maxGray));
+
+            row[2*x] = static_cast<std::uint8_t>(gray >> 8);
+            row[2*x + 1] = static_cast<std::uint8_t>(gray & 0xFF);
+        }
+
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+}
+
+
+void SaveHeightMapRaw(const MaterialHeightMap &heightMap, const std::string &filePath)
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    std::vector<float> row(heightMap.XResolution());
+
+    for (int z = 0; z < heightMap.ZResolution(); ++z) {
+        heightMap.CopyRow(z, row.data());
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size() * sizeof(float)));
+    }
+}
@@ -0,0 +1,74 @@
+#include <CAD_modeler/model/millingMachineSim/heightMapLod.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+
+HeightMapLod::HeightMapLod(const float detail):
+    detail(detail)
+{
+}
+
+
+const std::vector<PixelRect>& HeightMapLod::SelectPatches(const MaterialHeightMap &heightMap, const HeightPyramid &pyramid, const alg::Vec3 &cameraPos)
+{
+    patches.clear();
+
+    if (heightMap.Bounds().Empty())
+        return patches;
+
+    int rootSize = patchCells;
+    while (rootSize < heightMap.XResolution() || rootSize < heightMap.ZResolution())
+        rootSize *= 2;
+
+    SelectPatches(heightMap, pyramid, cameraPos, { .minX = 0, .minZ = 0, .maxX = rootSize, .maxZ = rootSize });
+
+    return patches;
+}
+
+
+void HeightMapLod::SelectPatches(const MaterialHeightMap &heightMap, const HeightPyramid &pyramid, const alg::Vec3 &cameraPos, const PixelRect &node)
+{
+    const PixelRect inside = node.Intersection(heightMap.Bounds());
+    if (inside.Empty())
+        return;
+
+    // Patch with one quad per pixel cannot be more detailed
+    if (node.Width() <= patchCells) {
+        patches.push_back(node);
+        return;
+    }
+
+    HeightRange range = pyramid.RangeOfTiles(MaterialHeightMap::TilesOf(inside));
+    if (range.Empty())
+        range = { .min = 0.f, .max = 0.f };
+
+    // Heights are rendered on top of the base level
+    const float baseLevel = heightMap.BaseLevel();
+    const alg::Vec3 boxMin(heightMap.GlobalX(inside.minX), baseLevel + range.min, heightMap.GlobalZ(inside.minZ));
+    const alg::Vec3 boxMax(heightMap.GlobalX(inside.maxX - 1), baseLevel + range.max, heightMap.GlobalZ(inside.maxZ - 1));
+
+    const float nodeSize = static_cast<float>(node.Width()) * std::max(heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    if (DistanceToBox(cameraPos, boxMin, boxMax) >= detail * nodeSize) {
+        patches.push_back(node);
+        return;
+    }
+
+    const int half = node.Width() / 2;
+
+    for (int z = node.minZ; z < node.maxZ; z += half) {
+        for (int x = node.minX; x < node.maxX; x += half)
+            SelectPatches(heightMap, pyramid, cameraPos, { .minX = x, .minZ = z, .maxX = x + half, .maxZ = z + half });
+    }
+}
+
+
+float HeightMapLod::DistanceToBox(const alg::Vec3 &point, const alg::Vec3 &boxMin, const alg::Vec3 &boxMax)
+{
+    const float dx = std::max({ boxMin.X() - point.X(), 0.f, point.X() - boxMax.X() });
+    const float dy = std::max({ boxMin.Y() - point.Y(), 0.f, point.Y() - boxMax.Y() });
+    const float dz = std::max({ boxMin.Z() - point.Z(), 0.f, point.Z() - boxMax.Z() });
+
+    return std::sqrt(dx*dx + dy*dy + dz*dz);
+}
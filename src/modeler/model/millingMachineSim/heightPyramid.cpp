@@ -0,0 +1,92 @@
+#include <CAD_modeler/model/millingMachineSim/heightPyramid.hpp>
+
+
+void HeightPyramid::Reset(int tilesX, int tilesZ, const float height)
+{
+    levels.clear();
+    if (tilesX <= 0 || tilesZ <= 0)
+        return;
+
+    const HeightRange range { .min = height, .max = height };
+
+    while (true) {
+        levels.push_back({ .width = tilesX, .height = tilesZ, .ranges = std::vector(tilesX * tilesZ, range) });
+
+        if (tilesX <= 1 && tilesZ <= 1)
+            break;
+
+        tilesX = (tilesX + 1) / 2;
+        tilesZ = (tilesZ + 1) / 2;
+    }
+}
+
+
+void HeightPyramid::SetTile(int tileX, int tileZ, const HeightRange &range)
+{
+    levels.front().At(tileX, tileZ) = range;
+
+    for (size_t level = 1; level < levels.size(); ++level) {
+        const Level& lower = levels[level - 1];
+
+        tileX /= 2;
+        tileZ /= 2;
+
+        HeightRange joined;
+        for (int z = 2*tileZ; z < std::min(2*tileZ + 2, lower.height); ++z) {
+            for (int x = 2*tileX; x < std::min(2*tileX + 2, lower.width); ++x)
+                joined |= lower.At(x, z);
+        }
+
+        levels[level].At(tileX, tileZ) = joined;
+    }
+}
+
+
+HeightRange HeightPyramid::RangeOfTiles(const PixelRect &tiles) const
+{
+    HeightRange result;
+    if (levels.empty() || tiles.Empty())
+        return result;
+
+    const int topLevel = LevelsCnt() - 1;
+    RangeOfTiles(topLevel, 0, 0, tiles, result);
+
+    return result;
+}
+
+
+void HeightPyramid::RangeOfTiles(const int level, const int x, const int z, const PixelRect &tiles, HeightRange &result) const
+{
+    const PixelRect allTiles { .minX = 0, .minZ = 0, .maxX = levels.front().width, .maxZ = levels.front().height };
+    const PixelRect cellTiles = PixelRect {
+        .minX = x << level,
+        .minZ = z << level,
+        .maxX = (x + 1) << level,
+        .maxZ = (z + 1) << level
+    }.Intersection(allTiles);
+
+    const PixelRect common = cellTiles.Intersection(tiles);
+    if (common.Empty())
+        return;
+
+    const HeightRange& cell = levels[level].At(x, z);
+
+    // Cell range cannot change the result, so its children do not have to be visited
+    if (cell.min >= result.min && cell.max <= result.max)
+        return;
+
+    const bool cellInside = common.minX == cellTiles.minX && common.minZ == cellTiles.minZ &&
+        common.maxX == cellTiles.maxX && common.maxZ == cellTiles.maxZ;
+
+    if (level == 0 || cellInside) {
+        result |= cell;
+        return;
+    }
+
+    const Level& lower = levels[level - 1];
+
+    for (int childZ = 2*z; childZ < std::min(2*z + 2, lower.height); ++childZ) {
+        for (int childX = 2*x; childX < std::min(2*x + 2, lower.width); ++childX)
+            RangeOfTiles(level - 1, childX, childZ, tiles, result);
+    }
+}
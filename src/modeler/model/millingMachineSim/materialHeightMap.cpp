@@ -0,0 +1,243 @@
+#include <CAD_modeler/model/millingMachineSim/materialHeightMap.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+MaterialHeightMap::MaterialHeightMap(const int xResolution, const int zResolution, const float xLen, const float zLen, const float initHeight):
+    fillHeight(initHeight),
+    xResolution(xResolution),
+    zResolution(zResolution),
+    tilesX(0),
+    tilesZ(0),
+    corner(-xLen/2.f, 0.f, -zLen/2.f),
+    xLen(xLen),
+    zLen(zLen)
+{
+    SetResolution(xResolution, zResolution, initHeight);
+    ClearChangedRegion();
+}
+
+
+void MaterialHeightMap::SetResolution(const int xRes, const int zRes, const float height)
+{
+    xResolution = xRes;
+    zResolution = zRes;
+
+    tilesX = (xRes + tileSize - 1) / tileSize;
+    tilesZ = (zRes + tileSize - 1) / tileSize;
+
+    Fill(height);
+}
+
+
+void MaterialHeightMap::SetSize(const float xLen, const float zLen)
+{
+    this->xLen = xLen;
+    this->zLen = zLen;
+
+    corner.X() = -xLen / 2.f;
+    corner.Z() = -zLen / 2.f;
+}
+
+
+void MaterialHeightMap::Fill(const float height)
+{
+    // Reassigning frees the memory of all the materialized tiles
+    tiles = std::vector<std::vector<float>>(tilesX * tilesZ);
+
+    fillHeight = height;
+    fillTile.assign(tileSize * tileSize, height);
+
+    pyramid.Reset(tilesX, tilesZ, height);
+    outdatedRanges.assign(tilesX * tilesZ, false);
+    outdatedTiles.clear();
+
+    // Versions keep increasing, so that tiles saved before the fill are seen as changed
+    tileVersions.resize(tilesX * tilesZ);
+    for (auto& version : tileVersions)
+        ++version;
+
+    changedRegion = Bounds();
+}
+
+
+void MaterialHeightMap::MarkChanged(const PixelRect &region)
+{
+    const PixelRect clipped = region.Intersection(Bounds());
+    if (clipped.Empty())
+        return;
+
+    changedRegion = changedRegion.Union(clipped);
+
+    const PixelRect tilesRect = TilesOf(clipped);
+    for (int tileZ = tilesRect.minZ; tileZ < tilesRect.maxZ; ++tileZ) {
+        for (int tileX = tilesRect.minX; tileX < tilesRect.maxX; ++tileX) {
+            const int tile = tileZ*tilesX + tileX;
+            ++tileVersions[tile];
+
+            if (outdatedRanges[tile])
+                continue;
+
+            outdatedRanges[tile] = true;
+            outdatedTiles.push_back(tile);
+        }
+    }
+}
+
+
+void MaterialHeightMap::RefreshHeightRanges()
+{
+    for (const int tile : outdatedTiles) {
+        const int tileX = tile % tilesX;
+        const int tileZ = tile / tilesX;
+
+        pyramid.SetTile(tileX, tileZ, ComputeTileRange(tileX, tileZ));
+        outdatedRanges[tile] = false;
+    }
+
+    outdatedTiles.clear();
+}
+
+
+float MaterialHeightMap::MaxHeight(const PixelRect &region) const
+{
+    const PixelRect clipped = region.Intersection(Bounds());
+    if (clipped.Empty())
+        return -std::numeric_limits<float>::infinity();
+
+    return pyramid.RangeOfTiles(TilesOf(clipped)).max;
+}
+
+
+float MaterialHeightMap::MinHeight(const PixelRect &region) const
+{
+    const PixelRect clipped = region.Intersection(Bounds());
+    if (clipped.Empty())
+        return std::numeric_limits<float>::infinity();
+
+    // Tiles lying entirely inside the region are taken from the pyramid
+    const PixelRect innerTiles {
+        .minX = (clipped.minX + tileSize - 1) / tileSize,
+        .minZ = (clipped.minZ + tileSize - 1) / tileSize,
+        .maxX = clipped.maxX == xResolution ? tilesX : clipped.maxX / tileSize,
+        .maxZ = clipped.maxZ == zResolution ? tilesZ : clipped.maxZ / tileSize
+    };
+
+    float result = pyramid.RangeOfTiles(innerTiles).min;
+
+    // Pixels of the border tiles are checked one by one, unless the whole tile is higher than the result
+    const PixelRect tilesRect = TilesOf(clipped);
+    for (int tileZ = tilesRect.minZ; tileZ < tilesRect.maxZ; ++tileZ) {
+        for (int tileX = tilesRect.minX; tileX < tilesRect.maxX; ++tileX) {
+            if (innerTiles.Contains(tileX, tileZ) || pyramid.Tile(tileX, tileZ).min >= result)
+                continue;
+
+            const PixelRect part = clipped.Intersection(TileRect(tileX, tileZ));
+            for (int z = part.minZ; z < part.maxZ; ++z) {
+                for (int x = part.minX; x < part.maxX; ++x)
+                    result = std::min(result, HeightAt(x, z));
+            }
+        }
+    }
+
+    return result;
+}
+
+
+size_t MaterialHeightMap::MaterializedTilesCnt() const
+{
+    return std::ranges::count_if(tiles, [](const auto& tile) { return !tile.empty(); });
+}
+
+
+PixelRect MaterialHeightMap::TileRect(const int tileX, const int tileZ) const
+{
+    return {
+        .minX = tileX * tileSize,
+        .minZ = tileZ * tileSize,
+        .maxX = std::min((tileX + 1) * tileSize, xResolution),
+        .maxZ = std::min((tileZ + 1) * tileSize, zResolution)
+    };
+}
+
+
+void MaterialHeightMap::RestoreTile(const int tileX, const int tileZ, const std::vector<float> &heights)
+{
+    if (!heights.empty() && heights.size() != fillTile.size())
+        throw std::invalid_argument("Tile heights have to contain all the pixels of the tile");
+
+    tiles[tileZ*tilesX + tileX] = heights;
+}
+
+
+void MaterialHeightMap::Materialize(const PixelRect &region)
+{
+    const PixelRect clipped = region.Intersection(Bounds());
+    if (clipped.Empty())
+        return;
+
+    for (int tileZ = clipped.minZ / tileSize; tileZ <= (clipped.maxZ - 1) / tileSize; ++tileZ) {
+        for (int tileX = clipped.minX / tileSize; tileX <= (clipped.maxX - 1) / tileSize; ++tileX)
+            MaterializedTile(tileX * tileSize, tileZ * tileSize);
+    }
+}
+
+
+void MaterialHeightMap::CopyRow(const int z, float *destination) const
+{
+    const int tileZ = z / tileSize;
+    const int rowInTile = z % tileSize;
+
+    for (int tileX = 0; tileX < tilesX; ++tileX) {
+        const float* tileRow = TileData(tileX, tileZ) + rowInTile * tileSize;
+        const int width = std::min(tileSize, xResolution - tileX * tileSize);
+
+        std::copy_n(tileRow, width, destination + tileX * tileSize);
+    }
+}
+
+
+PixelRect MaterialHeightMap::TilesOf(const PixelRect &region)
+{
+    return {
+        .minX = region.minX / tileSize,
+        .minZ = region.minZ / tileSize,
+        .maxX = (region.maxX - 1) / tileSize + 1,
+        .maxZ = (region.maxZ - 1) / tileSize + 1
+    };
+}
+
+
+HeightRange MaterialHeightMap::ComputeTileRange(const int tileX, const int tileZ) const
+{
+    if (!IsTileMaterialized(tileX, tileZ))
+        return { .min = fillHeight, .max = fillHeight };
+
+    // Only pixels inside the height map are checked, the rest of the edge tiles is never written
+    const PixelRect rect = TileRect(tileX, tileZ);
+    const float* data = TileData(tileX, tileZ);
+
+    HeightRange range;
+    for (int z = 0; z < rect.Height(); ++z) {
+        const float* row = data + z*tileSize;
+
+        for (int x = 0; x < rect.Width(); ++x) {
+            range.min = std::min(range.min, row[x]);
+            range.max = std::max(range.max, row[x]);
+        }
+    }
+
+    return range;
+}
+
+
+std::vector<float>& MaterialHeightMap::MaterializedTile(const int x, const int z)
+{
+    auto& tile = tiles[TileIdx(x, z)];
+    if (tile.empty())
+        tile = fillTile;
+
+    return tile;
+}
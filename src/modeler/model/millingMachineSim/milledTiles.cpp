@@ -0,0 +1,54 @@
+#include <CAD_modeler/model/millingMachineSim/milledTiles.hpp>
+
+#include <algorithm>
+#include <thread>
+
+
+void MilledTiles::Reset(const MaterialHeightMap &heightMap, const int tileSize)
+{
+    this->tileSize = tileSize;
+
+    xResolution = heightMap.XResolution();
+    zResolution = heightMap.ZResolution();
+
+    tilesX = (xResolution + tileSize - 1) / tileSize;
+    tilesZ = (zResolution + tileSize - 1) / tileSize;
+
+    states = std::make_unique<std::atomic_uint8_t[]>(tilesX * tilesZ);
+}
+
+
+PixelRect MilledTiles::TileRect(const int tile) const
+{
+    const int tileX = tile % tilesX;
+    const int tileZ = tile / tilesX;
+
+    return {
+        .minX = tileX * tileSize,
+        .minZ = tileZ * tileSize,
+        .maxX = std::min((tileX + 1) * tileSize, xResolution),
+        .maxZ = std::min((tileZ + 1) * tileSize, zResolution)
+    };
+}
+
+
+void MilledTiles::Retract(std::vector<int> &retracted)
+{
+    for (int tile = 0; tile < tilesX*tilesZ; ++tile) {
+        std::uint8_t expected = Published;
+
+        while (!states[tile].compare_exchange_weak(expected, Idle, std::memory_order_acquire)) {
+            if (expected == Idle)
+                break;
+
+            // The tile is being read, so the worker has to wait before writing it
+            if (expected == Taken)
+                std::this_thread::yield();
+
+            expected = Published;
+        }
+
+        if (expected == Published)
+            retracted.push_back(tile);
+    }
+}
@@ -0,0 +1,76 @@
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+
+#include <algorithm>
+
+
+std::vector<MillingSection> PathSections(const MillingMachinePath &path, const size_t firstCommand, const size_t endCommand)
+{
+    const auto commands = path.Commands();
+    const size_t end = std::min(endCommand, commands.size());
+
+    std::vector<MillingSection> sections;
+    if (firstCommand >= end)
+        return sections;
+
+    sections.reserve(end - firstCommand);
+
+    for (size_t i = firstCommand; i < end; ++i)
+        sections.emplace_back(commands[i - 1].destination.vec, commands[i].destination.vec);
+
+    return sections;
+}
+
+
+float PathLength(const MillingMachinePath &path, const size_t firstCommand, const size_t endCommand)
+{
+    const auto commands = path.Commands();
+    const size_t end = std::min(endCommand, commands.size());
+
+    float length = 0.f;
+    for (size_t i = std::max(firstCommand, size_t{ 1 }); i < end; ++i)
+        length += alg::Distance(commands[i - 1].destination.vec, commands[i].destination.vec);
+
+    return length;
+}
+
+
+void MillPath(
+    const TiledMiller &miller,
+    MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const MillingMachinePath &path,
+    MillingWarningsRepo &warnings,
+    const size_t firstCommand,
+    const size_t endCommand,
+    const std::stop_token &stoken,
+    MilledTiles *milledTiles
+) {
+    const auto sections = PathSections(path, firstCommand, endCommand);
+    const auto results = miller.Mill(heightMap, cutter, sections, stoken, milledTiles);
+
+    for (size_t i = 0; i < results.size(); ++i)
+        ReportMillingWarnings(warnings, firstCommand + i, results[i], IsStraightDown(sections[i].start, sections[i].end));
+}
+
+
+void ReportMillingWarnings(MillingWarningsRepo &warnings, const size_t commandIdx, const MillingResult &result, const bool straightDown)
+{
+    if (!result.materialRemoved)
+        return;
+
+    if (result.underTheBase)
+        warnings.AddWarning(commandIdx, MillingWarningsRepo::MillingUnderTheBase);
+
+    if (result.tooDeep)
+        warnings.AddWarning(commandIdx, MillingWarningsRepo::MillingTooDeep);
+
+    if (straightDown)
+        warnings.AddWarning(commandIdx, MillingWarningsRepo::MillingStraightDown);
+}
+
+
+bool IsStraightDown(const alg::Vec3 &oldCutterPos, const alg::Vec3 &newCutterPos)
+{
+    const float crossLen = Cross((newCutterPos - oldCutterPos).Normalize(), alg::Vec3(0.f, 1.f, 0.f)).LengthSquared();
+    return crossLen < 1e-5;
+}
@@ -0,0 +1,80 @@
+#include <CAD_modeler/model/millingMachineSim/pathSimplification.hpp>
+
+#include <algorithm>
+#include <stack>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    float DistanceToSegmentSq(const alg::Vec3& point, const alg::Vec3& start, const alg::Vec3& end)
+    {
+        const alg::Vec3 segment = end - start;
+        const alg::Vec3 toPoint = point - start;
+
+        const float lenSq = segment.LengthSquared();
+        if (lenSq == 0.f)
+            return toPoint.LengthSquared();
+
+        const float t = std::clamp(alg::Dot(toPoint, segment) / lenSq, 0.f, 1.f);
+        return (toPoint - t * segment).LengthSquared();
+    }
+}
+
+
+MillingMachinePath SimplifyPath(const MillingMachinePath &path, const float tolerance)
+{
+    const auto commands = path.Commands();
+    if (commands.size() < 3)
+        return path;
+
+    const float toleranceSq = tolerance * tolerance;
+
+    std::vector<bool> keep(commands.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    // Iterative version, as recursion could be very deep for long zigzag paths
+    std::stack<std::pair<size_t, size_t>> ranges;
+    ranges.emplace(0, commands.size() - 1);
+
+    while (!ranges.empty()) {
+        const auto [first, last] = ranges.top();
+        ranges.pop();
+
+        const auto& start = commands[first].destination.vec;
+        const auto& end = commands[last].destination.vec;
+
+        float maxDistSq = -1.f;
+        size_t farthest = first;
+
+        for (size_t i = first + 1; i < last; ++i) {
+            const float distSq = DistanceToSegmentSq(commands[i].destination.vec, start, end);
+
+            if (distSq > maxDistSq) {
+                maxDistSq = distSq;
+                farthest = i;
+            }
+        }
+
+        if (maxDistSq <= toleranceSq)
+            continue;
+
+        keep[farthest] = true;
+
+        if (farthest - first > 1)
+            ranges.emplace(first, farthest);
+
+        if (last - farthest > 1)
+            ranges.emplace(farthest, last);
+    }
+
+    MillingMachinePath result;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        if (keep[i])
+            result.AddCommand(commands[i]);
+    }
+
+    return result;
+}
@@ -0,0 +1,193 @@
+#include <CAD_modeler/model/millingMachineSim/pathStepper.hpp>
+
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+
+PathStepper::PathStepper(const std::chrono::microseconds sliceBudget):
+    sliceBudget(sliceBudget)
+{
+}
+
+
+void PathStepper::Start(
+    MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const MillingMachinePath &path,
+    MillingWarningsRepo &warnings,
+    const Progress &start,
+    CommandMilledCallback onCommandMilled
+) {
+    if (Runs())
+        throw std::runtime_error("Path stepper is already running");
+
+    {
+        const std::lock_guard lock(stateMutex);
+        progress = start;
+        progress.pendingTime = 0.0;
+        progress.finished = start.command >= path.Size();
+    }
+
+    thread = std::jthread(
+        [this, &heightMap, &cutter, &path, &warnings, callback = std::move(onCommandMilled)] (const std::stop_token& stoken) {
+            Run(stoken, heightMap, cutter, path, warnings, callback);
+        }
+    );
+}
+
+
+PathStepper::Progress PathStepper::Stop()
+{
+    if (Runs()) {
+        thread.request_stop();
+        thread.join();
+    }
+
+    return GetProgress();
+}
+
+
+void PathStepper::SetSpeed(const float speed)
+{
+    const std::lock_guard lock(stateMutex);
+    this->speed = speed;
+}
+
+
+void PathStepper::AddTime(const double dt)
+{
+    {
+        const std::lock_guard lock(stateMutex);
+
+        // Stopped cutter does not move, so the time passing is not accumulated
+        if (speed <= 0.f || progress.finished)
+            return;
+
+        progress.pendingTime += dt;
+    }
+
+    timeAdded.notify_one();
+}
+
+
+PathStepper::Progress PathStepper::GetProgress() const
+{
+    const std::lock_guard lock(stateMutex);
+    return progress;
+}
+
+
+std::unique_lock<std::mutex> PathStepper::LockHeightMap()
+{
+    heightMapRequested.store(true, std::memory_order_relaxed);
+    std::unique_lock lock(heightMapMutex);
+    heightMapRequested.store(false, std::memory_order_relaxed);
+
+    return lock;
+}
+
+
+void PathStepper::Run(
+    const std::stop_token& stoken,
+    MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const MillingMachinePath &path,
+    MillingWarningsRepo &warnings,
+    const CommandMilledCallback &onCommandMilled
+) {
+    const auto commands = path.Commands();
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    auto millSection = [&] (const alg::Vec3& oldCutterPos, const alg::Vec3& newCutterPos, const size_t command) {
+        const auto result = MillPathSection(heightMap, cutter, stamp, oldCutterPos, newCutterPos, heightMap.Bounds());
+
+        if (result.materialRemoved)
+            heightMap.MarkChanged(SectionFootprint(heightMap, stamp, oldCutterPos, newCutterPos));
+
+        ReportMillingWarnings(warnings, command, result, IsStraightDown(oldCutterPos, newCutterPos));
+    };
+
+    while (true) {
+        Progress actual;
+        float actualSpeed;
+
+        {
+            std::unique_lock lock(stateMutex);
+            if (!timeAdded.wait(lock, stoken, [this] { return progress.pendingTime > 0.0 && !progress.finished; }))
+                return;
+
+            actual = progress;
+            actualSpeed = speed;
+        }
+
+        double available = actual.pendingTime;
+
+        {
+            const std::lock_guard heightMapLock(heightMapMutex);
+            const auto sliceEnd = std::chrono::steady_clock::now() + sliceBudget;
+
+            // The slice always makes progress, even if a single section takes longer than the budget
+            do {
+                const auto& actDest = commands[actual.command].destination.vec;
+                const float dist = static_cast<float>(available) * actualSpeed;
+                const float remainingCommandDist = alg::Distance(actDest, actual.cutterPos);
+
+                if (remainingCommandDist > dist) {
+                    const auto& prevDest = commands[actual.command - 1].destination.vec;
+                    const float traveledDist = alg::Distance(prevDest, actual.cutterPos);
+                    const alg::Vec3 newCutterPos = prevDest + (traveledDist + dist) * (actDest - prevDest).Normalize();
+
+                    millSection(actual.cutterPos, newCutterPos, actual.command);
+
+                    actual.cutterPos = newCutterPos;
+                    actual.simulatedTime += available;
+                    available = 0.0;
+                }
+                else {
+                    millSection(actual.cutterPos, actDest, actual.command);
+
+                    const double commandTime = actualSpeed > 0.f ? remainingCommandDist / actualSpeed : 0.0;
+                    actual.cutterPos = actDest;
+                    actual.simulatedTime += commandTime;
+                    available -= commandTime;
+                    ++actual.command;
+
+                    if (onCommandMilled)
+                        onCommandMilled(actual.command, actual.simulatedTime);
+
+                    actual.finished = actual.command >= commands.size();
+                }
+            } while (
+                !actual.finished && available > 0.0 &&
+                !heightMapRequested.load(std::memory_order_relaxed) &&
+                std::chrono::steady_clock::now() < sliceEnd
+            );
+
+            heightMap.RefreshHeightRanges();
+        }
+
+        {
+            const std::lock_guard lock(stateMutex);
+
+            // More time might have been added while milling the slice
+            const double consumed = actual.pendingTime - available;
+            progress.pendingTime = actual.finished ? 0.0 : std::max(progress.pendingTime - consumed, 0.0);
+
+            progress.command = actual.command;
+            progress.cutterPos = actual.cutterPos;
+            progress.simulatedTime = actual.simulatedTime;
+            progress.finished = actual.finished;
+        }
+
+        if (actual.finished)
+            return;
+
+        // Mutex is not fair, so the thread waiting for the height map is let in before the next slice
+        while (heightMapRequested.load(std::memory_order_relaxed) && !stoken.stop_requested())
+            std::this_thread::yield();
+    }
+}
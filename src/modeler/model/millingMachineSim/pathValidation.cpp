@@ -0,0 +1,105 @@
+#include <CAD_modeler/model/millingMachineSim/pathValidation.hpp>
+
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+namespace
+{
+    /// @brief The lowest tip height of the section part, in which the cutter is over the rectangle in the xz plane,
+    /// or infinity if it never is
+    float LowestTipOver(
+        const alg::Vec3& start, const alg::Vec3& end, const float minX, const float minZ, const float maxX, const float maxZ
+    ) {
+        float tMin = 0.f, tMax = 1.f;
+
+        // Clipping of the section projection, as in the Liang-Barsky algorithm
+        auto clip = [&tMin, &tMax] (const float p, const float q) {
+            if (p == 0.f)
+                return q >= 0.f;
+
+            const float t = q / p;
+            if (p < 0.f)
+                tMin = std::max(tMin, t);
+            else
+                tMax = std::min(tMax, t);
+
+            return tMin <= tMax;
+        };
+
+        const alg::Vec3 dir = end - start;
+
+        if (!clip(-dir.X(), start.X() - minX) || !clip(dir.X(), maxX - start.X()) ||
+            !clip(-dir.Z(), start.Z() - minZ) || !clip(dir.Z(), maxZ - start.Z()))
+            return std::numeric_limits<float>::infinity();
+
+        // Height changes linearly along the section, so the lowest point is at one of the clipped ends
+        return std::min(start.Y() + tMin * dir.Y(), start.Y() + tMax * dir.Y());
+    }
+}
+
+
+void ValidatePath(
+    const MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const MillingMachinePath &path,
+    MillingWarningsRepo &warnings,
+    const unsigned int threadsCnt
+) {
+    const auto commands = path.Commands();
+    if (commands.size() < 2)
+        return;
+
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    // Cutter mills the material, when any part of it is over the material
+    const float minX = heightMap.MinX() - cutter.radius;
+    const float minZ = heightMap.MinZ() - cutter.radius;
+    const float maxX = heightMap.MinX() + heightMap.XLength() + cutter.radius;
+    const float maxZ = heightMap.MinZ() + heightMap.ZLength() + cutter.radius;
+
+    auto validateCommand = [&] (const size_t command) {
+        const auto& start = commands[command - 1].destination.vec;
+        const auto& end = commands[command].destination.vec;
+
+        if (start == end)
+            return;
+
+        // Cutter moving straight up is in the hole made at the end of the previous command, so it mills nothing
+        const bool straightDown = IsStraightDown(start, end);
+        if (straightDown && end.Y() > start.Y() && command > 1)
+            return;
+
+        const float maxHeight = heightMap.MaxHeight(SectionFootprint(heightMap, stamp, start, end));
+        const float lowestY = std::min(start.Y(), end.Y());
+
+        // Cutter above the highest material in its footprint does not remove anything
+        if (lowestY >= maxHeight)
+            return;
+
+        if (maxHeight - lowestY > cutter.height)
+            warnings.AddWarning(command, MillingWarningsRepo::MillingTooDeep);
+
+        if (LowestTipOver(start, end, minX, minZ, maxX, maxZ) < heightMap.BaseLevel())
+            warnings.AddWarning(command, MillingWarningsRepo::MillingUnderTheBase);
+
+        if (straightDown)
+            warnings.AddWarning(command, MillingWarningsRepo::MillingStraightDown);
+    };
+
+    constexpr size_t chunkSize = 1024;
+    const size_t chunksCnt = (commands.size() - 1 + chunkSize - 1) / chunkSize;
+
+    ParallelFor(chunksCnt, threadsCnt, [&] (const size_t chunk) {
+        const size_t end = std::min(1 + (chunk + 1) * chunkSize, commands.size());
+
+        for (size_t command = 1 + chunk * chunkSize; command < end; ++command)
+            validateCommand(command);
+    });
+}
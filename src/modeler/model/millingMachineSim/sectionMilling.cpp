@@ -0,0 +1,120 @@
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+
+#include <CAD_modeler/model/millingMachineSim/sweptCutter.hpp>
+
+#include <algebra/vec2.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    alg::IVec2 PixelOf(const MaterialHeightMap& heightMap, const alg::Vec3& pos)
+    {
+        const float diffX = pos.X() - heightMap.MinX();
+        const float diffZ = pos.Z() - heightMap.MinZ();
+
+        return {
+            static_cast<int>(std::round(diffX / heightMap.PixelXLen())),
+            static_cast<int>(std::round(diffZ / heightMap.PixelZLen()))
+        };
+    }
+}
+
+
+MillingResult MillPathSection(
+    MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const CutterStamp &stamp,
+    const alg::Vec3 &oldCutterPos,
+    const alg::Vec3 &newCutterPos,
+    const PixelRect &clip
+) {
+    if (oldCutterPos == newCutterPos)
+        return {};
+
+    const PixelRect bounds = clip.Intersection(heightMap.Bounds());
+    if (bounds.Empty())
+        return {};
+
+    // Cutter moving above the highest material in its footprint cannot remove anything
+    const float lowestY = std::min(oldCutterPos.Y(), newCutterPos.Y());
+    if (lowestY >= heightMap.MaxHeight(bounds.Intersection(SectionFootprint(heightMap, stamp, oldCutterPos, newCutterPos))))
+        return {};
+
+    const SweptCutter sweptCutter(cutter, oldCutterPos, newCutterPos);
+
+    // Lowest part of the volume swept by the vertical move is the cutter at the lower end
+    if (sweptCutter.IsPlunge()) {
+        const auto& lowerPos = oldCutterPos.Y() < newCutterPos.Y() ? oldCutterPos : newCutterPos;
+        return stamp.Mill(heightMap, lowerPos, bounds);
+    }
+
+    const float pixelXLen = heightMap.PixelXLen();
+    const float pixelZLen = heightMap.PixelZLen();
+
+    // Ranges are extended by one pixel to be safe from rounding errors,
+    // pixels not covered by the cutter are left unchanged by the exact test anyway
+    const int beginZ = std::max(
+        static_cast<int>(std::floor((sweptCutter.MinZ() - heightMap.MinZ()) / pixelZLen - 0.5f)),
+        bounds.minZ
+    );
+    const int endZ = std::min(
+        static_cast<int>(std::ceil((sweptCutter.MaxZ() - heightMap.MinZ()) / pixelZLen - 0.5f)) + 1,
+        bounds.maxZ
+    );
+
+    MillingResult result;
+
+    for (int z = beginZ; z < endZ; ++z) {
+        const float globalZ = heightMap.GlobalZ(z);
+
+        const auto span = sweptCutter.Span(globalZ);
+        if (!span.has_value())
+            continue;
+
+        const int beginX = std::max(
+            static_cast<int>(std::floor((span->minX - heightMap.MinX()) / pixelXLen - 0.5f)),
+            bounds.minX
+        );
+        const int endX = std::min(
+            static_cast<int>(std::ceil((span->maxX - heightMap.MinX()) / pixelXLen - 0.5f)) + 1,
+            bounds.maxX
+        );
+
+        for (int x = beginX; x < endX; ++x) {
+            const float cutterY = sweptCutter.LowestPoint(heightMap.GlobalX(x), globalZ);
+            MillPixel(heightMap, x, z, cutterY, cutter.height, result);
+        }
+    }
+
+    return result;
+}
+
+
+PixelRect SectionFootprint(
+    const MaterialHeightMap &heightMap,
+    const CutterStamp &stamp,
+    const alg::Vec3 &oldCutterPos,
+    const alg::Vec3 &newCutterPos
+) {
+    if (oldCutterPos == newCutterPos)
+        return {};
+
+    const alg::IVec2 oldPosPixel = PixelOf(heightMap, oldCutterPos);
+    const alg::IVec2 newPosPixel = PixelOf(heightMap, newCutterPos);
+
+    // Additional pixel covers the rows and spans extended while milling
+    const int radiusX = stamp.RadiusInPixelsX() + 1;
+    const int radiusZ = stamp.RadiusInPixelsZ() + 1;
+
+    const PixelRect footprint {
+        .minX = std::min(oldPosPixel.X(), newPosPixel.X()) - radiusX,
+        .minZ = std::min(oldPosPixel.Y(), newPosPixel.Y()) - radiusZ,
+        .maxX = std::max(oldPosPixel.X(), newPosPixel.X()) + radiusX + 1,
+        .maxZ = std::max(oldPosPixel.Y(), newPosPixel.Y()) + radiusZ + 1
+    };
+
+    return footprint.Intersection(heightMap.Bounds());
+}
@@ -0,0 +1,263 @@
+#include <CAD_modeler/model/millingMachineSim/sweptCutter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+namespace
+{
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+
+    /// Extends the span by the chord of the circle in the given z
+    void AddCircleSpan(const float centerX, const float centerZ, const float radius, const float z, RowSpan& span)
+    {
+        const float diffZ = z - centerZ;
+        const float chordSq = radius*radius - diffZ*diffZ;
+        if (chordSq < 0.f)
+            return;
+
+        const float halfChord = std::sqrt(chordSq);
+        span.minX = std::min(span.minX, centerX - halfChord);
+        span.maxX = std::max(span.maxX, centerX + halfChord);
+    }
+}
+
+
+SweptCutter::SweptCutter(const MillingCutter &cutter, const alg::Vec3 &start, const alg::Vec3 &end):
+    cutter(cutter),
+    start(start),
+    end(end),
+    dirX(end.X() - start.X()),
+    dirZ(end.Z() - start.Z())
+{
+}
+
+
+std::optional<RowSpan> SweptCutter::Span(const float z) const
+{
+    RowSpan span { .minX = infinity, .maxX = -infinity };
+
+    AddCircleSpan(start.X(), start.Z(), cutter.radius, z, span);
+    AddCircleSpan(end.X(), end.Z(), cutter.radius, z, span);
+
+    // Rectangle between the circles, its intersection with the row is found by clipping the row with its edges
+    const float len = std::sqrt(dirX*dirX + dirZ*dirZ);
+    if (len > 0.f) {
+        const float normalX = -dirZ / len * cutter.radius;
+        const float normalZ = dirX / len * cutter.radius;
+
+        const std::array<std::array<float, 2>, 4> corners {{
+            { start.X() + normalX, start.Z() + normalZ },
+            { end.X() + normalX, end.Z() + normalZ },
+            { end.X() - normalX, end.Z() - normalZ },
+            { start.X() - normalX, start.Z() - normalZ }
+        }};
+
+        for (size_t i = 0; i < corners.size(); ++i) {
+            const auto& p1 = corners[i];
+            const auto& p2 = corners[(i + 1) % corners.size()];
+
+            const float diff1 = p1[1] - z;
+            const float diff2 = p2[1] - z;
+
+            if (diff1 * diff2 > 0.f || diff1 == diff2)
+                continue;
+
+            const float x = p1[0] + diff1 / (diff1 - diff2) * (p2[0] - p1[0]);
+            span.minX = std::min(span.minX, x);
+            span.maxX = std::max(span.maxX, x);
+        }
+    }
+
+    if (span.minX > span.maxX)
+        return std::nullopt;
+
+    return span;
+}
+
+
+float SweptCutter::LowestPoint(const float x, const float z) const
+{
+    switch (cutter.type) {
+        case MillingCutter::Type::Flat:
+            return FlatLowestPoint(x, z);
+
+        case MillingCutter::Type::Round:
+            return RoundLowestPoint(x, z);
+
+        default:
+            return ProfileLowestPoint(x, z);
+    }
+}
+
+
+std::optional<std::pair<double, double>> SweptCutter::CoveringRange(const float x, const float z) const
+{
+    // Cutter covers the point for t, in which |point - start - t*dir|^2 <= r^2
+    const double diffX = x - start.X();
+    const double diffZ = z - start.Z();
+    const double radiusSq = cutter.radius * cutter.radius;
+
+    const double distSq = diffX*diffX + diffZ*diffZ;
+    const double a = static_cast<double>(dirX)*dirX + static_cast<double>(dirZ)*dirZ;
+
+    if (a == 0.) {
+        if (distSq > radiusSq)
+            return std::nullopt;
+
+        return std::make_pair(0., 1.);
+    }
+
+    const double halfB = -(dirX*diffX + dirZ*diffZ);
+    const double c = distSq - radiusSq;
+
+    const double delta = halfB*halfB - a*c;
+    if (delta < 0.)
+        return std::nullopt;
+
+    const double deltaSqrt = std::sqrt(delta);
+    const double t1 = std::max((-halfB - deltaSqrt) / a, 0.);
+    const double t2 = std::min((-halfB + deltaSqrt) / a, 1.);
+
+    if (t1 > t2)
+        return std::nullopt;
+
+    return std::make_pair(t1, t2);
+}
+
+
+float SweptCutter::FlatLowestPoint(const float x, const float z) const
+{
+    const auto range = CoveringRange(x, z);
+    if (!range)
+        return infinity;
+
+    // Height changes linearly, so the lowest point is at one of the ends of the range
+    const auto [t1, t2] = *range;
+    const double dirY = static_cast<double>(end.Y()) - start.Y();
+    return static_cast<float>(std::min(start.Y() + t1*dirY, start.Y() + t2*dirY));
+}
+
+
+float SweptCutter::RoundLowestPoint(const float x, const float z) const
+{
+    // Swept ball is a capsule between the balls centers. The lowest point is the first hit of the vertical
+    // line with the capsule, which is the lowest hit with the cylinder or one of the end spheres.
+    const double radius = cutter.radius;
+    const double radiusSq = radius * radius;
+
+    double result = infinity;
+
+    auto sphereHit = [&] (const alg::Vec3& tip) {
+        const double diffX = x - tip.X();
+        const double diffZ = z - tip.Z();
+        const double distSq = diffX*diffX + diffZ*diffZ;
+
+        if (distSq <= radiusSq)
+            result = std::min(result, tip.Y() + radius - std::sqrt(radiusSq - distSq));
+    };
+
+    sphereHit(start);
+    sphereHit(end);
+
+    // Vertical line starting at the level of the first ball center
+    const double axisX = dirX;
+    const double axisY = static_cast<double>(end.Y()) - start.Y();
+    const double axisZ = dirZ;
+
+    const double diffX = x - start.X();
+    const double diffZ = z - start.Z();
+
+    const double axisLenSq = axisX*axisX + axisY*axisY + axisZ*axisZ;
+    const double horizontalLenSq = axisX*axisX + axisZ*axisZ;
+    const double axisDotDiff = axisX*diffX + axisZ*diffZ;
+
+    if (horizontalLenSq > 0.) {
+        const double a = horizontalLenSq;
+        const double halfB = -axisDotDiff * axisY;
+        const double c = axisLenSq * (diffX*diffX + diffZ*diffZ) - axisDotDiff*axisDotDiff - radiusSq*axisLenSq;
+
+        const double delta = halfB*halfB - a*c;
+        if (delta >= 0.) {
+            const double s = (-halfB - std::sqrt(delta)) / a;
+            const double alongAxis = axisDotDiff + s*axisY;
+
+            if (alongAxis >= 0. && alongAxis <= axisLenSq)
+                result = std::min(result, start.Y() + radius + s);
+        }
+    }
+
+    return static_cast<float>(result);
+}
+
+
+float SweptCutter::ProfileLowestPoint(const float x, const float z) const
+{
+    const auto range = CoveringRange(x, z);
+    if (!range)
+        return infinity;
+
+    const CutterProfile& profile = cutter.Profile();
+    const double radiusSq = cutter.radius * cutter.radius;
+    const double dirY = static_cast<double>(end.Y()) - start.Y();
+
+    // Distance from the axis is convex in t and the profile is convex and non-decreasing,
+    // so the bottom height over the point is a convex function of t with a single minimum
+    auto heightAt = [&] (const double t) {
+        const double diffX = x - (start.X() + t*dirX);
+        const double diffZ = z - (start.Z() + t*dirZ);
+        const double distSq = std::min(diffX*diffX + diffZ*diffZ, radiusSq);
+
+        return start.Y() + t*dirY + profile.HeightAt(static_cast<float>(distSq));
+    };
+
+    auto [t1, t2] = *range;
+
+    // Without the height change the lowest point is over the closest point of the move
+    if (dirY == 0.) {
+        const double a = static_cast<double>(dirX)*dirX + static_cast<double>(dirZ)*dirZ;
+        const double closest = a == 0. ? t1 : ((x - start.X())*dirX + (z - start.Z())*dirZ) / a;
+
+        return static_cast<float>(heightAt(std::clamp(closest, t1, t2)));
+    }
+
+    constexpr double invPhi = 0.6180339887498949;
+    constexpr int maxIterations = 60;
+
+    // Search ends, when the range is far below the pixel size
+    const double horizontalLen = std::sqrt(static_cast<double>(dirX)*dirX + static_cast<double>(dirZ)*dirZ);
+    const double tolerance = horizontalLen > 0. ? 1e-6 / horizontalLen : 1.;
+
+    double result = std::min(heightAt(t1), heightAt(t2));
+
+    // Golden-section search
+    double m1 = t2 - invPhi*(t2 - t1);
+    double m2 = t1 + invPhi*(t2 - t1);
+    double h1 = heightAt(m1);
+    double h2 = heightAt(m2);
+
+    for (int i = 0; i < maxIterations && t2 - t1 > tolerance; ++i) {
+        if (h1 < h2) {
+            t2 = m2;
+            m2 = m1;
+            h2 = h1;
+            m1 = t2 - invPhi*(t2 - t1);
+            h1 = heightAt(m1);
+        }
+        else {
+            t1 = m1;
+            m1 = m2;
+            h1 = h2;
+            m2 = t1 + invPhi*(t2 - t1);
+            h2 = heightAt(m2);
+        }
+    }
+
+    result = std::min({ result, h1, h2 });
+
+    return static_cast<float>(result);
+}
@@ -0,0 +1,57 @@
+#include <CAD_modeler/model/millingMachineSim/targetHeights.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+
+TargetHeights::TargetHeights(const int xResolution, const int zResolution, const float xLen, const float zLen, const float height):
+    xResolution(xResolution), zResolution(zResolution), xLen(xLen), zLen(zLen)
+{
+    if (xResolution <= 0 || zResolution <= 0)
+        throw std::invalid_argument("Resolution has to be positive");
+
+    heights.assign(static_cast<size_t>(xResolution) * zResolution, height);
+}
+
+
+void TargetHeights::Save(const std::string &filePath) const
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    const Header header {
+        .magic = magic,
+        .version = version,
+        .xResolution = xResolution,
+        .zResolution = zResolution,
+        .xLen = xLen,
+        .zLen = zLen
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(heights.data()), static_cast<std::streamsize>(heights.size() * sizeof(float)));
+}
+
+
+TargetHeights TargetHeights::Load(const std::string &filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(Header)))
+        throw std::invalid_argument("Invalid target heights file");
+
+    if (header.magic != magic || header.version != version || header.xResolution <= 0 || header.zResolution <= 0)
+        throw std::invalid_argument("Invalid target heights file");
+
+    TargetHeights target(header.xResolution, header.zResolution, header.xLen, header.zLen);
+
+    const auto bytes = static_cast<std::streamsize>(target.heights.size() * sizeof(float));
+    if (!file.read(reinterpret_cast<char*>(target.heights.data()), bytes))
+        throw std::invalid_argument("Truncated target heights file");
+
+    return target;
+}
@@ -0,0 +1,106 @@
+#include <CAD_modeler/model/millingMachineSim/tiledMiller.hpp>
+
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+
+TiledMiller::TiledMiller(const int tileSize, const unsigned int threadsCnt):
+    tileSize(tileSize), threadsCnt(std::max(threadsCnt, 1u))
+{
+}
+
+
+std::vector<MillingResult> TiledMiller::Mill(
+    MaterialHeightMap &heightMap,
+    const MillingCutter &cutter,
+    const std::vector<MillingSection> &sections,
+    const std::stop_token &stoken,
+    MilledTiles* milledTiles
+) const {
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    const int tilesX = (heightMap.XResolution() + tileSize - 1) / tileSize;
+    const int tilesZ = (heightMap.ZResolution() + tileSize - 1) / tileSize;
+
+    // Binning sections to the tiles. Sections are visited in order, so every tile gets them in the paths order.
+    std::vector<std::vector<int>> tilesSections(tilesX * tilesZ);
+    std::vector<PixelRect> footprints(sections.size());
+
+    // Height map tiles are allocated on the first write. If a height map tile can be shared by two milling tiles,
+    // the height map tiles, which might be written, are allocated up front, so that threads do not race allocating them.
+    const bool sharedHeightMapTiles = tileSize % MaterialHeightMap::tileSize != 0 && threadsCnt > 1;
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const auto& footprint = footprints[i] = SectionFootprint(heightMap, stamp, sections[i].start, sections[i].end);
+        if (footprint.Empty())
+            continue;
+
+        // Cutter moving above the highest material in its footprint cannot remove anything
+        const float lowestY = std::min(sections[i].start.Y(), sections[i].end.Y());
+        if (lowestY >= heightMap.MaxHeight(footprint))
+            continue;
+
+        if (sharedHeightMapTiles && lowestY < heightMap.FillHeight())
+            heightMap.Materialize(footprint);
+
+        for (int tileZ = footprint.minZ / tileSize; tileZ <= (footprint.maxZ - 1) / tileSize; ++tileZ) {
+            for (int tileX = footprint.minX / tileSize; tileX <= (footprint.maxX - 1) / tileSize; ++tileX)
+                tilesSections[tileZ*tilesX + tileX].push_back(static_cast<int>(i));
+        }
+    }
+
+    // The most loaded tiles are taken first, so that no thread is left with a big tile at the end
+    std::vector<int> tilesOrder(tilesSections.size());
+    std::iota(tilesOrder.begin(), tilesOrder.end(), 0);
+    std::erase_if(tilesOrder, [&tilesSections](const int tile) { return tilesSections[tile].empty(); });
+    std::ranges::stable_sort(tilesOrder, [&tilesSections](const int t1, const int t2) {
+        return tilesSections[t1].size() > tilesSections[t2].size();
+    });
+
+    const unsigned int workersCnt = ParallelWorkersCnt(tilesOrder.size(), threadsCnt);
+    std::vector<std::vector<MillingResult>> workersResults(workersCnt, std::vector<MillingResult>(sections.size()));
+
+    ParallelFor(tilesOrder.size(), threadsCnt, [&] (const size_t orderIdx, const unsigned int workerIdx) {
+        const int tile = tilesOrder[orderIdx];
+        const int tileX = tile % tilesX;
+        const int tileZ = tile / tilesX;
+
+        const PixelRect clip {
+            .minX = tileX * tileSize,
+            .minZ = tileZ * tileSize,
+            .maxX = (tileX + 1) * tileSize,
+            .maxZ = (tileZ + 1) * tileSize
+        };
+
+        for (const int section : tilesSections[tile]) {
+            if (stoken.stop_requested())
+                return;
+
+            workersResults[workerIdx][section] |= MillPathSection(
+                heightMap, cutter, stamp, sections[section].start, sections[section].end, clip
+            );
+        }
+
+        if (milledTiles != nullptr)
+            milledTiles->Publish(tile);
+    });
+
+    std::vector<MillingResult> results(sections.size());
+    for (const auto& workerResults : workersResults) {
+        for (size_t i = 0; i < results.size(); ++i)
+            results[i] |= workerResults[i];
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].materialRemoved)
+            heightMap.MarkChanged(footprints[i]);
+    }
+
+    heightMap.RefreshHeightRanges();
+
+    return results;
+}
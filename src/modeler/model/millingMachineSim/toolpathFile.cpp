@@ -0,0 +1,143 @@
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+// Commands are read directly from the file memory, so their layout has to match the records
+static_assert(std::is_standard_layout_v<MoveCommand> && std::is_trivially_destructible_v<MoveCommand>);
+static_assert(sizeof(MoveCommand) == sizeof(std::int32_t) + 3*sizeof(float));
+static_assert(offsetof(MoveCommand, destination) == sizeof(std::int32_t));
+static_assert(alignof(MoveCommand) == alignof(float));
+static_assert(sizeof(CutterProfile::Point) == 2*sizeof(float));
+
+
+void ToolpathFile::Save(const std::string &filePath, const MillingMachinePath &path, const MillingCutter &cutter)
+{
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file");
+
+    const auto commands = path.Commands();
+    const CutterProfile& profile = cutter.Profile();
+
+    const Header header {
+        .magic = magic,
+        .version = version,
+        .cutterType = static_cast<std::uint32_t>(cutter.type),
+        .cutterRadius = cutter.radius,
+        .cutterHeight = cutter.height,
+        .reserved = 0,
+        .commandsCnt = commands.size()
+    };
+
+    const ProfileHeader profileHeader {
+        .secondaryRadius = profile.SecondaryRadius(),
+        .halfAngle = profile.HalfAngle(),
+        .pointsCnt = static_cast<std::uint32_t>(profile.Points().size()),
+        .reserved = 0
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(&profileHeader), sizeof(ProfileHeader));
+    file.write(
+        reinterpret_cast<const char*>(profile.Points().data()),
+        static_cast<std::streamsize>(profile.Points().size() * sizeof(CutterProfile::Point))
+    );
+    file.write(reinterpret_cast<const char*>(commands.data()), static_cast<std::streamsize>(commands.size_bytes()));
+}
+
+
+ToolpathFile::Toolpath ToolpathFile::Load(const std::string &filePath)
+{
+    auto mappedFile = std::make_shared<const MappedFile>(filePath);
+
+    if (mappedFile->Size() < sizeof(Header))
+        throw std::invalid_argument("Invalid toolpath file");
+
+    Header header;
+    std::memcpy(&header, mappedFile->Data(), sizeof(Header));
+
+    if (header.magic != magic || header.version < 1 || header.version > version)
+        throw std::invalid_argument("Invalid toolpath file");
+
+    // First version stored only round and flat cutters, without the profile parameters
+    ProfileHeader profileHeader { .secondaryRadius = 0.f, .halfAngle = 0.f, .pointsCnt = 0, .reserved = 0 };
+    size_t commandsOffset = sizeof(Header);
+
+    if (header.version > 1) {
+        if (mappedFile->Size() < sizeof(Header) + sizeof(ProfileHeader))
+            throw std::invalid_argument("Truncated toolpath file");
+
+        std::memcpy(&profileHeader, mappedFile->Data() + sizeof(Header), sizeof(ProfileHeader));
+        commandsOffset += sizeof(ProfileHeader);
+
+        if (profileHeader.pointsCnt > (mappedFile->Size() - commandsOffset) / sizeof(CutterProfile::Point))
+            throw std::invalid_argument("Truncated toolpath file");
+
+        commandsOffset += profileHeader.pointsCnt * sizeof(CutterProfile::Point);
+    }
+
+    if (header.commandsCnt > (mappedFile->Size() - commandsOffset) / sizeof(MoveCommand))
+        throw std::invalid_argument("Truncated toolpath file");
+
+    const CutterProfile profile = ReadProfile(
+        header, profileHeader, mappedFile->Data() + sizeof(Header) + sizeof(ProfileHeader)
+    );
+
+    const auto commands = reinterpret_cast<const MoveCommand*>(mappedFile->Data() + commandsOffset);
+
+    MillingMachinePath path(std::move(mappedFile), std::span(commands, static_cast<size_t>(header.commandsCnt)));
+
+    return {
+        .path = std::move(path),
+        .cutter = MillingCutter(profile, header.cutterHeight)
+    };
+}
+
+
+CutterProfile ToolpathFile::ReadProfile(const Header &header, const ProfileHeader &profileHeader, const std::byte *points)
+{
+    // Invalid parameters are rejected by the profile factories
+    switch (header.cutterType) {
+        case static_cast<std::uint32_t>(MillingCutter::Type::Round):
+            return CutterProfile::Round(header.cutterRadius);
+
+        case static_cast<std::uint32_t>(MillingCutter::Type::Flat):
+            return CutterProfile::Flat(header.cutterRadius);
+
+        case static_cast<std::uint32_t>(MillingCutter::Type::BullNose):
+            if (header.version > 1)
+                return CutterProfile::BullNose(header.cutterRadius, profileHeader.secondaryRadius);
+            break;
+
+        case static_cast<std::uint32_t>(MillingCutter::Type::Tapered):
+            if (header.version > 1)
+                return CutterProfile::Tapered(header.cutterRadius, profileHeader.secondaryRadius, profileHeader.halfAngle);
+            break;
+
+        case static_cast<std::uint32_t>(MillingCutter::Type::Table):
+            if (header.version > 1) {
+                std::vector<CutterProfile::Point> profilePoints(profileHeader.pointsCnt);
+                std::memcpy(profilePoints.data(), points, profilePoints.size() * sizeof(CutterProfile::Point));
+                return CutterProfile::Table(profilePoints);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    throw std::invalid_argument("Invalid toolpath file");
+}
+
+
+bool ToolpathFile::HasToolpathExtension(const std::string &filePath)
+{
+    return std::filesystem::path(filePath).extension() == extension;
+}
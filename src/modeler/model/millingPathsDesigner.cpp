@@ -5,20 +5,44 @@
 #include <CAD_modeler/model/components/registerComponents.hpp>
 #include <CAD_modeler/model/components/drawStd.hpp>
 
-#include <CAD_modeler/model/millingPathsDesigner/depthBuffer.hpp>
+#include <CAD_modeler/model/millingPathsDesigner/heightMapRasterizer.hpp>
+#include <CAD_modeler/model/millingPathsDesigner/cutterOffsetHeightMap.hpp>
 #include <CAD_modeler/model/millingPathsDesigner/millingMachinePathsBuilder.hpp>
 #include <CAD_modeler/model/millingPathsDesigner/boundaryIntersectionFinder.hpp>
 
 #include <CAD_modeler/model/systems/selectionSystem.hpp>
-#include <CAD_modeler/model/systems/c0PatchesTrianglesRenderSystem.hpp>
-#include <CAD_modeler/model/systems/c2PatchesTrianglesRenderingSystem.hpp>
 #include <CAD_modeler/model/systems/controlPointsRegistrySystem.hpp>
 #include <CAD_modeler/model/systems/millingMachinePathsSystem.hpp>
 #include <CAD_modeler/model/systems/equidistanceC2SurfaceSystem.hpp>
+#include <CAD_modeler/model/systems/intersectionSystem/c0Surface.hpp>
+#include <CAD_modeler/model/systems/intersectionSystem/c2Surface.hpp>
+
+#include <CAD_modeler/model/millingMachineSim/targetHeights.hpp>
 
 #include <CAD_modeler/utilities/lineSegment2D.hpp>
 
 #include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    /// @brief Area enclosed by the closed contour, projected onto the base plane
+    float EnclosedAreaXZ(const interSys::SliceContour& contour)
+    {
+        const auto& points = contour.points;
+        float doubledArea = 0.f;
+
+        for (size_t i = 0; i < points.size(); ++i) {
+            const auto& p1 = points[i];
+            const auto& p2 = points[(i + 1) % points.size()];
+
+            doubledArea += p1.X() * p2.Z() - p2.X() * p1.Z();
+        }
+
+        return std::abs(doubledArea) / 2.f;
+    }
+}
 
 
 MillingPathsDesigner::MillingPathsDesigner(const int viewportWidth, const int viewportHeight):
@@ -31,10 +55,8 @@ MillingPathsDesigner::MillingPathsDesigner(const int viewportWidth, const int vi
     PointsSystem::RegisterSystem(coordinator);
     C0PatchesSystem::RegisterSystem(coordinator);
     C0PatchesRenderSystem::RegisterSystem(coordinator);
-    C0PatchesTrianglesRenderSystem::RegisterSystem(coordinator);
     C2PatchesSystem::RegisterSystem(coordinator);
     C2PatchesRenderSystem::RegisterSystem(coordinator);
-    C2PatchesTrianglesRenderSystem::RegisterSystem(coordinator);
     NameSystem::RegisterSystem(coordinator);
     SelectionSystem::RegisterSystem(coordinator);
     EquidistanceC2System::RegisterSystem(coordinator);
@@ -54,6 +76,7 @@ MillingPathsDesigner::MillingPathsDesigner(const int viewportWidth, const int vi
     const auto equidistanceSurfaceSys = coordinator.GetSystem<EquidistanceC2System>();
     intersectionSystem = coordinator.GetSystem<IntersectionSystem>();
     interpolationCurvesRendering = coordinator.GetSystem<InterpolationCurvesRenderingSystem>();
+    intersectionPolylinesRendering = coordinator.GetSystem<IntersectionPolylinesRenderingSystem>();
     polylineSystem = coordinator.GetSystem<PolylineSystem>();
 
     gridSystem->Init();
@@ -149,6 +172,13 @@ void MillingPathsDesigner::GenerateBroadPhase()
     const int stepsInXDir = static_cast<int>(std::ceil((maxXCutterPos - minXCutterPos) / stepLenInXDir));
     const int stepsInZDir = static_cast<int>(std::ceil((maxZCutterPos - minZCutterPos) / heightMap.PixelXLen()));
 
+    // Both passes go along the same rows, the default height changes between them, so it is applied at the lookup
+    std::vector<float> passesXs(stepsInXDir + 1);
+    for (int stepX=0; stepX < stepsInXDir+1; stepX++)
+        passesXs[stepX] = minXCutterPos + static_cast<float>(stepX) * stepLenInXDir;
+
+    const CutterOffsetHeightMap offsets(heightMap, cutter, passesXs);
+
     for (int stepX=0; stepX < stepsInXDir+1; stepX++) {
         const float actCutterMiddleX = minXCutterPos + static_cast<float>(stepX) * stepLenInXDir;
 
@@ -160,7 +190,7 @@ void MillingPathsDesigner::GenerateBroadPhase()
             else
                 actCutterMiddleZ = maxZCutterPos - static_cast<float>(stepZ) * heightMap.PixelZLen();
 
-            const float minCutterY = MinYCutterPos(heightMap, cutter, actCutterMiddleX, actCutterMiddleZ);
+            const float minCutterY = MinYCutterPos(heightMap, offsets, actCutterMiddleX, actCutterMiddleZ);
 
             Position newCutterPos(actCutterMiddleX, minCutterY, actCutterMiddleZ);
             builder.AddPosition(newCutterPos);
@@ -187,7 +217,7 @@ void MillingPathsDesigner::GenerateBroadPhase()
             else
                 actCutterMiddleZ = maxZCutterPos - static_cast<float>(stepZ) * heightMap.PixelZLen();
 
-            const float minCutterY = MinYCutterPos(heightMap, cutter, actCutterMiddleX, actCutterMiddleZ);
+            const float minCutterY = MinYCutterPos(heightMap, offsets, actCutterMiddleX, actCutterMiddleZ);
 
             Position newCutterPos(actCutterMiddleX, minCutterY, actCutterMiddleZ);
             builder.AddPosition(newCutterPos);
@@ -203,7 +233,9 @@ void MillingPathsDesigner::GenerateBroadPhase()
 
     builder.AddPosition(millingSettings.initCutterPos);
 
-    MillingMachinePathsSystem::CreateGCodeFile(builder.GetPaths(), "paths/1.k16");
+    const auto paths = builder.GetPaths();
+    MillingMachinePathsSystem::CreateToolpathFile(paths, cutter, "paths/1.ctp");
+    MillingMachinePathsSystem::CreateGCodeFile(paths, "paths/1.k16");
 }
 
 
@@ -335,6 +367,7 @@ void MillingPathsDesigner::GenerateBasePhase()
 
     polylineSystem->AddPolyline(pathsPositions);
 
+    MillingMachinePathsSystem::CreateToolpathFile(paths, cutter, "paths/2.ctp");
     MillingMachinePathsSystem::CreateGCodeFile(paths, "paths/2.f10");
 }
 
@@ -361,12 +394,6 @@ void MillingPathsDesigner::GenerateMainPhase()
     const Entity lewe_oko = nameSystem->EntityFromName("lewe_oko");
     const Entity lewe_okoOffset = equidistanceC2System->AddSurface(lewe_oko, -cutter.radius);
 
-    const Entity baseOffset = c0PatchesSystem->CreatePlane(
-        alg::Vec3(-materialParameters.xLen/2.f, millingSettings.baseThickness + cutter.radius, -materialParameters.zLen/2.f),
-        alg::Vec3::UnitY(),
-        materialParameters.xLen, materialParameters.zLen
-    );
-
     intersectionSystem->FindIntersection(pletwa_prawaOffset, torsoOffset, 1e-3);
     intersectionSystem->FindIntersection(pletwa_lewaOffset, torsoOffset, 1e-3);
     //intersectionSystem->FindIntersection(pletwa_gornaOffset, torsoOffset, 1e-3);
@@ -374,9 +401,15 @@ void MillingPathsDesigner::GenerateMainPhase()
     intersectionSystem->FindIntersection(prawe_okoOffset, torsoOffset, 1e-3);
     intersectionSystem->FindIntersection(lewe_okoOffset, torsoOffset, 1e-3);
 
-    intersectionSystem->FindIntersection(baseOffset, torsoOffset, 1e-3);
-    intersectionSystem->FindIntersection(pletwa_prawaOffset, baseOffset, 1e-3);
-    intersectionSystem->FindIntersection(pletwa_lewaOffset, baseOffset, 1e-3);
+    // Offsets are sliced with the plane of the cutter center above the base, instead of tracing their intersections with a plane surface
+    const alg::Vec3 baseOffsetPoint(0.f, millingSettings.baseThickness + cutter.radius, 0.f);
+
+    for (const Entity offset : { torsoOffset, pletwa_prawaOffset, pletwa_lewaOffset }) {
+        for (const auto& contour : intersectionSystem->Slice(offset, baseOffsetPoint, alg::Vec3::UnitY(), { 0.f })) {
+            const std::vector<Position> positions(contour.points.begin(), contour.points.end());
+            polylineSystem->AddPolyline(positions);
+        }
+    }
 }
 
 
@@ -388,118 +421,74 @@ void MillingPathsDesigner::RenderSystemsObjects(
     c0PatchesRenderSystem->Render(cameraMtx);
     c2PatchesRenderSystem->Render(cameraMtx);
     interpolationCurvesRendering->Render(cameraMtx);
+    intersectionPolylinesRendering->Render(cameraMtx);
     polylineSystem->Render(cameraMtx);
 
     gridSystem->Render(viewMtx, persMtx, nearPlane, farPlane);
 }
 
 
-// TODO: remove
-#include <CAD_modeler/utilities/toPGM.hpp>
-
-
 BroadPhaseHeightMap MillingPathsDesigner::GenerateBroadPhaseHeightMap()
 {
-    constexpr int depthBufferResolution = 300;
-    const DepthBuffer depthBuffer(depthBufferResolution, depthBufferResolution);
+    auto heightMap = RenderModelHeightMap(millingSettings.heightMapResolution, millingSettings.heightMapResolution);
 
-    auto const& c0Renderer = coordinator.GetSystem<C0PatchesTrianglesRenderSystem>();
-    auto const& c2Renderer = coordinator.GetSystem<C2PatchesTrianglesRenderSystem>();
+    std::ranges::for_each(heightMap, [this](float& d) {
+        d += this->millingSettings.broadPhaseAdditionalThickness;
+    });
 
-    for (const auto entity: c0PatchesSystem->GetEntities()) {
-        if (entity == base) {
-            c0Renderer->AddSurface(entity, 1.f);
-            continue;
-        }
+    return heightMap;
+}
 
-        c0Renderer->AddSurface(entity);
-    }
 
-    for (const auto entity: c2PatchesSystem->GetEntities())
-        c2Renderer->AddSurface(entity);
+void MillingPathsDesigner::ExportTargetHeights(const std::string &filePath, const int xResolution, const int zResolution)
+{
+    const auto heightMap = RenderModelHeightMap(xResolution, zResolution);
 
-    depthBuffer.Use();
+    TargetHeights target(xResolution, zResolution, materialParameters.xLen, materialParameters.zLen);
 
-    auto [oldViewportWidth, oldViewportHeight] = GetViewportSize();
-    ChangeViewportSize(depthBufferResolution, depthBufferResolution);
+    for (int z = 0; z < zResolution; ++z) {
+        for (int x = 0; x < xResolution; ++x)
+            target.SetHeightAt(x, z, heightMap.Height(x, z));
+    }
 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    target.Save(filePath);
+}
 
-    // glDrawBuffer(GL_NONE);
-    // glReadBuffer(GL_NONE);
-    glDepthMask(GL_TRUE);
 
-    const alg::Vec3 camPos(0.f, materialParameters.yLen, 0.f);
+BroadPhaseHeightMap MillingPathsDesigner::RenderModelHeightMap(const int xResolution, const int zResolution) const
+{
+    // Same density, as the one of the surfaces rendered with the maximal tessellation level
+    constexpr int segmentsPerPatch = 64;
 
-    const alg::Mat4x4 viewMatrix = alg::LookAt(camPos, alg::Vec3::UnitY(), alg::Vec3::UnitX());
-    const alg::Mat4x4 projectionMtx = alg::OrthographicProjection(
-        -materialParameters.xLen/2.0f,
-        materialParameters.xLen/2.0f,
-        materialParameters.zLen/2.0f,
-        -materialParameters.zLen/2.0f,
-        0.f,
-        materialParameters.yLen
-    );
+    HeightMapRasterizer rasterizer;
 
-    const alg::Mat4x4 camMtx = projectionMtx * viewMatrix;
+    for (const auto entity: c0PatchesSystem->GetEntities()) {
+        interSys::C0Surface surface(coordinator, entity);
+        rasterizer.AddSurface(surface, entity == base ? 1 : segmentsPerPatch);
+    }
 
-    c0Renderer->Render(camMtx);
-    c2Renderer->Render(camMtx);
+    for (const auto entity: c2PatchesSystem->GetEntities()) {
+        interSys::C2Surface surface(coordinator, entity);
+        rasterizer.AddSurface(surface, segmentsPerPatch);
+    }
 
     BroadPhaseHeightMap heightMap(
-        depthBufferResolution,
-        depthBufferResolution,
+        xResolution,
+        zResolution,
         materialParameters.xLen,
         materialParameters.zLen
     );
-    glReadPixels(0, 0, depthBufferResolution, depthBufferResolution, GL_DEPTH_COMPONENT, GL_FLOAT, heightMap.Data());
-
-    float near = 0.f;
-    float far = materialParameters.yLen;
-    std::ranges::for_each(heightMap, [near, far](float& d) {
-        d = far - ((2.0f * d - 1.0f) * (far - near) + (far + near)) * 0.5f;
-    });
-
-    std::ranges::for_each(heightMap, [this](float& d) {
-        d += this->millingSettings.broadPhaseAdditionalThickness;
-    });
-
-    ToPGM(heightMap.ToFlatVec2D(), "depth.pgm");
-
-    DepthBuffer::UseDefault();
-    ChangeViewportSize(oldViewportWidth, oldViewportHeight);
-
-    // glDrawBuffer(GL_BACK);
-    // glReadBuffer(GL_BACK);
-    glDepthMask(GL_FALSE);
+    rasterizer.Render(heightMap);
 
     return heightMap;
 }
 
 
 float MillingPathsDesigner::MinYCutterPos(
-    const BroadPhaseHeightMap &heightMap, const MillingCutter &cutter, const float cutterX, const float cutterZ) const
+    const BroadPhaseHeightMap &heightMap, const CutterOffsetHeightMap &offsets, const float cutterX, const float cutterZ) const
 {
-    const int cutterXLenInPixels = static_cast<int>(std::ceil(cutter.radius / heightMap.PixelXLen() * 2.f));
-    const int cutterZLenInPixels = static_cast<int>(std::ceil(cutter.radius / heightMap.PixelZLen() * 2.f));
-
-    float maxCutterYCoord = -std::numeric_limits<float>::infinity();
-    for (int sampleX=0; sampleX < cutterXLenInPixels; sampleX++) {
-        for (int sampleZ=0; sampleZ < cutterZLenInPixels; sampleZ++) {
-            const float sampleXPos = cutterX - cutter.radius + static_cast<float>(sampleX) * heightMap.PixelXLen();
-            const float sampleZPos = cutterZ - cutter.radius + static_cast<float>(sampleZ) * heightMap.PixelZLen();
-
-            const float sampleYPos = heightMap.HeightFromGlobalCoordinates(sampleXPos, sampleZPos);
-
-            Position samplePos(sampleXPos, sampleYPos, sampleZPos);
-
-            const float cutterY = cutter.CalcMinYCoord(cutterX, cutterZ, samplePos);
-            if (cutterY > maxCutterYCoord)
-                maxCutterYCoord = cutterY;
-        }
-    }
-
-    return maxCutterYCoord;
+    // Outside of the height map pixels the cutter is limited only by the default height
+    return std::max(offsets.MinCutterY(cutterX, cutterZ), heightMap.defaultHeight);
 }
 
 
@@ -723,28 +712,37 @@ std::vector<Position> MillingPathsDesigner::FindBoundary(float dist)
 
 CircularVector<Position> MillingPathsDesigner::BoundaryPoints(const Entity entity, const float dist)
 {
-    const auto intersectionEntity = intersectionSystem->FindIntersection(entity, base, 1e-3);
-    if (!intersectionEntity.has_value())
+    constexpr int slicingSamples = 400;
+
+    const alg::Vec3 basePoint(0.f, millingSettings.baseThickness, 0.f);
+    const auto contours = intersectionSystem->Slice(entity, basePoint, alg::Vec3::UnitY(), { 0.f }, slicingSamples);
+    if (contours.empty())
         throw std::runtime_error("No intersection found with base");
 
-    auto const& c2Patches = coordinator.GetComponent<C2Patches>(entity);
-    auto const& curve = coordinator.GetComponent<IntersectionCurve>(intersectionEntity.value());
+    // Boundary encloses the whole section of the surface, parts of it touching the base only slightly
+    // produce small or open contours, which are skipped
+    const auto contour = std::ranges::max_element(contours, {}, [](const interSys::SliceContour& c) {
+        return c.isOpen ? -1.f : EnclosedAreaXZ(c);
+    });
+
+    if (contour->isOpen)
+        throw std::runtime_error("No closed intersection found with base");
 
-    std::vector<Position> result(curve.Size());
+    auto const& c2Patches = coordinator.GetComponent<C2Patches>(entity);
 
-    for (size_t i=0; i < curve.Size(); ++i)
-        result[i] = BoundaryPoint(curve[i], c2Patches, dist);
+    std::vector<Position> result(contour->parameters.size());
 
-    coordinator.DestroyEntity(intersectionEntity.value());
+    for (size_t i=0; i < contour->parameters.size(); ++i)
+        result[i] = BoundaryPoint(contour->parameters[i], c2Patches, dist);
 
     return CircularVector(std::move(result));
 }
 
 
-Position MillingPathsDesigner::BoundaryPoint(const IntersectionPoint &p, const C2Patches& patches, const float dist) const
+Position MillingPathsDesigner::BoundaryPoint(const alg::Vec2 &params, const C2Patches& patches, const float dist) const
 {
-    const float u = p.U1();
-    const float v = p.V1();
+    const float u = params.X();
+    const float v = params.Y();
 
     const alg::Vec3 normal = c2PatchesSystem->NormalVector(patches, u, v);
     const alg::Vec3 normalProjection = alg::Vec3::UnitZ() * Dot(normal, alg::Vec3::UnitZ()) + alg::Vec3::UnitX() * Dot(normal, alg::Vec3::UnitX());
@@ -0,0 +1,254 @@
+#include <CAD_modeler/model/millingPathsDesigner/cutterOffsetHeightMap.hpp>
+
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+    constexpr float minusInfinity = -std::numeric_limits<float>::infinity();
+
+
+    /// @brief Source, which is the highest one in the upper envelope from the start pixel
+    class EnvelopePart {
+    public:
+        int source;
+        int start;
+    };
+
+
+    /// @brief Buffers reused by the rows dilations of a single thread
+    class RowBuffers {
+    public:
+        std::vector<float> extended;
+        std::vector<float> prefixMax;
+        std::vector<float> suffixMax;
+        std::vector<EnvelopePart> envelope;
+        std::vector<float> dilated;
+    };
+
+
+    /// @brief Van Herk/Gil-Werman max filter. The output is longer by the padding on both sides
+    /// and out[j] is the maximum of src[i] for |i + padding - j| <= halfWidth.
+    void MaxFilter(const std::span<const float> src, const int halfWidth, const int padding, const std::span<float> out, RowBuffers& buffers)
+    {
+        // Window of out[j] covers extended[j] to extended[j + 2*halfWidth]
+        const int window = 2 * halfWidth + 1;
+        const int extendedLen = static_cast<int>(out.size()) + 2 * halfWidth;
+
+        auto& extended = buffers.extended;
+        extended.assign(extendedLen, minusInfinity);
+        std::ranges::copy(src, extended.begin() + padding + halfWidth);
+
+        // Maxima from the block start and to the block end, the window is the suffix of one block and the prefix of the next one
+        auto& prefixMax = buffers.prefixMax;
+        auto& suffixMax = buffers.suffixMax;
+        prefixMax.resize(extendedLen);
+        suffixMax.resize(extendedLen);
+
+        for (int e = 0; e < extendedLen; ++e)
+            prefixMax[e] = e % window == 0 ? extended[e] : std::max(prefixMax[e - 1], extended[e]);
+
+        for (int e = extendedLen - 1; e >= 0; --e)
+            suffixMax[e] = e % window == window - 1 || e == extendedLen - 1 ? extended[e] : std::max(suffixMax[e + 1], extended[e]);
+
+        for (size_t j = 0; j < out.size(); ++j)
+            out[j] = std::max(suffixMax[j], prefixMax[j + 2 * halfWidth]);
+    }
+
+
+    /// @brief Dilation by the concave kernel given for distances from 0 to its half width. The output is longer
+    /// by the padding on both sides and out[j] is the maximum of src[i] + kernel[|i + padding - j|].
+    /// Kernels translated to different pixels cross at most once, so their upper envelope is built in a single pass.
+    void ConcaveDilation(
+        const std::span<const float> src, const std::span<const float> kernel, const int padding, const std::span<float> out, RowBuffers& buffers
+    ) {
+        const int halfWidth = static_cast<int>(kernel.size()) - 1;
+
+        auto value = [&] (const int source, const int j) {
+            const int dist = std::abs(j - source - padding);
+            return dist <= halfWidth ? src[source] + kernel[dist] : minusInfinity;
+        };
+
+        auto& envelope = buffers.envelope;
+        envelope.clear();
+
+        for (int source = 0; source < static_cast<int>(src.size()); ++source) {
+            const int first = source + padding - halfWidth;
+            int start = first;
+
+            while (!envelope.empty()) {
+                const EnvelopePart& top = envelope.back();
+
+                // First pixel, from which the source is not lower than the top of the envelope,
+                // the top kernel ends before the last checked pixel
+                int low = first;
+                int high = std::max(first, top.source + padding + halfWidth + 1);
+
+                while (low < high) {
+                    const int mid = low + (high - low) / 2;
+
+                    if (value(source, mid) >= value(top.source, mid))
+                        high = mid;
+                    else
+                        low = mid + 1;
+                }
+
+                start = low;
+
+                if (start > top.start)
+                    break;
+
+                envelope.pop_back();
+                start = first;
+            }
+
+            // Source lower than the envelope in its whole kernel is never the highest one
+            if (start <= source + padding + halfWidth)
+                envelope.push_back({ .source = source, .start = start });
+        }
+
+        size_t part = 0;
+        for (int j = 0; j < static_cast<int>(out.size()); ++j) {
+            while (part + 1 < envelope.size() && envelope[part + 1].start <= j)
+                ++part;
+
+            out[j] = envelope.empty() || envelope[part].start > j ? minusInfinity : value(envelope[part].source, j);
+        }
+    }
+}
+
+
+CutterOffsetHeightMap::CutterOffsetHeightMap(
+    const BroadPhaseHeightMap &heightMap, const MillingCutter &cutter, const std::span<const float> cutterXs, const unsigned int threadsCnt
+):
+    minX(heightMap.MinX()),
+    minZ(heightMap.MinZ()),
+    pixelXLen(heightMap.PixelXLen()),
+    pixelZLen(heightMap.PixelZLen()),
+    paddingX(static_cast<int>(cutter.radius / pixelXLen)),
+    paddingZ(static_cast<int>(cutter.radius / pixelZLen)),
+    offsets(0, 0)
+{
+    const float radiusSq = cutter.radius * cutter.radius;
+
+    auto distSq = [this] (const int dx, const int dz) {
+        const float distX = static_cast<float>(dx) * pixelXLen;
+        const float distZ = static_cast<float>(dz) * pixelZLen;
+
+        return distX*distX + distZ*distZ;
+    };
+
+    // Pixels of the footprint rows, which the rounding of the division might have skipped or added
+    while (distSq(paddingX + 1, 0) <= radiusSq)
+        ++paddingX;
+    while (paddingX > 0 && distSq(paddingX, 0) > radiusSq)
+        --paddingX;
+    while (distSq(0, paddingZ + 1) <= radiusSq)
+        ++paddingZ;
+    while (paddingZ > 0 && distSq(0, paddingZ) > radiusSq)
+        --paddingZ;
+
+    const auto extendedRowsCnt = static_cast<int>(heightMap.XResolution()) + 2 * paddingX;
+    rowsIndices.assign(extendedRowsCnt, -1);
+
+    std::vector<int> rows;
+    for (const float x : cutterXs) {
+        const int row = PixelX(x) + paddingX;
+
+        if (row >= 0 && row < extendedRowsCnt && rowsIndices[row] < 0) {
+            rowsIndices[row] = static_cast<int>(rows.size());
+            rows.push_back(row);
+        }
+    }
+
+    offsets = FlatVec2D(rows.size(), heightMap.ZResolution() + 2 * paddingZ, minusInfinity);
+
+    // Footprint rows, kernels are the cutter bottom heights below its tip
+    std::vector<int> halfWidths(paddingX + 1);
+    std::vector<std::vector<float>> kernels(paddingX + 1);
+
+    for (int dx = 0; dx <= paddingX; ++dx) {
+        int halfWidth = paddingZ;
+        while (halfWidth > 0 && distSq(dx, halfWidth) > radiusSq)
+            --halfWidth;
+
+        halfWidths[dx] = halfWidth;
+
+        for (int dz = 0; dz <= halfWidth; ++dz)
+            kernels[dx].push_back(-cutter.Profile().HeightAt(distSq(dx, dz)));
+    }
+
+    const bool flat = cutter.type == MillingCutter::Type::Flat;
+
+    const int xResolution = static_cast<int>(heightMap.XResolution());
+    const auto zResolution = heightMap.ZResolution();
+    const float* heights = heightMap.ToFlatVec2D().Data();
+
+    const unsigned int workersCnt = ParallelWorkersCnt(rows.size(), threadsCnt);
+    std::vector<RowBuffers> workersBuffers(workersCnt);
+
+    ParallelFor(rows.size(), threadsCnt, [&] (const size_t i, const unsigned int workerIdx) {
+        RowBuffers& buffers = workersBuffers[workerIdx];
+        buffers.dilated.resize(offsets.Cols());
+
+        const std::span out(&offsets.At(i, 0), offsets.Cols());
+
+        for (int dx = -paddingX; dx <= paddingX; ++dx) {
+            const int sourceRow = rows[i] - paddingX + dx;
+            if (sourceRow < 0 || sourceRow >= xResolution)
+                continue;
+
+            const std::span src(heights + static_cast<size_t>(sourceRow) * zResolution, zResolution);
+            const int absDx = std::abs(dx);
+
+            if (flat)
+                MaxFilter(src, halfWidths[absDx], paddingZ, buffers.dilated, buffers);
+            else
+                ConcaveDilation(src, kernels[absDx], paddingZ, buffers.dilated, buffers);
+
+            for (size_t j = 0; j < out.size(); ++j)
+                out[j] = std::max(out[j], buffers.dilated[j]);
+        }
+    });
+}
+
+
+float CutterOffsetHeightMap::MinCutterY(const float x, const float z) const
+{
+    // Same rounding, as in the height map
+    const float firstCenterZ = minZ + pixelZLen / 2.f;
+    const auto pixelZ = static_cast<int>(std::round((z - firstCenterZ) / pixelZLen));
+
+    return At(PixelX(x), pixelZ);
+}
+
+
+float CutterOffsetHeightMap::At(const int x, const int z) const
+{
+    const int row = x + paddingX;
+    const int col = z + paddingZ;
+
+    if (row < 0 || row >= static_cast<int>(rowsIndices.size()) || col < 0 || col >= static_cast<int>(offsets.Cols()))
+        return minusInfinity;
+
+    if (rowsIndices[row] < 0)
+        throw std::invalid_argument("Row of the cutter offsets was not computed");
+
+    return offsets.At(rowsIndices[row], col);
+}
+
+
+int CutterOffsetHeightMap::PixelX(const float x) const
+{
+    // Same rounding, as in the height map
+    const float firstCenterX = minX + pixelXLen / 2.f;
+    return static_cast<int>(std::round((x - firstCenterX) / pixelXLen));
+}
@@ -0,0 +1,183 @@
+#include <CAD_modeler/model/millingPathsDesigner/heightMapRasterizer.hpp>
+
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+HeightMapRasterizer::HeightMapRasterizer(const unsigned int threadsCnt, const int tileSize):
+    threadsCnt(std::max(threadsCnt, 1u)), tileSize(tileSize)
+{
+    if (tileSize <= 0)
+        throw std::invalid_argument("Tile size has to be positive");
+}
+
+
+void HeightMapRasterizer::AddSurface(interSys::Surface &surface, const int segmentsPerUnit)
+{
+    if (segmentsPerUnit <= 0)
+        throw std::invalid_argument("Number of segments has to be positive");
+
+    const float minU = surface.MinUSampleVal();
+    const float minV = surface.MinVSampleVal();
+    const float maxU = surface.MaxUSampleVal();
+    const float maxV = surface.MaxVSampleVal();
+
+    const int segmentsU = std::max(static_cast<int>(std::ceil((maxU - minU) * static_cast<float>(segmentsPerUnit))), 1);
+    const int segmentsV = std::max(static_cast<int>(std::ceil((maxV - minV) * static_cast<float>(segmentsPerUnit))), 1);
+
+    const int nodesU = segmentsU + 1;
+    const int nodesV = segmentsV + 1;
+
+    const auto firstVertex = static_cast<std::uint32_t>(vertices.size());
+    vertices.resize(vertices.size() + static_cast<size_t>(nodesU) * nodesV);
+
+    // Last nodes are evaluated exactly at the domain end, which the patches systems accept
+    ParallelFor(nodesU, threadsCnt, [&] (const size_t i) {
+        const float u = i + 1 == static_cast<size_t>(nodesU) ?
+            maxU : minU + static_cast<float>(i) * (maxU - minU) / static_cast<float>(segmentsU);
+
+        for (int j = 0; j < nodesV; ++j) {
+            const float v = j + 1 == nodesV ?
+                maxV : minV + static_cast<float>(j) * (maxV - minV) / static_cast<float>(segmentsV);
+
+            vertices[firstVertex + i * nodesV + j] = surface.PointOnSurface(u, v);
+        }
+    });
+
+    triangles.reserve(triangles.size() + 2 * static_cast<size_t>(segmentsU) * segmentsV);
+
+    for (int i = 0; i < segmentsU; ++i) {
+        for (int j = 0; j < segmentsV; ++j) {
+            const std::uint32_t v00 = firstVertex + i * nodesV + j;
+            const std::uint32_t v01 = v00 + 1;
+            const std::uint32_t v10 = v00 + nodesV;
+            const std::uint32_t v11 = v10 + 1;
+
+            triangles.push_back({ v00, v10, v11 });
+            triangles.push_back({ v00, v11, v01 });
+        }
+    }
+}
+
+
+void HeightMapRasterizer::Render(BroadPhaseHeightMap &heightMap) const
+{
+    const auto xResolution = static_cast<int>(heightMap.XResolution());
+    const auto zResolution = static_cast<int>(heightMap.ZResolution());
+
+    if (xResolution == 0 || zResolution == 0 || triangles.empty())
+        return;
+
+    // Pixel coordinates, in which the pixels centers have integer coordinates
+    const float pixelXLen = heightMap.PixelXLen();
+    const float pixelZLen = heightMap.PixelZLen();
+    const float minX = heightMap.MinX();
+    const float minZ = heightMap.MinZ();
+
+    std::vector<std::array<float, 2>> pixelVertices(vertices.size());
+    std::ranges::transform(vertices, pixelVertices.begin(), [&] (const alg::Vec3& vertex) {
+        return std::array { (vertex.X() - minX) / pixelXLen - 0.5f, (vertex.Z() - minZ) / pixelZLen - 0.5f };
+    });
+
+    class PixelBox {
+    public:
+        int minX, maxX, minZ, maxZ;
+    };
+
+    auto pixelBox = [&] (const std::array<std::uint32_t, 3>& triangle) {
+        const auto& a = pixelVertices[triangle[0]];
+        const auto& b = pixelVertices[triangle[1]];
+        const auto& c = pixelVertices[triangle[2]];
+
+        return PixelBox {
+            .minX = std::max(static_cast<int>(std::ceil(std::min({ a[0], b[0], c[0] }))), 0),
+            .maxX = std::min(static_cast<int>(std::floor(std::max({ a[0], b[0], c[0] }))), xResolution - 1),
+            .minZ = std::max(static_cast<int>(std::ceil(std::min({ a[1], b[1], c[1] }))), 0),
+            .maxZ = std::min(static_cast<int>(std::floor(std::max({ a[1], b[1], c[1] }))), zResolution - 1)
+        };
+    };
+
+    const int tilesX = (xResolution + tileSize - 1) / tileSize;
+    const int tilesZ = (zResolution + tileSize - 1) / tileSize;
+    const size_t tilesCnt = static_cast<size_t>(tilesX) * tilesZ;
+
+    // Triangles are binned to the tiles they overlap, each part of them into its own bins
+    const size_t partsCnt = std::min<size_t>(threadsCnt, triangles.size());
+    const size_t partLen = (triangles.size() + partsCnt - 1) / partsCnt;
+    std::vector<std::vector<std::vector<std::uint32_t>>> bins(partsCnt, std::vector<std::vector<std::uint32_t>>(tilesCnt));
+
+    ParallelFor(partsCnt, threadsCnt, [&] (const size_t part) {
+        const size_t end = std::min((part + 1) * partLen, triangles.size());
+
+        for (size_t triangle = part * partLen; triangle < end; ++triangle) {
+            const PixelBox box = pixelBox(triangles[triangle]);
+            if (box.minX > box.maxX || box.minZ > box.maxZ)
+                continue;
+
+            for (int tileX = box.minX / tileSize; tileX <= box.maxX / tileSize; ++tileX) {
+                for (int tileZ = box.minZ / tileSize; tileZ <= box.maxZ / tileSize; ++tileZ)
+                    bins[part][tileX * tilesZ + tileZ].push_back(static_cast<std::uint32_t>(triangle));
+            }
+        }
+    });
+
+    float* heights = heightMap.Data();
+
+    ParallelFor(tilesCnt, threadsCnt, [&] (const size_t tile) {
+        const int tileMinX = static_cast<int>(tile / tilesZ) * tileSize;
+        const int tileMinZ = static_cast<int>(tile % tilesZ) * tileSize;
+        const int tileMaxX = std::min(tileMinX + tileSize, xResolution) - 1;
+        const int tileMaxZ = std::min(tileMinZ + tileSize, zResolution) - 1;
+
+        for (const auto& partBins : bins) {
+            for (const std::uint32_t triangle : partBins[tile]) {
+                const auto& indices = triangles[triangle];
+
+                const auto& a = pixelVertices[indices[0]];
+                const auto& b = pixelVertices[indices[1]];
+                const auto& c = pixelVertices[indices[2]];
+
+                // Triangles seen edge-on do not cover any pixel
+                const float area = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+                if (area == 0.f)
+                    continue;
+
+                const float ya = vertices[indices[0]].Y();
+                const float yb = vertices[indices[1]].Y();
+                const float yc = vertices[indices[2]].Y();
+
+                // Edge functions are positive inside the triangle regardless of its orientation
+                const float sign = area > 0.f ? 1.f : -1.f;
+                const float invArea = 1.f / std::abs(area);
+
+                auto edge = [sign] (const std::array<float, 2>& p1, const std::array<float, 2>& p2, const float x, const float z) {
+                    return sign * ((p2[0] - p1[0]) * (z - p1[1]) - (p2[1] - p1[1]) * (x - p1[0]));
+                };
+
+                const PixelBox box = pixelBox(indices);
+
+                for (int x = std::max(box.minX, tileMinX); x <= std::min(box.maxX, tileMaxX); ++x) {
+                    const auto fx = static_cast<float>(x);
+                    float* row = heights + static_cast<size_t>(x) * zResolution;
+
+                    for (int z = std::max(box.minZ, tileMinZ); z <= std::min(box.maxZ, tileMaxZ); ++z) {
+                        const auto fz = static_cast<float>(z);
+
+                        const float wa = edge(b, c, fx, fz);
+                        const float wb = edge(c, a, fx, fz);
+                        const float wc = edge(a, b, fx, fz);
+
+                        if (wa < 0.f || wb < 0.f || wc < 0.f)
+                            continue;
+
+                        const float y = (wa * ya + wb * yb + wc * yc) * invArea;
+                        row[z] = std::max(row[z], y);
+                    }
+                }
+            }
+        }
+    });
+}
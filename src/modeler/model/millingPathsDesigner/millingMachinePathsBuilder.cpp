@@ -3,26 +3,28 @@
 
 void MillingMachinePathsBuilder::AddPosition(const Position &nextPosition)
 {
-    path.commands.emplace_back(nextID++, nextPosition);
+    path.AddCommand(nextID++, nextPosition);
     return;
 
-    if (path.commands.empty()) {
-        path.commands.emplace_back(nextID++, nextPosition);
+    const auto commands = path.Commands();
+
+    if (commands.empty()) {
+        path.AddCommand(nextID++, nextPosition);
         return;
     }
 
-    auto commandsCnt = path.commands.size();
-    const auto& lastPos = path.commands[commandsCnt - 1].destination;
+    auto commandsCnt = commands.size();
+    const auto& lastPos = commands[commandsCnt - 1].destination;
 
     if (lastPos.vec == nextPosition.vec)
         return;
 
     if (commandsCnt == 1) {
-        path.commands.emplace_back(nextID++, nextPosition);
+        path.AddCommand(nextID++, nextPosition);
         return;
     }
 
-    const auto& secondToLast = path.commands[commandsCnt-2].destination;
+    const auto& secondToLast = commands[commandsCnt-2].destination;
 
     const alg::Vec3 a = lastPos.vec - secondToLast.vec;
     const alg::Vec3 b = nextPosition.vec - secondToLast.vec;
@@ -31,17 +33,20 @@ void MillingMachinePathsBuilder::AddPosition(const Position &nextPosition)
     const alg::Vec3 bNorm = b.Normalize();
 
     if (alg::Cross(aNorm, bNorm).LengthSquared() <= 1e-5f && alg::Dot(aNorm, bNorm) > 0.f && b.LengthSquared() > a.LengthSquared()) {
-        path.commands.back().destination = nextPosition;
+        const int lastID = commands.back().id;
+
+        path.RemoveLastCommand();
+        path.AddCommand(lastID, nextPosition);
         return;
     }
 
-    path.commands.emplace_back(nextID++, nextPosition);
+    path.AddCommand(nextID++, nextPosition);
 }
 
 void MillingMachinePathsBuilder::AddPositionFromOffset(const alg::Vec3 &offset)
 {
-    const auto& lastCommand = path.commands.back();
+    const auto& lastCommand = path.Commands().back();
     auto newPos = lastCommand.destination.vec + offset;
 
-    path.commands.emplace_back(nextID++, newPos);
+    path.AddCommand(nextID++, newPos);
 }
@@ -61,6 +61,7 @@ Modeler::Modeler(const int viewportWidth, const int viewportHeight):
     c0CurveSystem = coordinator.GetSystem<C0CurveSystem>();
     c2CurveSystem = coordinator.GetSystem<C2CurveSystem>();
     interpolationRenderingSystem = coordinator.GetSystem<InterpolationCurvesRenderingSystem>();
+    intersectionPolylinesRenderingSystem = coordinator.GetSystem<IntersectionPolylinesRenderingSystem>();
 
     c0PatchesSystem = coordinator.GetSystem<C0PatchesSystem>();
     c0PatchesRenderSystem = coordinator.GetSystem<C0PatchesRenderSystem>();
@@ -509,18 +510,20 @@ std::optional<Entity> Modeler::FindSelfIntersection(const Entity e,const float s
 
 Entity Modeler::TurnIntersectionCurveToInterpolation(const Entity curve)
 {
-    const auto& oldCps = coordinator.GetComponent<CurveControlPoints>(curve);
+    const auto& polyline = coordinator.GetComponent<IntersectionPolyline>(curve);
     std::vector<Entity> newCps;
-    newCps.reserve(oldCps.Size());
+    newCps.reserve(polyline.Size() + 1);
 
-    for (const auto oldCp: oldCps.GetPoints()) {
-        const auto& pos = coordinator.GetComponent<Position>(oldCp);
-        Entity newCp = pointsSystem->CreatePoint(pos);
+    for (const auto& point: polyline.points) {
+        Entity newCp = pointsSystem->CreatePoint(point);
 
         newCps.push_back(newCp);
         nameSystem->SetName(newCp, nameGenerator.GenerateName("Point_"));
     }
 
+    if (!polyline.isOpen && !newCps.empty())
+        newCps.push_back(newCps.front());
+
     coordinator.DestroyEntity(curve);
 
     const Entity newCurve = coordinator.GetSystem<InterpolationCurveSystem>()->CreateCurve(newCps);
@@ -818,6 +821,7 @@ void Modeler::RenderSystemsObjects(
     c0CurveSystem->Render(cameraMtx);
     c2CurveSystem->Render(cameraMtx);
     interpolationRenderingSystem->Render(cameraMtx);
+    intersectionPolylinesRenderingSystem->Render(cameraMtx);
 
     c0PatchesRenderSystem->Render(cameraMtx);
     trimmedC0PatchesRenderSystem->Render(cameraMtx);
@@ -0,0 +1,92 @@
+#include <CAD_modeler/model/systems/intersectionPolylinesRenderingSystem.hpp>
+
+#include <ecs/coordinator.hpp>
+
+#include <CAD_modeler/model/components/mesh.hpp>
+#include <CAD_modeler/model/systems/selectionSystem.hpp>
+#include <CAD_modeler/model/systems/shaders/shaderRepository.hpp>
+
+#include <numeric>
+
+
+void IntersectionPolylinesRenderingSystem::RegisterSystem(Coordinator &coordinator)
+{
+    coordinator.RegisterSystem<IntersectionPolylinesRenderingSystem>();
+
+    coordinator.RegisterComponent<IntersectionPolyline>();
+}
+
+
+void IntersectionPolylinesRenderingSystem::AddPolyline(const Entity entity)
+{
+    const auto& polyline = coordinator->GetComponent<IntersectionPolyline>(entity);
+
+    Mesh mesh;
+
+    mesh.Update(
+        GenerateMeshVertices(polyline),
+        GenerateMeshIndices(polyline)
+    );
+
+    coordinator->AddComponent<Mesh>(entity, mesh);
+
+    entities.insert(entity);
+}
+
+
+void IntersectionPolylinesRenderingSystem::Render(const alg::Mat4x4 &cameraMtx) const
+{
+    if (entities.empty())
+        return;
+
+    auto const& selectionSystem = coordinator->GetSystem<SelectionSystem>();
+    auto const& shader = ShaderRepository::GetInstance().GetStdShader();
+
+    shader.Use();
+    shader.SetColor(alg::Vec4(1.0f));
+    shader.SetMVP(cameraMtx);
+
+    for (const Entity entity : entities) {
+        const bool selection = selectionSystem->IsSelected(entity);
+
+        if (selection)
+            shader.SetColor(alg::Vec4(1.0f, 0.5f, 0.0f, 1.0f));
+
+        auto const& mesh = coordinator->GetComponent<Mesh>(entity);
+        mesh.Use();
+
+        glDrawElements(GL_LINE_STRIP, mesh.GetElementsCnt(), GL_UNSIGNED_INT, nullptr);
+
+        if (selection)
+            shader.SetColor(alg::Vec4(1.0f));
+    }
+}
+
+
+std::vector<float> IntersectionPolylinesRenderingSystem::GenerateMeshVertices(const IntersectionPolyline &polyline) const
+{
+    std::vector<float> result;
+    result.reserve(polyline.Size() * alg::Vec3::dim);
+
+    for (const alg::Vec3& point : polyline.points) {
+        result.push_back(point.X());
+        result.push_back(point.Y());
+        result.push_back(point.Z());
+    }
+
+    return result;
+}
+
+
+std::vector<uint32_t> IntersectionPolylinesRenderingSystem::GenerateMeshIndices(const IntersectionPolyline &polyline) const
+{
+    std::vector<uint32_t> result(polyline.Size());
+
+    std::iota(result.begin(), result.end(), 0);
+
+    // Closed curves go back to the first point
+    if (!polyline.isOpen && !result.empty())
+        result.push_back(0);
+
+    return result;
+}
@@ -0,0 +1,83 @@
+#include <CAD_modeler/model/systems/intersectionSystem/intersectionsCache.hpp>
+
+#include <CAD_modeler/utilities/hashCombine.hpp>
+
+#include <functional>
+
+
+using namespace interSys;
+
+
+const IntersectionsCache::Entry* IntersectionsCache::Find(const Key &key) const
+{
+    const auto it = entries.find(key);
+    if (it == entries.end())
+        return nullptr;
+
+    return &it->second;
+}
+
+
+void IntersectionsCache::Insert(const Key &key, Entry entry)
+{
+    entries.insert_or_assign(key, std::move(entry));
+}
+
+
+void IntersectionsCache::Invalidate(const Entity surface)
+{
+    std::erase_if(entries, [surface](const auto& entry) {
+        const Key& key = entry.first;
+        return key.surface1 == surface || key.surface2 == surface;
+    });
+}
+
+
+void IntersectionsCache::UpdateSurfaceHash(const Entity surface, const size_t hash)
+{
+    const auto it = surfacesHashes.find(surface);
+
+    if (it == surfacesHashes.end()) {
+        surfacesHashes.emplace(surface, hash);
+        return;
+    }
+
+    if (it->second == hash)
+        return;
+
+    Invalidate(surface);
+    it->second = hash;
+}
+
+
+void IntersectionsCache::RemoveSurface(const Entity surface)
+{
+    Invalidate(surface);
+    surfacesHashes.erase(surface);
+}
+
+
+void IntersectionsCache::Clear()
+{
+    entries.clear();
+}
+
+
+size_t IntersectionsCache::KeyHash::operator()(const Key &key) const
+{
+    size_t result = stdh::hashCombine(key.surface1, key.surface2);
+    result = stdh::hashCombine(result, key.surface1Hash);
+    result = stdh::hashCombine(result, key.surface2Hash);
+    result = stdh::hashCombine(result, std::hash<float>()(key.step));
+    result = stdh::hashCombine(result, std::hash<bool>()(key.selfIntersection));
+
+    if (key.guidance.has_value()) {
+        const auto& guidance = key.guidance.value();
+
+        result = stdh::hashCombine(result, std::hash<float>()(guidance.X()));
+        result = stdh::hashCombine(result, std::hash<float>()(guidance.Y()));
+        result = stdh::hashCombine(result, std::hash<float>()(guidance.Z()));
+    }
+
+    return result;
+}
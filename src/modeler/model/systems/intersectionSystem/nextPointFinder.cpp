@@ -71,8 +71,10 @@ private:
 };
 
 
-NextPointFinder::NextPointFinder(Surface &s1, Surface &s2, const IntersectionPoint &firstPoint, const float step):
-    surface1(s1), surface2(s2), actTangent(Tangent(firstPoint)), actPoint(firstPoint), step(step)
+NextPointFinder::NextPointFinder(
+    Surface &s1, Surface &s2, const IntersectionPoint &firstPoint, const float step, SolversTelemetry* telemetry
+):
+    surface1(s1), surface2(s2), actTangent(Tangent(firstPoint)), actPoint(firstPoint), step(step), telemetry(telemetry)
 {
 }
 
@@ -96,7 +98,11 @@ bool NextPointFinder::FindNext()
             actStep
         );
 
-        std::optional<alg::Vec4> nextPoint = NewtonMethod(fun, actPoint.AsVector(), 1e-5);
+        root::SolverStats stats;
+        std::optional<alg::Vec4> nextPoint = NewtonMethod(fun, actPoint.AsVector(), 1e-5, stats);
+        if (telemetry != nullptr)
+            telemetry->Record(stats);
+
         if (!nextPoint.has_value()) {
             actStep /= 2.f;
             if (actStep < minStep)
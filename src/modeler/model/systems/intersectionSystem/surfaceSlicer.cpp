@@ -0,0 +1,239 @@
+#include <CAD_modeler/model/systems/intersectionSystem/surfaceSlicer.hpp>
+
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+
+
+using namespace interSys;
+
+
+SurfaceSlicer::SurfaceSlicer(Surface &surface, const int samplesU, const int samplesV):
+    surface(surface),
+    wrapU(std::isinf(surface.MinU())),
+    wrapV(std::isinf(surface.MinV())),
+    cellsU(samplesU),
+    cellsV(samplesV),
+    minU(surface.MinUSampleVal()),
+    minV(surface.MinVSampleVal()),
+    deltaU((surface.MaxUSampleVal() - surface.MinUSampleVal()) / static_cast<float>(samplesU)),
+    deltaV((surface.MaxVSampleVal() - surface.MinVSampleVal()) / static_cast<float>(samplesV)),
+    points(NodesU(), NodesV())
+{
+    for (int i = 0; i < NodesU(); ++i) {
+        const float u = minU + static_cast<float>(i) * deltaU;
+
+        for (int j = 0; j < NodesV(); ++j) {
+            const float v = minV + static_cast<float>(j) * deltaV;
+
+            points.At(i, j) = surface.PointOnSurface(u, v);
+        }
+    }
+}
+
+
+std::vector<SliceContour> SurfaceSlicer::Slice(const alg::Vec3 &planePoint, const alg::Vec3 &normal, const std::vector<float> &levels)
+{
+    FlatVec2D<float> field(NodesU(), NodesV());
+
+    for (int i = 0; i < NodesU(); ++i) {
+        for (int j = 0; j < NodesV(); ++j) {
+            field.At(i, j) = Dot(points.At(i, j) - planePoint, normal);
+        }
+    }
+
+    std::vector<SliceContour> result;
+
+    for (const float level : levels) {
+        auto contours = Contours(field, level, planePoint, normal);
+        result.insert(result.end(), std::make_move_iterator(contours.begin()), std::make_move_iterator(contours.end()));
+    }
+
+    return result;
+}
+
+
+std::vector<SliceContour> SurfaceSlicer::Contours(
+    const FlatVec2D<float> &field, const float level, const alg::Vec3 &planePoint, const alg::Vec3 &normal
+) {
+    // Segments of the contour, each one joins two crossed grid edges
+    std::vector<std::pair<int, int>> segments;
+    std::unordered_map<int, std::vector<size_t>> edgeSegments;
+
+    auto addSegment = [&segments, &edgeSegments](const int e1, const int e2) {
+        edgeSegments[e1].push_back(segments.size());
+        edgeSegments[e2].push_back(segments.size());
+        segments.emplace_back(e1, e2);
+    };
+
+    for (int i = 0; i < cellsU; ++i) {
+        const int nextI = (i + 1) % NodesU();
+
+        for (int j = 0; j < cellsV; ++j) {
+            const int nextJ = (j + 1) % NodesV();
+
+            const float f0 = field.At(i, j) - level;
+            const float f1 = field.At(nextI, j) - level;
+            const float f2 = field.At(nextI, nextJ) - level;
+            const float f3 = field.At(i, nextJ) - level;
+
+            const bool s0 = f0 > 0.f;
+            const bool s1 = f1 > 0.f;
+            const bool s2 = f2 > 0.f;
+            const bool s3 = f3 > 0.f;
+
+            const int e0 = EdgeU(i, j);
+            const int e1 = EdgeV(nextI, j);
+            const int e2 = EdgeU(i, nextJ);
+            const int e3 = EdgeV(i, j);
+
+            std::vector<int> crossed;
+            if (s0 != s1) crossed.push_back(e0);
+            if (s1 != s2) crossed.push_back(e1);
+            if (s2 != s3) crossed.push_back(e2);
+            if (s3 != s0) crossed.push_back(e3);
+
+            if (crossed.size() == 2) {
+                addSegment(crossed[0], crossed[1]);
+                continue;
+            }
+
+            if (crossed.size() == 4) {
+                // Saddle point, value in the middle of the cell decides which corners are joined
+                const bool center = (f0 + f1 + f2 + f3) / 4.f > 0.f;
+
+                if (center == s0) {
+                    addSegment(e0, e1);
+                    addSegment(e2, e3);
+                }
+                else {
+                    addSegment(e0, e3);
+                    addSegment(e1, e2);
+                }
+            }
+        }
+    }
+
+    std::unordered_map<int, alg::Vec2> crossings;
+    auto crossing = [&](const int edge) {
+        auto it = crossings.find(edge);
+        if (it == crossings.end())
+            it = crossings.emplace(edge, EdgeCrossing(edge, field, level, planePoint, normal)).first;
+
+        return it->second;
+    };
+
+    std::vector<bool> used(segments.size(), false);
+
+    // Finds not used segment joined with the given one by the edge
+    auto nextSegment = [&](const int edge) -> std::optional<size_t> {
+        for (const size_t seg : edgeSegments.at(edge)) {
+            if (!used[seg])
+                return seg;
+        }
+
+        return std::nullopt;
+    };
+
+    std::vector<SliceContour> result;
+
+    for (size_t start = 0; start < segments.size(); ++start) {
+        if (used[start])
+            continue;
+
+        used[start] = true;
+        std::deque<int> edges { segments[start].first, segments[start].second };
+
+        while (const auto seg = nextSegment(edges.back())) {
+            used[*seg] = true;
+            const auto [e1, e2] = segments[*seg];
+            edges.push_back(e1 == edges.back() ? e2 : e1);
+        }
+
+        const bool isOpen = edges.front() != edges.back();
+
+        if (isOpen) {
+            while (const auto seg = nextSegment(edges.front())) {
+                used[*seg] = true;
+                const auto [e1, e2] = segments[*seg];
+                edges.push_front(e1 == edges.front() ? e2 : e1);
+            }
+        }
+        else {
+            edges.pop_back();
+        }
+
+        SliceContour contour {
+            .level = level,
+            .isOpen = isOpen,
+            .parameters = {},
+            .points = {}
+        };
+
+        contour.parameters.reserve(edges.size());
+        contour.points.reserve(edges.size());
+
+        for (const int edge : edges) {
+            const alg::Vec2 params = crossing(edge);
+
+            contour.parameters.push_back(params);
+            contour.points.push_back(surface.PointOnSurface(params.X(), params.Y()));
+        }
+
+        result.push_back(std::move(contour));
+    }
+
+    return result;
+}
+
+
+alg::Vec2 SurfaceSlicer::EdgeCrossing(
+    const int edge, const FlatVec2D<float> &field, const float level, const alg::Vec3 &planePoint, const alg::Vec3 &normal
+) {
+    constexpr int maxNewtonIter = 4;
+    constexpr float eps = 1e-6f;
+
+    const bool alongU = edge % 2 == 0;
+    const int idx = edge / 2;
+
+    const int i = alongU ? idx % cellsU : idx / cellsV;
+    const int j = alongU ? idx / cellsU : idx % cellsV;
+
+    const float f1 = field.At(i, j) - level;
+    const float f2 = alongU ? field.At((i + 1) % NodesU(), j) - level : field.At(i, (j + 1) % NodesV()) - level;
+
+    // Linear approximation is a starting point for the Newton method, which is done
+    // only along the edge, so the problem is one-dimensional
+    const float t = f1 / (f1 - f2);
+
+    const float startU = minU + static_cast<float>(i) * deltaU;
+    const float startV = minV + static_cast<float>(j) * deltaV;
+
+    const float edgeStart = alongU ? startU : startV;
+    const float edgeLen = alongU ? deltaU : deltaV;
+
+    float u = alongU ? startU + t * deltaU : startU;
+    float v = alongU ? startV : startV + t * deltaV;
+    float& param = alongU ? u : v;
+
+    for (int iter = 0; iter < maxNewtonIter; ++iter) {
+        const float value = Dot(surface.PointOnSurface(u, v) - planePoint, normal) - level;
+        if (std::abs(value) < eps)
+            break;
+
+        const alg::Vec3 derivative = alongU ? surface.PartialDerivativeU(u, v) : surface.PartialDerivativeV(u, v);
+        const float slope = Dot(derivative, normal);
+        if (std::abs(slope) < std::numeric_limits<float>::epsilon())
+            break;
+
+        const float newParam = param - value / slope;
+        if (newParam < edgeStart || newParam > edgeStart + edgeLen)
+            break;
+
+        param = newParam;
+    }
+
+    return { u, v };
+}
@@ -4,7 +4,7 @@
 #include <CAD_modeler/model/systems/c2PatchesSystem.hpp>
 #include <CAD_modeler/model/systems/toriSystem.hpp>
 #include <CAD_modeler/model/systems/equidistanceC2SurfaceSystem.hpp>
-#include <CAD_modeler/model/systems/interpolationCurvesRenderingSystem.hpp>
+#include <CAD_modeler/model/systems/intersectionPolylinesRenderingSystem.hpp>
 
 #include <CAD_modeler/model/systems/intersectionSystem/torusSurface.hpp>
 #include <CAD_modeler/model/systems/intersectionSystem/c0Surface.hpp>
@@ -13,6 +13,15 @@
 #include <CAD_modeler/model/systems/intersectionSystem/domainChecks.hpp>
 #include <CAD_modeler/model/systems/intersectionSystem/equidistanceSurface.hpp>
 
+#include <CAD_modeler/model/components/c0Patches.hpp>
+#include <CAD_modeler/model/components/c2Patches.hpp>
+#include <CAD_modeler/model/components/torusParameters.hpp>
+#include <CAD_modeler/model/components/equidistantSurfaceParameters.hpp>
+#include <CAD_modeler/model/components/rotation.hpp>
+#include <CAD_modeler/model/components/scale.hpp>
+
+#include <CAD_modeler/utilities/hashCombine.hpp>
+
 #include <ecs/coordinator.hpp>
 
 #include <optimization/conjugateGradientMethod.hpp>
@@ -22,6 +31,7 @@
 #include <algebra/vec2.hpp>
 
 #include <cassert>
+#include <functional>
 
 // TODO: remove
 #include <iostream>
@@ -33,7 +43,7 @@ using namespace interSys;
 void IntersectionSystem::RegisterSystem(Coordinator &coordinator)
 {
     coordinator.RegisterSystem<IntersectionSystem>();
-    coordinator.RegisterSystem<InterpolationCurvesRenderingSystem>();
+    IntersectionPolylinesRenderingSystem::RegisterSystem(coordinator);
 
     coordinator.RegisterComponent<IntersectionCurve>();
 }
@@ -61,6 +71,9 @@ bool IntersectionSystem::CanBeIntersected(const Entity entity) const
 
 std::optional<Entity> IntersectionSystem::FindIntersection(const Entity e1, const Entity e2, const float step)
 {
+    telemetry = SolversTelemetry();
+    cacheKey = std::nullopt;
+
     if (e1 == e2)
         return FindSelfIntersection(e1, step);
 
@@ -70,6 +83,12 @@ std::optional<Entity> IntersectionSystem::FindIntersection(const Entity e1, cons
     const auto surface1 = GetSurface(e1);
     const auto surface2 = GetSurface(e2);
 
+    const auto key = CacheKey(e1, e2, step, std::nullopt);
+    if (const auto entry = cache.Find(key))
+        return CreateCurve(*surface1, *surface2, entry->points, entry->isOpen);
+
+    cacheKey = key;
+
     const auto firstApprox = FindFirstApproximation(*surface1, *surface2);
     const auto firstPointOpt = FindFirstIntersectionPoint(*surface1, *surface2, firstApprox);
 
@@ -84,6 +103,9 @@ std::optional<Entity> IntersectionSystem::FindIntersection(const Entity e1, cons
 
 std::optional<Entity> IntersectionSystem::FindIntersection(const Entity e1, const Entity e2, const float step, const Position &guidance)
 {
+    telemetry = SolversTelemetry();
+    cacheKey = std::nullopt;
+
     if (e1 == e2)
         return FindSelfIntersection(e1, step, guidance);
 
@@ -93,6 +115,12 @@ std::optional<Entity> IntersectionSystem::FindIntersection(const Entity e1, cons
     const auto surface1 = GetSurface(e1);
     const auto surface2 = GetSurface(e2);
 
+    const auto key = CacheKey(e1, e2, step, guidance.vec);
+    if (const auto entry = cache.Find(key))
+        return CreateCurve(*surface1, *surface2, entry->points, entry->isOpen);
+
+    cacheKey = key;
+
     auto [initU, initV] = NearestPointApproximation(*surface1, guidance);
     const auto nearestPoint1 = NearestPoint(*surface1, guidance, initU, initV);
 
@@ -127,10 +155,19 @@ bool CheckInitialPointSelfIntersection(const IntersectionPoint& p) {
 
 std::optional<Entity> IntersectionSystem::FindSelfIntersection(const Entity e, const float step)
 {
+    telemetry = SolversTelemetry();
+    cacheKey = std::nullopt;
+
     assert(CanBeIntersected(e));
 
     const auto surface = GetSurface(e);
 
+    const auto key = CacheKey(e, e, step, std::nullopt);
+    if (const auto entry = cache.Find(key))
+        return CreateCurve(*surface, *surface, entry->points, entry->isOpen);
+
+    cacheKey = key;
+
     const auto firstApprox = FindFirstApproximationForSelfIntersection(*surface);
     const auto firstPointOpt = FindFirstIntersectionPoint(*surface, *surface, firstApprox);
 
@@ -145,10 +182,19 @@ std::optional<Entity> IntersectionSystem::FindSelfIntersection(const Entity e, c
 
 std::optional<Entity> IntersectionSystem::FindSelfIntersection(const Entity e, const float step, const Position &guidance)
 {
+    telemetry = SolversTelemetry();
+    cacheKey = std::nullopt;
+
     assert(CanBeIntersected(e));
 
     const auto surface = GetSurface(e);
 
+    const auto key = CacheKey(e, e, step, guidance.vec);
+    if (const auto entry = cache.Find(key))
+        return CreateCurve(*surface, *surface, entry->points, entry->isOpen);
+
+    cacheKey = key;
+
     auto [initU, initV] = NearestPointApproximation(*surface, guidance);
     const auto nearestPoint1 = NearestPoint(*surface, guidance, initU, initV);
     if (!nearestPoint1.has_value()) {
@@ -183,6 +229,25 @@ std::optional<Entity> IntersectionSystem::FindSelfIntersection(const Entity e, c
 }
 
 
+std::vector<SliceContour> IntersectionSystem::Slice(
+    const Entity e, const alg::Vec3 &planePoint, const alg::Vec3 &normal, const std::vector<float> &levels, const int samplesInOneDim
+) const {
+    assert(CanBeIntersected(e));
+
+    const auto surface = GetSurface(e);
+    SurfaceSlicer slicer(*surface, samplesInOneDim, samplesInOneDim);
+
+    auto contours = slicer.Slice(planePoint, normal, levels);
+
+    for (auto& contour : contours) {
+        for (auto& params : contour.parameters)
+            surface->Normalize(params.X(), params.Y());
+    }
+
+    return contours;
+}
+
+
 std::unique_ptr<Surface> IntersectionSystem::GetSurface(const Entity entity) const
 {
     if (coordinator->SystemRegistered<ToriSystem>())
@@ -203,6 +268,145 @@ std::unique_ptr<Surface> IntersectionSystem::GetSurface(const Entity entity) con
 }
 
 
+namespace
+{
+    size_t HashFloat(const size_t seed, const float value)
+        { return stdh::hashCombine(seed, std::hash<float>()(value)); }
+
+
+    size_t HashVec3(size_t seed, const alg::Vec3& vec)
+    {
+        seed = HashFloat(seed, vec.X());
+        seed = HashFloat(seed, vec.Y());
+        return HashFloat(seed, vec.Z());
+    }
+
+
+    size_t HashPatches(const Coordinator& coordinator, const Patches& patches, size_t seed)
+    {
+        seed = stdh::hashCombine(seed, patches.PointsInRow());
+        seed = stdh::hashCombine(seed, patches.PointsInCol());
+
+        for (size_t row = 0; row < patches.PointsInRow(); ++row) {
+            for (size_t col = 0; col < patches.PointsInCol(); ++col) {
+                const Entity cp = patches.GetPoint(row, col);
+                seed = HashVec3(seed, coordinator.GetComponent<Position>(cp).vec);
+            }
+        }
+
+        return seed;
+    }
+
+
+    // Distinguishes surfaces of different types built from the same data
+    enum class SurfaceTag : size_t {
+        Torus = 1,
+        C0Patches,
+        C2Patches,
+        Equidistance
+    };
+}
+
+
+size_t IntersectionSystem::SurfaceHash(const Entity entity) const
+{
+    if (coordinator->SystemRegistered<ToriSystem>()) {
+        if (coordinator->GetSystem<ToriSystem>()->GetEntities().contains(entity)) {
+            const auto& params = coordinator->GetComponent<TorusParameters>(entity);
+            const auto& quat = coordinator->GetComponent<Rotation>(entity).GetQuaternion();
+            const auto& scale = coordinator->GetComponent<Scale>(entity);
+
+            size_t seed = static_cast<size_t>(SurfaceTag::Torus);
+            seed = HashFloat(seed, params.majorRadius);
+            seed = HashFloat(seed, params.minorRadius);
+            seed = HashVec3(seed, coordinator->GetComponent<Position>(entity).vec);
+            seed = HashVec3(seed, alg::Vec3(quat.X(), quat.Y(), quat.Z()));
+            seed = HashFloat(seed, quat.W());
+            return HashVec3(seed, alg::Vec3(scale.GetX(), scale.GetY(), scale.GetZ()));
+        }
+    }
+
+    if (coordinator->GetSystem<C0PatchesSystem>()->GetEntities().contains(entity)) {
+        const auto& patches = coordinator->GetComponent<C0Patches>(entity);
+        return HashPatches(*coordinator, patches, static_cast<size_t>(SurfaceTag::C0Patches));
+    }
+
+    if (coordinator->GetSystem<C2PatchesSystem>()->GetEntities().contains(entity)) {
+        const auto& patches = coordinator->GetComponent<C2Patches>(entity);
+        return HashPatches(*coordinator, patches, static_cast<size_t>(SurfaceTag::C2Patches));
+    }
+
+    if (coordinator->SystemRegistered<EquidistanceC2System>()) {
+        if (coordinator->GetSystem<EquidistanceC2System>()->GetEntities().contains(entity)) {
+            const auto& params = coordinator->GetComponent<EquidistanceSurfaceParameters>(entity);
+
+            size_t seed = static_cast<size_t>(SurfaceTag::Equidistance);
+            seed = stdh::hashCombine(seed, SurfaceHash(params.baseSurface));
+            return HashFloat(seed, params.distance);
+        }
+    }
+
+    throw std::runtime_error("Entity cannot be used to calculate intersection curve");
+}
+
+
+IntersectionsCache::Key IntersectionSystem::CacheKey(
+    const Entity e1, const Entity e2, const float step, const std::optional<alg::Vec3>& guidance
+) {
+    const size_t hash1 = SurfaceHash(e1);
+    const size_t hash2 = e1 == e2 ? hash1 : SurfaceHash(e2);
+
+    // Geometry of the surfaces might have been changed since the last search,
+    // so the results computed for the old one are no longer needed
+    TrackSurface(e1, hash1);
+    TrackSurface(e2, hash2);
+
+    return {
+        .surface1 = e1,
+        .surface2 = e2,
+        .surface1Hash = hash1,
+        .surface2Hash = hash2,
+        .step = step,
+        .guidance = guidance,
+        .selfIntersection = e1 == e2
+    };
+}
+
+
+template <typename Comp>
+void IntersectionSystem::SubscribeToDeletion(const Entity entity)
+{
+    coordinator->Subscribe<Comp>(entity, std::make_shared<SurfaceDeletionHandler<Comp>>(cache));
+}
+
+
+template <typename Comp>
+void IntersectionSystem::SurfaceDeletionHandler<Comp>::HandleEvent(const Entity entity, const Comp&, const EventType eventType)
+{
+    if (eventType != EventType::ComponentDeleted)
+        return;
+
+    cache.RemoveSurface(entity);
+}
+
+
+void IntersectionSystem::TrackSurface(const Entity entity, const size_t hash)
+{
+    if (!cache.TracksSurface(entity)) {
+        if (coordinator->SystemRegistered<ToriSystem>() && coordinator->GetSystem<ToriSystem>()->GetEntities().contains(entity))
+            SubscribeToDeletion<TorusParameters>(entity);
+        else if (coordinator->GetSystem<C0PatchesSystem>()->GetEntities().contains(entity))
+            SubscribeToDeletion<C0Patches>(entity);
+        else if (coordinator->GetSystem<C2PatchesSystem>()->GetEntities().contains(entity))
+            SubscribeToDeletion<C2Patches>(entity);
+        else
+            SubscribeToDeletion<EquidistanceSurfaceParameters>(entity);
+    }
+
+    cache.UpdateSurfaceHash(entity, hash);
+}
+
+
 IntersectionPoint IntersectionSystem::FindFirstApproximation(Surface& s1, Surface& s2) const
 {
     constexpr int sampleCntInOneDim = 15;
@@ -448,7 +652,7 @@ private:
 };
 
 
-std::optional<IntersectionPoint> IntersectionSystem::FindFirstIntersectionPoint(Surface& s1, Surface& s2, const IntersectionPoint& initSol) const
+std::optional<IntersectionPoint> IntersectionSystem::FindFirstIntersectionPoint(Surface& s1, Surface& s2, const IntersectionPoint& initSol)
 {
     const std::vector startingPoint = {
         initSol.U1(),
@@ -461,7 +665,9 @@ std::optional<IntersectionPoint> IntersectionSystem::FindFirstIntersectionPoint(
     NearZeroCondition stopCond;
     DistanceBetweenPoints fun(s1, s2);
 
-    const auto sol = ConjugateGradientMethod(fun, lineSearch, startingPoint, 200, stopCond);
+    opt::SolverStats stats;
+    const auto sol = ConjugateGradientMethod(fun, lineSearch, startingPoint, 200, stopCond, stats);
+    telemetry.Record(stats);
 
     if (!sol.has_value())
         return std::nullopt;
@@ -516,7 +722,7 @@ private:
 
 
 std::optional<std::tuple<float, float>> IntersectionSystem::NearestPoint(
-    Surface &s, const Position &guidance, const float initU, const float initV) const
+    Surface &s, const Position &guidance, const float initU, const float initV)
 {
     const std::vector startingPoint {
         initU, initV
@@ -526,7 +732,9 @@ std::optional<std::tuple<float, float>> IntersectionSystem::NearestPoint(
     opt::SmallGradient stopCond;
     NearestPointFun fun(s, guidance);
 
-    const auto solOpt = ConjugateGradientMethod(fun, lineSearch, startingPoint, 200, stopCond);
+    opt::SolverStats stats;
+    const auto solOpt = ConjugateGradientMethod(fun, lineSearch, startingPoint, 200, stopCond, stats);
+    telemetry.Record(stats);
     if (!solOpt.has_value())
         return std::nullopt;
 
@@ -627,7 +835,7 @@ std::optional<Entity> IntersectionSystem::FindIntersection(Surface &s1, Surface
     intersections.emplace_back(initPoint);
     const auto firstPoint = s1.PointOnSurface(initPoint.U1(), initPoint.V1());
 
-    NextPointFinder nextPointFinder(s1, s2, initPoint, step);
+    NextPointFinder nextPointFinder(s1, s2, initPoint, step, &telemetry);
 
     if (!nextPointFinder.FindNext()) {
         std::cout << "Cannot find second point\n";
@@ -671,7 +879,7 @@ std::optional<Entity> IntersectionSystem::FindOpenIntersection(
     const IntersectionPoint prevSol(firstPoint.U2(), firstPoint.V2(), firstPoint.U1(), firstPoint.V1());
 
     // Passing solutions in reversed order to traverse intersection in other direction
-    NextPointFinder nextPointFinder(s2, s1, prevSol, step);
+    NextPointFinder nextPointFinder(s2, s1, prevSol, step, &telemetry);
 
     do {
         if (!nextPointFinder.FindNext()) {
@@ -699,28 +907,25 @@ float IntersectionSystem::ErrorRate(Surface& s1, Surface& s2, const Intersection
 
 Entity IntersectionSystem::CreateCurve(Surface& s1, Surface& s2, const std::deque<IntersectionPoint> &interPoints, const bool isOpen)
 {
-    std::vector<Entity> controlPoints;
-    controlPoints.reserve(interPoints.size());
+    std::vector<alg::Vec3> points;
+    points.reserve(interPoints.size());
 
     for (auto point: interPoints) {
-        const Entity cp = coordinator->CreateEntity();
-
-        coordinator->AddComponent<Position>(cp, s1.PointOnSurface(point.U1(), point.V1()));
-
-        controlPoints.push_back(cp);
+        points.push_back(s1.PointOnSurface(point.U1(), point.V1()));
     }
 
-    if (!isOpen) {
-        controlPoints.push_back(*controlPoints.begin());
-    }
+    const Entity curve = coordinator->CreateEntity();
 
-    const auto sys = coordinator->GetSystem<InterpolationCurvesRenderingSystem>();
-    const Entity curve = sys->AddCurve(controlPoints);
+    coordinator->AddComponent<IntersectionPolyline>(curve, IntersectionPolyline(std::move(points), isOpen));
+    coordinator->GetSystem<IntersectionPolylinesRenderingSystem>()->AddPolyline(curve);
 
-    const auto handler = std::make_shared<DeletionHandler>(*coordinator);
-    const auto handlerId = coordinator->Subscribe(curve, std::static_pointer_cast<EventHandler<CurveControlPoints>>(handler));
+    if (cacheKey.has_value()) {
+        cache.Insert(cacheKey.value(), { .points = interPoints, .isOpen = isOpen });
+        cacheKey = std::nullopt;
+    }
 
-    IntersectionCurve interCurve(interPoints, isOpen, handlerId);
+    IntersectionCurve interCurve(interPoints, isOpen);
+    interCurve.telemetry = telemetry;
 
     for (IntersectionPoint& point : interCurve.intersectionPoints) {
         s1.Normalize(point.U1(), point.V1());
@@ -732,21 +937,3 @@ Entity IntersectionSystem::CreateCurve(Surface& s1, Surface& s2, const std::dequ
 
     return curve;
 }
-
-
-void IntersectionSystem::DeletionHandler::HandleEvent(
-    Entity entity, const CurveControlPoints& component, const EventType eventType
-) {
-    if (eventType != EventType::ComponentDeleted)
-        return;
-
-    const auto points = component.GetPoints();
-    const std::set toDelete(points.begin(), points.end());
-
-    for (const auto cp : toDelete) {
-        coordinator.DestroyEntity(cp);
-    }
-}
-
-
-
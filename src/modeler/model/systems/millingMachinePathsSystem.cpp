@@ -1,83 +1,32 @@
 #include <CAD_modeler/model/systems/millingMachinePathsSystem.hpp>
 
+#include <CAD_modeler/model/millingMachineSim/gCodeParser.hpp>
+#include <CAD_modeler/model/millingMachineSim/gCodeWriter.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathSimplification.hpp>
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
+
 #include <fstream>
 #include <regex>
-#include <cassert>
 #include <filesystem>
-#include <iomanip>
 #include <ios>
-#include <sstream>
 
 namespace fs = std::filesystem;
 
 
 MillingMachinePath MillingMachinePathsSystem::ParseGCode(const std::string &filePath)
 {
-    std::ifstream file;
-    MillingMachinePath result;
-
-    std::regex lineRegex(R"(^N(\d+)G01((X)(-?\d+\.\d+))?((Y)(-?\d+\.\d+))?((Z)(-?\d+\.\d+))?\r?$)");
-
-    file.open(filePath);
-
-    std::string lineStr;
-    while (std::getline(file, lineStr)) {
-        std::smatch match;
-
-        if (std::regex_match(lineStr, match, lineRegex)) {
-            assert(match.size() == 11);
-
-            int id;
-            float x, y, z;
-            bool coordinatesFound = false;
-
-            if (match[1].str().empty())
-                throw std::invalid_argument("Invalid GCode file");
-
-            id = std::stoi(match[1].str());
-
-            if (!match[3].str().empty()) {
-                assert(match[3].str() == "X");
-                x = std::stof(match[4].str());
-                coordinatesFound = true;
-            }
-            else {
-                x = result.commands.back().destination.GetZ();
-            }
-
-            if (!match[6].str().empty()) {
-                assert(match[6].str() == "Y");
-                y = std::stof(match[7].str());
-                coordinatesFound = true;
-            }
-            else {
-                y = result.commands.back().destination.GetX();
-            }
-
-            if (!match[9].str().empty()) {
-                assert(match[9].str() == "Z");
-                z = std::stof(match[10].str());
-                coordinatesFound = true;
-            }
-            else {
-                z = result.commands.back().destination.GetY();
-            }
-
-            if (!coordinatesFound)
-                throw std::invalid_argument("Invalid GCode file");
-
-            // Different coordinate systems conventions
-            result.commands.emplace_back(id, y, z, x);
-        }
-    }
-
-    file.close();
-
-    std::ranges::for_each(result, [](auto& command) {
-        command.destination.vec *= scale;
-    });
-
-    return result;
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::invalid_argument("Cannot open GCode file");
+
+    // Reading the whole file at once, so the parser can work on a single buffer
+    const auto fileSize = static_cast<size_t>(fs::file_size(filePath));
+    std::string content(fileSize, '\0');
+    file.read(content.data(), static_cast<std::streamsize>(fileSize));
+    content.resize(static_cast<size_t>(file.gcount()));
+
+    GCodeParser parser(scale);
+    return parser.Parse(content);
 }
 
 
@@ -105,55 +54,17 @@ MillingCutter MillingMachinePathsSystem::ParseCutter(const std::string &filePath
 }
 
 
-std::string FormatFloat(const float value)
+void MillingMachinePathsSystem::CreateGCodeFile(const MillingMachinePath &paths, const std::string_view path, const float chordTolerance)
 {
-    std::ostringstream out;
-    out << std::fixed << std::setprecision(3) << value;
+    std::ofstream file(std::string(path), std::ios::binary);
 
-    return out.str();
+    GCodeWriter writer(scale);
+    writer.Write(SimplifyPath(paths, chordTolerance), file);
 }
 
 
-void MillingMachinePathsSystem::CreateGCodeFile(const MillingMachinePath &paths, std::string_view path)
-{
-    std::ofstream file;
-
-    file.open(path.data());
-
-    int idOffset = 0;
-
-    std::string lastX;
-    std::string lastY;
-    std::string lastZ;
-
-    for (const auto& command : paths) {
-        // Different coordinates conventions
-        std::string actX = FormatFloat(command.destination.GetZ() / scale);
-        std::string actY = FormatFloat(command.destination.GetX() / scale);
-        std::string actZ = FormatFloat(command.destination.GetY() / scale);
-
-        if (actX == lastX && actY == lastY && actZ == lastZ) {
-            ++idOffset;
-            continue;
-        }
-
-        file << 'N' << command.id - idOffset << "G01";
-
-        if (actX != lastX)
-            file << 'X' << actX;
-
-        if (actY != lastY)
-            file << 'Y' << actY;
-
-        if (actZ != lastZ)
-            file << 'Z' << actZ;
-
-        file << "\r\n";
-
-        lastX = actX;
-        lastY = actY;
-        lastZ = actZ;
-    }
-
-    file.close();
+void MillingMachinePathsSystem::CreateToolpathFile(
+    const MillingMachinePath &paths, const MillingCutter &cutter, const std::string &path, const float chordTolerance
+) {
+    ToolpathFile::Save(path, SimplifyPath(paths, chordTolerance), cutter);
 }
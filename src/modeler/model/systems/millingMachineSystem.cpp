@@ -6,8 +6,9 @@
 #include <CAD_modeler/model/components/millingMachinePath.hpp>
 #include <CAD_modeler/model/components/scale.hpp>
 
-#include <CAD_modeler/utilities/lineDrawer.hpp>
-#include <CAD_modeler/utilities/lineSegment.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathValidation.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
 
 #include <ecs/coordinator.hpp>
 
@@ -58,11 +59,17 @@ void MillingMachineSystem::Init(const int xResolution, const int zResolution)
     coordinator->AddComponent<Mesh>(millingCutter, millingCutterMesh);
     coordinator->AddComponent<Position>(millingCutter, Position());
     coordinator->AddComponent<Scale>(millingCutter, Scale(0.05f));
+
+    ResetCheckpoints();
 }
 
 
-void MillingMachineSystem::AddPaths(MillingMachinePath &&paths, const MillingCutter& cutter) const
+void MillingMachineSystem::AddPaths(MillingMachinePath &&paths, const MillingCutter& cutter)
 {
+    // Stepper and instant milling worker mill the path, which is going to be destroyed
+    StopMachine();
+    StopInstantMilling();
+
     const Entity pathsEntity = coordinator->CreateEntity();
 
     if (!entities.empty()) {
@@ -83,40 +90,149 @@ void MillingMachineSystem::AddPaths(MillingMachinePath &&paths, const MillingCut
     );
 
     coordinator->AddComponent(pathsEntity, std::move(pathsMesh));
+    millingWarnings.Reset(paths);
     coordinator->AddComponent(pathsEntity, std::move(paths));
 
-    coordinator->SetComponent<Position>(millingCutter, paths.commands[0].destination);
+    coordinator->SetComponent<Position>(millingCutter, paths.Commands()[0].destination);
     coordinator->AddComponent<Scale>(millingCutter, Scale(1.f/cutter.radius));
 
     if (coordinator->HasComponent<MillingCutter>(millingCutter))
         coordinator->SetComponent(millingCutter, cutter);
     else
         coordinator->AddComponent<MillingCutter>(millingCutter, cutter);
+
+    // New path starts milling the material in its actual state
+    actCommand = 1;
+    simulatedTime = 0.0;
+    ResetCheckpoints();
+
+    ValidatePaths();
+}
+
+
+void MillingMachineSystem::StartMachine()
+{
+    if (cutterRuns || entities.empty() || InstantMillingRuns())
+        return;
+
+    const auto& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
+    const auto& cutter = coordinator->GetComponent<MillingCutter>(millingCutter);
+
+    const PathStepper::Progress start {
+        .command = static_cast<size_t>(actCommand),
+        .cutterPos = coordinator->GetComponent<Position>(millingCutter).vec,
+        .simulatedTime = simulatedTime
+    };
+
+    // Checkpoints are taken on the stepper thread, while the height map is locked
+    auto takeCheckpoint = [this] (const size_t nextCommand, const double time) {
+        if (checkpoints.Due(nextCommand, time))
+            checkpoints.Take(material.Heights(), nextCommand, time);
+    };
+
+    stepper.SetSpeed(cutterSpeed);
+    stepper.Start(material.Heights(), cutter, path, millingWarnings, start, takeCheckpoint);
+    cutterRuns = true;
+}
+
+
+void MillingMachineSystem::StopMachine()
+{
+    if (!cutterRuns)
+        return;
+
+    const auto progress = stepper.Stop();
+    cutterRuns = false;
+
+    actCommand = static_cast<int>(progress.command);
+    simulatedTime = progress.simulatedTime;
+    coordinator->SetComponent<Position>(millingCutter, progress.cutterPos);
+
+    material.SyncVisualization();
 }
 
 
 void MillingMachineSystem::StartInstantMilling()
 {
+    // Worker still mills the published tiles, which resetting them would free
+    if (InstantMillingRuns())
+        return;
+
+    StopMachine();
+
+    milledTiles.Reset(material.Heights(), tiledMiller.TileSize());
     instantWorker.StartWork();
 }
 
 
 void MillingMachineSystem::StopInstantMilling()
 {
+    if (!InstantMillingRuns())
+        return;
+
     instantWorker.JoinWorker();
+    material.SyncVisualization();
+
+    if (entities.empty())
+        return;
+
+    const auto commands = coordinator->GetComponent<MillingMachinePath>(*entities.begin()).Commands();
+    coordinator->SetComponent<Position>(millingCutter, commands[actCommand - 1].destination);
 }
 
 
 void MillingMachineSystem::ResetSimulation()
 {
-    ResetMaterial();
+    StopMachine();
+    StopInstantMilling();
+
     actCommand = 1;
-    const auto&[commands] = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
+    simulatedTime = 0.0;
+    ResetMaterial();
+
+    const auto commands = coordinator->GetComponent<MillingMachinePath>(*entities.begin()).Commands();
     coordinator->SetComponent<Position>(millingCutter, commands[0].destination);
     millingWarnings.Clear();
 }
 
 
+void MillingMachineSystem::SeekToCommand(const size_t command)
+{
+    if (entities.empty() || cutterRuns || InstantMillingRuns())
+        return;
+
+    const auto& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
+    const size_t target = std::min(command, path.Size() - 1) + 1;
+
+    // Material is milled only forward, so going back requires restoring it from a checkpoint
+    if (target < static_cast<size_t>(actCommand)) {
+        if (checkpoints.Empty() || target < checkpoints.CheckpointCommand(0))
+            ResetSimulation();
+        else {
+            const auto restored = checkpoints.Restore(material.Heights(), target);
+            actCommand = static_cast<int>(restored.command);
+            simulatedTime = restored.simulatedTime;
+        }
+
+        millingWarnings.ClearFrom(actCommand);
+    }
+
+    MillCommands(target, {}, nullptr);
+
+    coordinator->SetComponent<Position>(millingCutter, path.Commands()[target - 1].destination);
+    material.SyncVisualization();
+}
+
+
+size_t MillingMachineSystem::GetCommandsCnt() const
+{
+    if (entities.empty())
+        return 0;
+
+    return coordinator->GetComponent<MillingMachinePath>(*entities.begin()).Size();
+}
+
+
 std::optional<MillingCutter> MillingMachineSystem::GetMillingCutter() const
 {
     if (entities.empty())
@@ -136,50 +252,70 @@ void MillingMachineSystem::SetCutterHeight(float height) const
 }
 
 
-void MillingMachineSystem::Update(const double dt)
+void MillingMachineSystem::SetCutterProfile(const CutterProfile &profile)
 {
-    if (InstantMillingRuns()) {
-        if (instantWorker.WaitsForJoin()) {
-            instantWorker.JoinWorker();
-            material.SyncVisualization();
+    if (cutterRuns || InstantMillingRuns() || !coordinator->HasComponent<MillingCutter>(millingCutter))
+        return;
+
+    coordinator->EditComponent<MillingCutter>(millingCutter,
+        [&profile] (MillingCutter& cutter) {
+            cutter = MillingCutter(profile, cutter.height);
         }
-    }
+    );
 
-    if (!cutterRuns || entities.empty())
-        return;
+    // Checkpoints after the actual command were milled with the previous cutter
+    ResetCheckpoints();
+    ValidatePaths();
+}
 
-    const auto&[commands] = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
-    auto cutterPos = coordinator->GetComponent<Position>(millingCutter);
-    float dist = static_cast<float>(dt) * cutterSpeed;
 
-    do {
-        auto const& actDest = commands[actCommand].destination;
-        const float remainingCommandDist = alg::Distance(actDest.vec, cutterPos.vec);
+void MillingMachineSystem::ValidatePaths()
+{
+    if (entities.empty() || cutterRuns || InstantMillingRuns())
+        return;
 
-        if (remainingCommandDist > dist) {
-            auto const& prevDest = commands[actCommand - 1].destination;
-            const float traveledDist = alg::Distance(prevDest.vec, cutterPos.vec);
-            const alg::Vec3 newCutterPos = prevDest.vec + (traveledDist + dist) * (actDest.vec - prevDest.vec).Normalize();
+    const auto& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
+    const auto& cutter = coordinator->GetComponent<MillingCutter>(millingCutter);
 
-            MillSection(cutterPos, newCutterPos);
+    validationWarnings.Reset(path);
+    ValidatePath(material.Heights(), cutter, path, validationWarnings);
+    validationWarnings.UpdateView();
+}
 
-            coordinator->SetComponent<Position>(millingCutter, newCutterPos);
 
-            material.SyncVisualization();
-            return;
+void MillingMachineSystem::Update(const double dt)
+{
+    millingWarnings.UpdateView();
+
+    if (InstantMillingRuns()) {
+        if (instantWorker.WaitsForJoin())
+            StopInstantMilling();
+        else {
+            milledTiles.TakePublished([this](const PixelRect& tile) {
+                material.SyncVisualization(tile);
+            });
         }
+    }
 
-        MillSection(cutterPos, actDest.vec);
-        cutterPos = actDest;
-        actCommand++;
-        dist -= remainingCommandDist;
-    } while (static_cast<size_t>(actCommand) < commands.size());
+    if (!cutterRuns)
+        return;
 
-    StopMachine();
-    actCommand = 1;
-    coordinator->SetComponent<Position>(millingCutter, commands[0].destination);
+    stepper.AddTime(dt);
+    const auto progress = stepper.GetProgress();
 
-    material.SyncVisualization();
+    actCommand = static_cast<int>(progress.command);
+    simulatedTime = progress.simulatedTime;
+    coordinator->SetComponent<Position>(millingCutter, progress.cutterPos);
+
+    {
+        // Heights are uploaded in between the stepper milling slices
+        const auto lock = stepper.LockHeightMap();
+        material.SyncVisualization();
+    }
+
+    // Cutter stays at the end of the path, so that the whole path can still be scrubbed back
+    if (progress.finished)
+        StopMachine();
 }
 
 
@@ -202,125 +338,74 @@ void MillingMachineSystem::InstantMillingThreadFunc(std::stop_token stoken)
     if (entities.empty())
         return;
 
-    const auto&[commands] = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
-
-    while (static_cast<size_t>(actCommand) < commands.size() && !stoken.stop_requested()) {
-        const auto& prevDest = commands[actCommand - 1].destination;
-        const auto& actDest = commands[actCommand].destination;
-
-        MillSection(prevDest, actDest);
-        actCommand++;
-    }
-
-    actCommand = 1;
+    MillCommands(pathEnd, stoken, &milledTiles);
 }
 
 
-void MillingMachineSystem::MillSection(const Position& oldCutterPos, const Position& newCutterPos)
+void MillingMachineSystem::MillCommands(const size_t endCommand, const std::stop_token& stoken, MilledTiles* tiles)
 {
-    if (oldCutterPos.vec == newCutterPos.vec)
-        return;
-
-    // Step 1 Mill around the starting position
+    const auto& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
     const auto& cutter = coordinator->GetComponent<MillingCutter>(millingCutter);
 
-    const float pixelXLen = material.PixelXLen();
-    const float pixelZLen = material.PixelZLen();
-
-    float diffX = oldCutterPos.GetX() - material.MinX();
-    float diffZ = oldCutterPos.GetZ() - material.MinZ();
-    const int oldPosPixelX = static_cast<int>(std::round(diffX / pixelXLen));
-    const int oldPosPixelZ = static_cast<int>(std::round(diffZ / pixelZLen));
-
-    diffX = newCutterPos.GetX() - material.MinX();
-    diffZ = newCutterPos.GetZ() - material.MinZ();
-    const int newPosPixelX = static_cast<int>(std::round(diffX / pixelXLen));
-    const int newPosPixelZ = static_cast<int>(std::round(diffZ / pixelZLen));
+    const size_t end = std::min(endCommand, path.Size());
+    std::vector<int> retracted;
 
-    const int radiusInPixelsX = static_cast<int>(std::ceil(cutter.radius / pixelXLen));
-    const int radiusInPixelsZ = static_cast<int>(std::ceil(cutter.radius / pixelZLen));
-    const int startPixelX = oldPosPixelX - radiusInPixelsX;
-    const int startPixelZ = oldPosPixelZ - radiusInPixelsZ;
+    // Path is milled in parts between checkpoints, so that the material can be saved in between
+    while (static_cast<size_t>(actCommand) < end && !stoken.stop_requested()) {
+        const size_t partEnd = NextCheckpointCommand(path, end);
 
-    const float crossLen = Cross((newCutterPos.vec - oldCutterPos.vec).Normalize(), alg::Vec3(0.f, 1.f, 0.f)).LengthSquared();
-    const bool straightDown = crossLen < 1e-5;
+        if (tiles != nullptr)
+            tiles->Retract(retracted);
 
-    for (int x = startPixelX; x <= startPixelX + 2*radiusInPixelsX; x++) {
-        for (int z = startPixelZ; z <= startPixelZ + 2*radiusInPixelsZ; z++) {
-            if (x < 0 || x >= material.XResolution() || z < 0 || z >= material.ZResolution())
-                continue;
+        MillPath(tiledMiller, material.Heights(), cutter, path, millingWarnings, actCommand, partEnd, stoken, tiles);
 
-            const float globalX = material.GlobalX(x);
-            const float globalZ = material.GlobalZ(z);
+        if (tiles != nullptr) {
+            for (const int tile : retracted)
+                tiles->Publish(tile);
 
-            const float cutterY = cutter.YCoordinate(oldCutterPos, globalX, globalZ);
-
-            UpdateHeightMap(x, z, cutterY, cutter.height, straightDown);
+            retracted.clear();
         }
-    }
-
-    // Step 2: Milling along the whole line
-    const alg::IVec2 oldPosPixel(oldPosPixelX, oldPosPixelZ);
-    const alg::IVec2 newPosPixel(newPosPixelX, newPosPixelZ);
 
-    const auto lineDrawer = GetLineDrawer(oldPosPixel, newPosPixel);
-
-    const LineSegment lineSegment(oldCutterPos.vec, newCutterPos.vec);
-    const bool lineIsSteep = IsSteepLine(oldPosPixel, newPosPixel);
+        // Part milled only partially is milled again next time, which does not change already milled material
+        if (stoken.stop_requested())
+            return;
 
-    const int cutterRadius = lineIsSteep ? radiusInPixelsZ : radiusInPixelsX;
+        if (cutterSpeed > 0.f)
+            simulatedTime += PathLength(path, actCommand, partEnd) / cutterSpeed;
 
-    do {
-        for (int i = -cutterRadius; i <= cutterRadius; i++) {
-            const alg::IVec2& actPoint = lineDrawer->ActualPoint();
+        actCommand = static_cast<int>(partEnd);
+        TakeCheckpointIfDue();
+    }
+}
 
-            const int x = lineIsSteep ? actPoint.X() + i : actPoint.X();
-            const int z = !lineIsSteep ? actPoint.Y() + i : actPoint.Y();
 
-            if (x < 0 || x >= material.XResolution() || z < 0 || z >= material.ZResolution())
-                continue;
+size_t MillingMachineSystem::NextCheckpointCommand(const MillingMachinePath& path, const size_t endCommand) const
+{
+    const auto commands = path.Commands();
+    double time = simulatedTime;
 
-            const float globalX = material.GlobalX(x);
-            const float globalZ = material.GlobalZ(z);
+    for (size_t command = static_cast<size_t>(actCommand) + 1; command < endCommand; ++command) {
+        if (cutterSpeed > 0.f)
+            time += alg::Distance(commands[command - 2].destination.vec, commands[command - 1].destination.vec) / cutterSpeed;
 
-            const auto cutterPos = lineSegment.NearestPoint(alg::Vec3(globalX, 0.f, globalZ));
-            const float cutterY = cutter.YCoordinate(cutterPos, globalX, globalZ);
+        if (checkpoints.Due(command, time))
+            return command;
+    }
 
-            UpdateHeightMap(x, z, cutterY, cutter.height, straightDown);
-        }
-    } while (lineDrawer->NextPoint());
+    return endCommand;
 }
 
 
-float MillingMachineSystem::UpdateHeightMap(const int x, const int z, const float cutterY, const float cutterHeight, const bool pathToDown)
+void MillingMachineSystem::TakeCheckpointIfDue()
 {
-    const float oldHeight = material.HeightAt(x, z);
-    const float diff = std::max(oldHeight - cutterY, 0.f);
-    if (diff == 0.f)
-        return diff;
-
-    const float newHeight = oldHeight - diff;
-    material.ChangeHeightAt(x, z, newHeight);
-
-    if (newHeight < material.BaseLevel()) {
-        auto const& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
-        const auto commandId = path.commands[actCommand].id;
-        millingWarnings.AddWarning(commandId, MillingWarningsRepo::MillingUnderTheBase);
-    }
-
-    if (diff > cutterHeight) {
-        auto const& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
-        const auto commandId = path.commands[actCommand].id;
-        millingWarnings.AddWarning(commandId, MillingWarningsRepo::MillingTooDeep);
-    }
+    if (checkpoints.Due(actCommand, simulatedTime))
+        checkpoints.Take(material.Heights(), actCommand, simulatedTime);
+}
 
-    if (pathToDown) {
-        auto const& path = coordinator->GetComponent<MillingMachinePath>(*entities.begin());
-        const auto commandId = path.commands[actCommand].id;
-        millingWarnings.AddWarning(commandId, MillingWarningsRepo::MillingStraightDown);
-    }
 
-    return diff;
+void MillingMachineSystem::ResetCheckpoints()
+{
+    checkpoints.Reset(material.Heights(), actCommand, simulatedTime);
 }
 
 
@@ -364,9 +449,9 @@ void MillingMachineSystem::RenderCutter(const alg::Mat4x4 &cameraMtx) const
 std::vector<float> MillingMachineSystem::GeneratePathsVertices(const MillingMachinePath &paths)
 {
     std::vector<float> result;
-    result.reserve(paths.commands.size() * alg::Vec3::dim);
+    result.reserve(paths.Size() * alg::Vec3::dim);
 
-    for (const auto& command : paths.commands) {
+    for (const auto& command : paths) {
         result.push_back(command.destination.GetX());
         result.push_back(command.destination.GetY());
         result.push_back(command.destination.GetZ());
@@ -379,9 +464,9 @@ std::vector<float> MillingMachineSystem::GeneratePathsVertices(const MillingMach
 std::vector<uint32_t> MillingMachineSystem::GeneratePathsIndices(const MillingMachinePath &paths)
 {
     std::vector<std::uint32_t> result;
-    result.reserve(paths.commands.size());
+    result.reserve(paths.Size());
 
-    for (uint32_t i = 0; i < paths.commands.size(); ++i) {
+    for (uint32_t i = 0; i < paths.Size(); ++i) {
         result.push_back(i);
     }
 
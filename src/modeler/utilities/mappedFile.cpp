@@ -0,0 +1,98 @@
+#include <CAD_modeler/utilities/mappedFile.hpp>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &filePath)
+{
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open file");
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot read file size");
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size == 0)
+        return;
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file");
+    }
+
+    data = static_cast<const std::byte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file");
+    }
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+
+    if (mappingHandle != nullptr)
+        CloseHandle(mappingHandle);
+
+    CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filePath)
+{
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open file");
+
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot read file size");
+    }
+
+    size = static_cast<size_t>(fileStat.st_size);
+
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map file");
+        }
+
+        data = static_cast<const std::byte*>(mapped);
+    }
+
+    // Mapping stays valid after closing the descriptor
+    close(fd);
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (data != nullptr)
+        munmap(const_cast<std::byte*>(data), size);
+}
+
+#endif
@@ -3,6 +3,8 @@
 #include <imgui.h>
 #include <ImGuiFileDialog.h>
 
+#include <algorithm>
+
 
 MillingPathsDesignerView::MillingPathsDesignerView(MillingPathsDesigner &model):
     model(model)
@@ -23,5 +25,15 @@ void MillingPathsDesignerView::RenderGui()
     if (ImGui::Button("Main phase"))
         model.GenerateMainPhase();
 
+    ImGui::Separator();
+
+    ImGui::InputInt("Target x resolution", &targetXResolution);
+    ImGui::InputInt("Target z resolution", &targetZResolution);
+    targetXResolution = std::max(targetXResolution, 1);
+    targetZResolution = std::max(targetZResolution, 1);
+
+    if (ImGui::Button("Export target heights"))
+        model.ExportTargetHeights("paths/target.thm", targetXResolution, targetZResolution);
+
     ImGui::End();
 }
@@ -3,6 +3,9 @@
 #include <imgui.h>
 #include <ImGuiFileDialog.h>
 
+#include <array>
+#include <numbers>
+
 
 MillingSimulatorView::MillingSimulatorView(MillingMachineSim &model):
     model(model)
@@ -17,6 +20,7 @@ void MillingSimulatorView::RenderGui()
     RenderFileSelection();
     RenderMaterialOptions();
     RenderSimulationOptions();
+    RenderTimeline();
     RenderCutterInformation();
     RenderWarnings();
 
@@ -40,7 +44,7 @@ void MillingSimulatorView::RenderFileSelection()
         ImGuiFileDialog::Instance()->OpenDialog(
             "ChooseGCodeFileDlgKey",
             "Choose GCode File",
-            "GCode files {.k01,.k1,.k08,.k8,.k16,.f10,.f12}",
+            "GCode files {.k01,.k1,.k08,.k8,.k16,.f10,.f12},Toolpath files {.ctp}",
             config
         );
     }
@@ -64,7 +68,7 @@ void MillingSimulatorView::RenderMaterialOptions() const
     int xResolution = model.GetMaterialXResolution();
     int zResolution = model.GetMaterialZResolution();
 
-    ImGui::BeginDisabled(model.MillingMachineRuns());
+    ImGui::BeginDisabled(model.MillingMachineRuns() || model.InstantSimulationRuns());
 
     valuesChanged |= ImGui::InputInt("X resolution", &xResolution);
     valuesChanged |= ImGui::InputInt("Z resolution", &zResolution);
@@ -120,15 +124,61 @@ void MillingSimulatorView::RenderSimulationOptions() const
     ImGui::EndDisabled();
     ImGui::SameLine();
 
-    ImGui::BeginDisabled(simulationRuns);
+    ImGui::BeginDisabled(simulationRuns || model.InstantSimulationRuns());
     if (ImGui::Button("Reset"))
         model.ResetSimulation();
     ImGui::EndDisabled();
 
     ImGui::SameLine();
 
+    ImGui::BeginDisabled(model.InstantSimulationRuns() || simulationRuns);
     if (ImGui::Button("Instant"))
         model.StartInstantSimulation();
+    ImGui::EndDisabled();
+}
+
+
+void MillingSimulatorView::RenderTimeline() const
+{
+    ImGui::SeparatorText("Timeline");
+
+    const size_t commandsCnt = model.GetCommandsCnt();
+    if (commandsCnt == 0) {
+        ImGui::Text("No path");
+        return;
+    }
+
+    // Checkpoints are taken by the instant milling thread, so they cannot be used until it ends
+    if (model.InstantSimulationRuns()) {
+        ImGui::Text("Instant milling in progress");
+        return;
+    }
+
+    const bool simulationRuns = model.MillingMachineRuns();
+    ImGui::BeginDisabled(simulationRuns);
+
+    int command = static_cast<int>(model.GetCurrentCommand());
+    if (ImGui::SliderInt("Command", &command, 0, static_cast<int>(commandsCnt) - 1))
+        model.SeekToCommand(static_cast<size_t>(command));
+
+    ImGui::EndDisabled();
+
+    // Checkpoints are taken by the stepper thread while the machine runs
+    if (simulationRuns)
+        return;
+
+    const auto& checkpoints = model.GetCheckpoints();
+    constexpr float bytesInMb = 1024.f * 1024.f;
+
+    ImGui::Text(
+        "Checkpoints: %zu, %.1f MB",
+        checkpoints.CheckpointsCnt(),
+        static_cast<float>(checkpoints.MemoryUsage()) / bytesInMb
+    );
+
+    int budget = static_cast<int>(checkpoints.MemoryBudget() >> 20);
+    if (ImGui::InputInt("Checkpoints memory [MB]", &budget) && budget > 0)
+        model.SetCheckpointsMemoryBudget(static_cast<size_t>(budget) << 20);
 }
 
 
@@ -145,17 +195,60 @@ void MillingSimulatorView::RenderCutterInformation() const
 
     ImGui::Text("Radius: %f mm", cutter.value().radius * 100.f);
 
-    switch (cutter.value().type) {
-        case MillingCutter::Type::Flat:
-            ImGui::Text("Type: Flat");
-            break;
+    const CutterProfile& profile = cutter->Profile();
+    const float radius = profile.Radius();
 
-        case MillingCutter::Type::Round:
-            ImGui::Text("Type: Round");
-            break;
+    if (profile.GetType() == MillingCutter::Type::Table) {
+        ImGui::Text("Type: Table profile with %zu points", profile.Points().size());
+    }
+    else {
+        // Cutter loaded from the file can be changed into the other one of the same radius
+        ImGui::BeginDisabled(model.MillingMachineRuns());
+
+        static constexpr std::array typesNames { "Round", "Flat", "Bull-nose", "Tapered" };
+        int type = static_cast<int>(profile.GetType());
+
+        if (ImGui::Combo("Type", &type, typesNames.data(), static_cast<int>(typesNames.size()))) {
+            switch (static_cast<MillingCutter::Type>(type)) {
+                case MillingCutter::Type::Round:
+                    model.SetCutterProfile(CutterProfile::Round(radius));
+                    break;
+
+                case MillingCutter::Type::Flat:
+                    model.SetCutterProfile(CutterProfile::Flat(radius));
+                    break;
+
+                case MillingCutter::Type::BullNose:
+                    model.SetCutterProfile(CutterProfile::BullNose(radius, radius / 4.f));
+                    break;
+
+                case MillingCutter::Type::Tapered:
+                    model.SetCutterProfile(CutterProfile::Tapered(radius, radius / 4.f, std::numbers::pi_v<float> / 6.f));
+                    break;
+
+                default:
+                    break;
+            }
+        }
 
-        default:
-            throw std::runtime_error("Unknown cutter type");
+        if (profile.GetType() == MillingCutter::Type::BullNose) {
+            float cornerRadius = profile.SecondaryRadius() * 100.f;
+            if (ImGui::DragFloat("Corner radius [mm]", &cornerRadius, 0.01f, 0.01f, radius * 100.f, "%.2f", ImGuiSliderFlags_AlwaysClamp))
+                model.SetCutterProfile(CutterProfile::BullNose(radius, cornerRadius / 100.f));
+        }
+
+        if (profile.GetType() == MillingCutter::Type::Tapered) {
+            float tipRadius = profile.SecondaryRadius() * 100.f;
+            float angle = profile.HalfAngle() * 180.f / std::numbers::pi_v<float>;
+
+            if (ImGui::DragFloat("Tip radius [mm]", &tipRadius, 0.01f, 0.f, radius * 99.f, "%.2f", ImGuiSliderFlags_AlwaysClamp))
+                model.SetCutterProfile(CutterProfile::Tapered(radius, tipRadius / 100.f, profile.HalfAngle()));
+
+            if (ImGui::DragFloat("Half angle [deg]", &angle, 0.1f, 1.f, 89.f, "%.1f", ImGuiSliderFlags_AlwaysClamp))
+                model.SetCutterProfile(CutterProfile::Tapered(radius, profile.SecondaryRadius(), angle * std::numbers::pi_v<float> / 180.f));
+        }
+
+        ImGui::EndDisabled();
     }
 
     ImGui::BeginDisabled(model.MillingMachineRuns());
@@ -176,6 +269,25 @@ void MillingSimulatorView::RenderWarnings() const
     else if (ImGui::Button("Clear warnings"))
         model.ClearMillingWarnings();
 
+    RenderWarningsList(warningsRepo);
+
+    ImGui::SeparatorText("Path validation");
+
+    ImGui::BeginDisabled(model.MillingMachineRuns() || model.InstantSimulationRuns());
+    if (ImGui::Button("Validate with actual material"))
+        model.ValidateMillingPath();
+    ImGui::EndDisabled();
+
+    auto const& validationRepo = model.GetValidationWarnings();
+    if (validationRepo.Empty())
+        ImGui::Text("No potential warnings");
+
+    RenderWarningsList(validationRepo);
+}
+
+
+void MillingSimulatorView::RenderWarningsList(const MillingWarningsRepo& warningsRepo)
+{
     for (const auto&[commandId, warningsTypes] : warningsRepo.GetWarnings()) {
         if (warningsTypes & MillingWarningsRepo::MillingStraightDown)
             ImGui::Text("Milling straight down during %d command", commandId);
@@ -491,6 +491,20 @@ void ModelerObjectsPropertiesView::DisplayGregoryPatchesParameters(const Entity
 
 bool ModelerObjectsPropertiesView::DisplayIntersectionCurveOptions(const Entity entity) const
 {
+    const auto& telemetry = model.GetComponent<IntersectionCurve>(entity).telemetry;
+
+    ImGui::SeparatorText("Intersection solvers");
+
+    ImGui::Text("Newton calls: %d (failed: %d)", telemetry.newtonCalls, telemetry.newtonFailures);
+    ImGui::Text("Newton iterations: %d", telemetry.newtonIterations);
+    ImGui::Text("Function evaluations: %d", telemetry.newtonFunctionEvaluations);
+    ImGui::Text("Jacobian evaluations: %d", telemetry.newtonJacobianEvaluations);
+
+    ImGui::Text("Gradient method calls: %d (failed: %d)", telemetry.gradientMethodCalls, telemetry.gradientMethodFailures);
+    ImGui::Text("Gradient method iterations: %d", telemetry.gradientMethodIterations);
+    ImGui::Text("Function evaluations: %d", telemetry.gradientMethodFunctionEvaluations);
+    ImGui::Text("Gradient evaluations: %d", telemetry.gradientMethodGradientEvaluations);
+
     if (ImGui::Button("Turn into interpolation curve")) {
         model.TurnIntersectionCurveToInterpolation(entity);
         return true;
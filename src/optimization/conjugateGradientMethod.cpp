@@ -2,7 +2,29 @@
 
 #include <optimization/utils.hpp>
 
-#include <iostream>
+
+namespace {
+    /// @brief Wrapper counting evaluations made by the method, the line search and the stop condition
+    class CountedFunction final : public opt::FunctionToOptimize {
+    public:
+        CountedFunction(FunctionToOptimize& fun, opt::SolverStats& stats):
+            fun(fun), stats(stats) {}
+
+        float Value(const std::vector<float> &args) override {
+            ++stats.functionEvaluations;
+            return fun.Value(args);
+        }
+
+        std::vector<float> Gradient(const std::vector<float> &args) override {
+            ++stats.gradientEvaluations;
+            return fun.Gradient(args);
+        }
+
+    private:
+        FunctionToOptimize& fun;
+        opt::SolverStats& stats;
+    };
+}
 
 
 std::optional<std::vector<float>> opt::ConjugateGradientMethod(
@@ -10,40 +32,62 @@ std::optional<std::vector<float>> opt::ConjugateGradientMethod(
     LineSearchMethod& lineSearch,
     const std::vector<float> &initSol,
     const unsigned int maxIt,
-    StopCondition& stopCondition
+    StopCondition& stopCondition,
+    SolverStats& stats
 ) {
+    stats = SolverStats();
+    CountedFunction countedFun(fun, stats);
+
     std::vector solution(initSol);
 
     // At first a search direction is equal to gradient with minus sign
-    std::vector<float> searchDir = fun.Gradient(solution);
-    for (float & i : searchDir)
-        i = -i;
+    std::vector<float> gradient = countedFun.Gradient(solution);
+    std::vector<float> searchDir(gradient.size());
+    for (size_t i=0; i < searchDir.size(); i++)
+        searchDir[i] = -gradient[i];
 
     for (unsigned int it = 0; it < maxIt; it++) {
-        std::cout << "It " << it << " conjugate\n";
+        stats.finalResidual = LengthSquared(gradient);
 
-        if (stopCondition.ShouldStop(fun, solution))
+        if (stopCondition.ShouldStop(countedFun, solution)) {
+            stats.terminationReason = TerminationReason::StopConditionMet;
             return solution;
+        }
 
-        const float step = lineSearch.Search(fun, solution, searchDir);
+        ++stats.iterations;
 
-        std::vector<float> oldSolution = solution;
+        const float step = lineSearch.Search(countedFun, solution, searchDir);
 
         // Update solution
         for (size_t i=0; i < solution.size(); i++)
             solution[i] += step * searchDir[i];
 
         // Update a search direction
-        
-        std::vector<float> oldGradient = fun.Gradient(oldSolution);
-        std::vector<float> newGradient = fun.Gradient(solution);
+        std::vector<float> newGradient = countedFun.Gradient(solution);
 
-        const float beta = LengthSquared(newGradient) / LengthSquared(oldGradient);
+        const float beta = LengthSquared(newGradient) / LengthSquared(gradient);
 
         for (size_t i=0; i < searchDir.size(); i++)
             searchDir[i] = -newGradient[i] + beta * searchDir[i];
-        
+
+        gradient = std::move(newGradient);
     }
 
+    stats.finalResidual = LengthSquared(gradient);
+    stats.terminationReason = TerminationReason::MaxIterationsExceeded;
+
     return std::nullopt;
 }
+
+
+std::optional<std::vector<float>> opt::ConjugateGradientMethod(
+    FunctionToOptimize& fun,
+    LineSearchMethod& lineSearch,
+    const std::vector<float> &initSol,
+    const unsigned int maxIt,
+    StopCondition& stopCondition
+) {
+    SolverStats stats;
+
+    return ConjugateGradientMethod(fun, lineSearch, initSol, maxIt, stopCondition, stats);
+}
@@ -1,32 +1,83 @@
 #include <rootFinding/newtonMethod.hpp>
 
-#include <iostream>
+#include <cmath>
 
 
 std::optional<alg::Vec4> root::NewtonMethod(
-    FunctionToFindRoot &fun, const alg::Vec4 &initSol, const  float eps, const int maxIter
+    FunctionToFindRoot &fun, const alg::Vec4 &initSol, const float eps, SolverStats& stats, const int maxIter,
+    const int maxBacktracks
 ) {
-    alg::Vec4 newSol = initSol;
-    int i = 0;
+    stats = SolverStats();
+
+    alg::Vec4 sol = initSol;
+
+    ++stats.functionEvaluations;
+    alg::Vec4 value = fun.Value(sol);
+    stats.finalResidual = value.LengthSquared();
 
     do {
-        if (++i > maxIter) {
-            std::cout << "Max iter excited" << std::endl;
+        if (stats.iterations >= maxIter) {
+            stats.terminationReason = TerminationReason::MaxIterationsExceeded;
             return std::nullopt;
         }
 
-        alg::Vec4 oldSol = newSol;
+        ++stats.iterations;
 
-        auto jacInv = fun.Jacobian(oldSol).Inverse();
-        if (!jacInv.has_value()) {
-            std::cout << "No jacobian inverse" << std::endl;
+        ++stats.jacobianEvaluations;
+        const auto step = fun.Jacobian(sol).Solve(value);
+        if (!step.has_value()) {
+            stats.terminationReason = TerminationReason::SingularJacobian;
             return std::nullopt;
         }
 
-        newSol = oldSol - fun.Value(oldSol) * jacInv.value();
+        const alg::Vec4 fullStepSol = sol - step.value();
+
+        ++stats.functionEvaluations;
+        const alg::Vec4 fullStepValue = fun.Value(fullStepSol);
+        const float fullStepResidual = fullStepValue.LengthSquared();
+
+        alg::Vec4 newSol = fullStepSol;
+        alg::Vec4 newValue = fullStepValue;
+        float newResidual = fullStepResidual;
+
+        // Damping the step while the residual grows. If none of the shorter
+        // steps helps, the full Newton step is taken.
+        float damping = 1.f;
+        for (int i = 0; i < maxBacktracks && newResidual > stats.finalResidual; ++i) {
+            damping /= 2.f;
+            ++stats.backtrackingSteps;
 
-        std::cout << i << " Function value: " << fun.Value(newSol) << " len sq: " << fun.Value(newSol).LengthSquared() << std::endl;
-    } while (fun.Value(newSol).LengthSquared() > eps);
+            newSol = sol - damping * step.value();
+
+            ++stats.functionEvaluations;
+            newValue = fun.Value(newSol);
+            newResidual = newValue.LengthSquared();
+        }
+
+        if (newResidual > stats.finalResidual) {
+            newSol = fullStepSol;
+            newValue = fullStepValue;
+            newResidual = fullStepResidual;
+        }
+
+        sol = newSol;
+        value = newValue;
+        stats.finalResidual = newResidual;
+    } while (stats.finalResidual > eps);
+
+    // NaN residual also ends the iteration. The solution is still returned,
+    // so the caller can inspect why the function could not be evaluated.
+    stats.terminationReason = std::isnan(stats.finalResidual) ?
+        TerminationReason::NonFiniteResidual : TerminationReason::Converged;
+
+    return sol;
+}
+
+
+std::optional<alg::Vec4> root::NewtonMethod(
+    FunctionToFindRoot &fun, const alg::Vec4 &initSol, const float eps, const int maxIter, const int maxBacktracks
+) {
+    SolverStats stats;
 
-    return newSol;
+    return NewtonMethod(fun, initSol, eps, stats, maxIter, maxBacktracks);
 }
@@ -46,8 +46,33 @@ TEST(ConjungateGradientMethodTests, SimpleFunctionToOptimize) {
     );
 
     ASSERT_TRUE(solution.has_value());
-    ASSERT_EQ(solution.value().size(), 2);
+    ASSERT_EQ(solution.value().size(), 2u);
 
     ASSERT_NEAR(solution.value()[0], 2.f, 0.1f);
     ASSERT_NEAR(solution.value()[1], 1.f, 0.1f);
 }
+
+
+TEST(ConjungateGradientMethodTests, StatisticsOfSimpleFunctionToOptimize) {
+    SimpleTestFunction function;
+    auto lineSearch = DichotomyLineSearch(0.f, 10.f, 1e-7);
+    auto stopCondition = SmallGradient(1e-5);
+    SolverStats stats;
+
+    const auto solution = ConjugateGradientMethod(
+        function,
+        lineSearch,
+        { 0, 3 },
+        1000,
+        stopCondition,
+        stats
+    );
+
+    ASSERT_TRUE(solution.has_value());
+
+    EXPECT_EQ(stats.terminationReason, TerminationReason::StopConditionMet);
+    EXPECT_GT(stats.iterations, 0);
+    EXPECT_GT(stats.functionEvaluations, 0);
+    EXPECT_GT(stats.gradientEvaluations, stats.iterations);
+    EXPECT_LT(stats.finalResidual, 1e-5);
+}
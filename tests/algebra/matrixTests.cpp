@@ -173,6 +173,51 @@ TEST(MatrixTests, MatrixInversion) {
 }
 
 
+TEST(MatrixTests, SolvingLinearSystem) {
+    const alg::Mat4x4 mat(
+        0.f, 5.f, 0.f, 8.f,
+        1.f, 4.f, 2.f, 6.f,
+        7.f, 8.f, 9.f, 3.f,
+        1.f, 5.f, 7.f, 8.f
+    );
+
+    const alg::Vec4 expected(1.f, -2.f, 3.f, 0.5f);
+    const alg::Vec4 constants = expected * mat;
+
+    const auto solution = mat.Solve(constants);
+
+    ASSERT_TRUE(solution.has_value());
+
+    for (int i=0; i < 4; i++) {
+        EXPECT_NEAR(solution.value()[i], expected[i], 0.001);
+    }
+
+    const auto inv = mat.Inverse();
+
+    ASSERT_TRUE(inv.has_value());
+
+    const alg::Vec4 invSolution = constants * inv.value();
+
+    for (int i=0; i < 4; i++) {
+        EXPECT_NEAR(solution.value()[i], invSolution[i], 0.001);
+    }
+}
+
+
+TEST(MatrixTests, SolvingSingularLinearSystem) {
+    const alg::Mat4x4 mat(
+        1.f, 2.f, 3.f, 4.f,
+        2.f, 4.f, 6.f, 8.f,
+        7.f, 8.f, 9.f, 3.f,
+        1.f, 5.f, 7.f, 8.f
+    );
+
+    const auto solution = mat.Solve(alg::Vec4(1.f));
+
+    EXPECT_FALSE(solution.has_value());
+}
+
+
 TEST(MatrixTests, FrustumMatrixComparison)
 {
     float near = 0.1f;
@@ -30,6 +30,32 @@ public:
 };
 
 
+class FourArcTangents final : public FunctionToFindRoot {
+public:
+    Vec4 Value(Vec4 args) override {
+        return {
+            std::atan(args.X()),
+            std::atan(args.Y()),
+            std::atan(args.Z()),
+            std::atan(args.W())
+        };
+    }
+
+    Mat4x4 Jacobian(Vec4 args) override {
+        return {
+            Derivative(args.X()), 0.f, 0.f, 0.f,
+            0.f, Derivative(args.Y()), 0.f, 0.f,
+            0.f, 0.f, Derivative(args.Z()), 0.f,
+            0.f, 0.f, 0.f, Derivative(args.W())
+        };
+    }
+
+private:
+    static float Derivative(const float x)
+        { return 1.f / (1.f + x*x); }
+};
+
+
 TEST(NewtonMethodTests, FourSameIndependentEquations) {
     FourSameIndependentEquations fun;
 
@@ -43,3 +69,53 @@ TEST(NewtonMethodTests, FourSameIndependentEquations) {
     EXPECT_NEAR(solution.value().Z(), -1.f, 1e-4);
     EXPECT_NEAR(solution.value().W(), -1.f, 1e-4);
 }
+
+
+TEST(NewtonMethodTests, StatisticsOfConvergedSolution) {
+    FourSameIndependentEquations fun;
+    SolverStats stats;
+
+    const Vec4 initSol(-20.f);
+    const auto solution = NewtonMethod(fun, initSol, 1e-5, stats);
+
+    ASSERT_TRUE(solution.has_value());
+
+    EXPECT_EQ(stats.terminationReason, TerminationReason::Converged);
+    EXPECT_GT(stats.iterations, 0);
+    EXPECT_EQ(stats.jacobianEvaluations, stats.iterations);
+    EXPECT_EQ(stats.functionEvaluations, stats.iterations + stats.backtrackingSteps + 1);
+    EXPECT_LE(stats.finalResidual, 1e-5);
+}
+
+
+TEST(NewtonMethodTests, StatisticsOfExceededIterations) {
+    FourSameIndependentEquations fun;
+    SolverStats stats;
+
+    const Vec4 initSol(-20.f);
+    const auto solution = NewtonMethod(fun, initSol, 1e-5, stats, 2);
+
+    ASSERT_FALSE(solution.has_value());
+
+    EXPECT_EQ(stats.terminationReason, TerminationReason::MaxIterationsExceeded);
+    EXPECT_EQ(stats.iterations, 2);
+}
+
+
+TEST(NewtonMethodTests, DampingPreventsDivergence) {
+    // Newton method without damping diverges for arc tangent started far from the root
+    FourArcTangents fun;
+    SolverStats stats;
+
+    const Vec4 initSol(3.f, -3.f, 2.f, -2.f);
+    const auto solution = NewtonMethod(fun, initSol, 1e-7, stats);
+
+    ASSERT_TRUE(solution.has_value());
+
+    EXPECT_GT(stats.backtrackingSteps, 0);
+
+    EXPECT_NEAR(solution.value().X(), 0.f, 1e-3);
+    EXPECT_NEAR(solution.value().Y(), 0.f, 1e-3);
+    EXPECT_NEAR(solution.value().Z(), 0.f, 1e-3);
+    EXPECT_NEAR(solution.value().W(), 0.f, 1e-3);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingPathsDesigner/cutterOffsetHeightMap.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+
+namespace
+{
+    constexpr float minusInfinity = -std::numeric_limits<float>::infinity();
+
+
+    BroadPhaseHeightMap RandomHeightMap(const size_t xResolution, const size_t zResolution, const float xSize, const float zSize)
+    {
+        BroadPhaseHeightMap heightMap(xResolution, zResolution, xSize, zSize);
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution distribution(0.f, 0.3f);
+
+        for (auto& height : heightMap)
+            height = distribution(generator);
+
+        return heightMap;
+    }
+
+
+    /// @brief X coordinates of the pixel centers in all the rows, which the cutter smaller than the height map can reach
+    std::vector<float> AllRowsXs(const BroadPhaseHeightMap& heightMap)
+    {
+        const int xResolution = static_cast<int>(heightMap.XResolution());
+        std::vector<float> xs;
+
+        for (int x = -xResolution; x < 2 * xResolution; ++x)
+            xs.push_back(heightMap.MinX() + (static_cast<float>(x) + 0.5f) * heightMap.PixelXLen());
+
+        return xs;
+    }
+
+
+    /// @brief Cutter placed over the pixel center scanning its whole footprint, with the same floating point expressions
+    float BruteForceMinCutterY(const BroadPhaseHeightMap& heightMap, const MillingCutter& cutter, const int x, const int z)
+    {
+        const float radiusSq = cutter.radius * cutter.radius;
+        float result = minusInfinity;
+
+        for (int sourceX = 0; sourceX < static_cast<int>(heightMap.XResolution()); ++sourceX) {
+            for (int sourceZ = 0; sourceZ < static_cast<int>(heightMap.ZResolution()); ++sourceZ) {
+                const float distX = static_cast<float>(std::abs(sourceX - x)) * heightMap.PixelXLen();
+                const float distZ = static_cast<float>(std::abs(sourceZ - z)) * heightMap.PixelZLen();
+                const float distSq = distX*distX + distZ*distZ;
+
+                if (distSq > radiusSq)
+                    continue;
+
+                const float cutterY = heightMap.ToFlatVec2D().At(sourceX, sourceZ) + -cutter.Profile().HeightAt(distSq);
+                result = std::max(result, cutterY);
+            }
+        }
+
+        return result;
+    }
+
+
+    void ExpectBruteForceResult(const BroadPhaseHeightMap& heightMap, const MillingCutter& cutter, const unsigned int threadsCnt)
+    {
+        const CutterOffsetHeightMap offsets(heightMap, cutter, AllRowsXs(heightMap), threadsCnt);
+
+        const int xResolution = static_cast<int>(heightMap.XResolution());
+        const int zResolution = static_cast<int>(heightMap.ZResolution());
+
+        // One pixel more on each side is beyond the cutter reach
+        for (int x = -offsets.PaddingX() - 1; x <= xResolution + offsets.PaddingX(); ++x) {
+            for (int z = -offsets.PaddingZ() - 1; z <= zResolution + offsets.PaddingZ(); ++z)
+                ASSERT_EQ(offsets.At(x, z), BruteForceMinCutterY(heightMap, cutter, x, z)) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(CutterOffsetHeightMapTests, FlatCutterMatchesBruteForce) {
+    const auto heightMap = RandomHeightMap(40, 53, 1.f, 1.5f);
+    const MillingCutter cutter(0.12f, MillingCutter::Type::Flat);
+
+    ExpectBruteForceResult(heightMap, cutter, 3);
+}
+
+
+TEST(CutterOffsetHeightMapTests, RoundCutterMatchesBruteForce) {
+    const auto heightMap = RandomHeightMap(47, 38, 1.2f, 1.f);
+    const MillingCutter cutter(0.15f, MillingCutter::Type::Round);
+
+    ExpectBruteForceResult(heightMap, cutter, 3);
+}
+
+
+TEST(CutterOffsetHeightMapTests, BullNoseAndTaperedCuttersMatchBruteForce) {
+    const auto heightMap = RandomHeightMap(45, 45, 1.f, 1.f);
+
+    ExpectBruteForceResult(heightMap, MillingCutter(CutterProfile::BullNose(0.13f, 0.05f)), 2);
+    ExpectBruteForceResult(heightMap, MillingCutter(CutterProfile::Tapered(0.13f, 0.02f, 0.6f)), 2);
+}
+
+
+TEST(CutterOffsetHeightMapTests, CutterSmallerThanPixelSeesOnlyItsPixel) {
+    const auto heightMap = RandomHeightMap(10, 10, 1.f, 1.f);
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Round);
+
+    const CutterOffsetHeightMap offsets(heightMap, cutter, AllRowsXs(heightMap));
+
+    EXPECT_EQ(offsets.PaddingX(), 0);
+    EXPECT_EQ(offsets.PaddingZ(), 0);
+
+    for (int x = 0; x < 10; ++x) {
+        for (int z = 0; z < 10; ++z)
+            EXPECT_EQ(offsets.At(x, z), heightMap.ToFlatVec2D().At(x, z));
+    }
+}
+
+
+TEST(CutterOffsetHeightMapTests, GlobalCoordinatesUseNearestPixel) {
+    const auto heightMap = RandomHeightMap(30, 30, 1.f, 1.f);
+    const MillingCutter cutter(0.1f, MillingCutter::Type::Round);
+
+    const CutterOffsetHeightMap offsets(heightMap, cutter, AllRowsXs(heightMap));
+
+    for (const float x : { -0.62f, -0.5f, -0.13f, 0.f, 0.27f, 0.55f }) {
+        for (const float z : { -0.58f, -0.21f, 0.04f, 0.49f, 0.6f }) {
+            const auto [pixelX, pixelZ] = heightMap.GlobalPosToXY(x, z);
+            EXPECT_EQ(offsets.MinCutterY(x, z), offsets.At(static_cast<int>(pixelX), static_cast<int>(pixelZ)));
+        }
+    }
+
+    EXPECT_EQ(offsets.MinCutterY(5.f, 0.f), minusInfinity);
+}
+
+
+TEST(CutterOffsetHeightMapTests, OnlyRowsUnderTheCutterAreComputed) {
+    const auto heightMap = RandomHeightMap(40, 40, 1.f, 1.f);
+    const MillingCutter cutter(0.1f, MillingCutter::Type::Round);
+
+    const CutterOffsetHeightMap allRows(heightMap, cutter, AllRowsXs(heightMap));
+
+    const std::vector cutterXs { -0.55f, -0.26f, 0.31f, 0.31f };
+    const CutterOffsetHeightMap someRows(heightMap, cutter, cutterXs, 2);
+
+    for (const float x : cutterXs) {
+        for (const float z : { -0.6f, -0.5f, 0.f, 0.18f, 0.54f })
+            EXPECT_EQ(someRows.MinCutterY(x, z), allRows.MinCutterY(x, z)) << "x = " << x << ", z = " << z;
+    }
+
+    EXPECT_THROW(std::ignore = someRows.MinCutterY(0.f, 0.f), std::invalid_argument);
+    EXPECT_EQ(someRows.MinCutterY(5.f, 0.f), minusInfinity);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/components/cutterProfile.hpp>
+
+#include <cmath>
+#include <numbers>
+
+
+TEST(CutterProfileTests, RoundAndFlatProfilesMatchTheirShapes) {
+    constexpr float radius = 0.08f;
+    const auto round = CutterProfile::Round(radius);
+    const auto flat = CutterProfile::Flat(radius);
+
+    for (float dist = 0.f; dist <= radius; dist += 0.001f) {
+        EXPECT_NEAR(round.HeightAt(dist * dist), radius - std::sqrt(radius*radius - dist*dist), 1e-5f);
+        EXPECT_EQ(flat.HeightAt(dist * dist), 0.f);
+    }
+
+    EXPECT_TRUE(std::isinf(round.HeightAt(0.081f * 0.081f)));
+    EXPECT_TRUE(std::isinf(flat.HeightAt(0.081f * 0.081f)));
+}
+
+
+TEST(CutterProfileTests, BullNoseProfileIsFlatInTheMiddle) {
+    const auto profile = CutterProfile::BullNose(0.08f, 0.03f);
+
+    EXPECT_EQ(profile.HeightAt(0.f), 0.f);
+    EXPECT_EQ(profile.HeightAt(0.05f * 0.05f), 0.f);
+    EXPECT_NEAR(profile.HeightAt(0.08f * 0.08f), 0.03f, 1e-5f);
+
+    // Point of the corner arc under 45 degrees
+    const float dist = 0.05f + 0.03f * std::numbers::sqrt2_v<float> / 2.f;
+    EXPECT_NEAR(profile.HeightAt(dist * dist), 0.03f - 0.03f * std::numbers::sqrt2_v<float> / 2.f, 1e-5f);
+}
+
+
+TEST(CutterProfileTests, TaperedProfileGrowsLinearly) {
+    const auto profile = CutterProfile::Tapered(0.08f, 0.02f, std::numbers::pi_v<float> / 6.f);
+    const float slope = std::sqrt(3.f);
+
+    EXPECT_EQ(profile.HeightAt(0.01f * 0.01f), 0.f);
+
+    for (float dist = 0.02f; dist <= 0.08f; dist += 0.005f)
+        EXPECT_NEAR(profile.HeightAt(dist * dist), (dist - 0.02f) * slope, 1e-5f);
+}
+
+
+TEST(CutterProfileTests, TableProfileInterpolatesPoints) {
+    std::vector<CutterProfile::Point> points { { 0.f, 0.f } };
+    for (int i = 1; i <= 2000; ++i) {
+        const float radius = 0.0001f * static_cast<float>(i);
+        points.push_back({ .radius = radius, .height = radius * radius });
+    }
+
+    const auto profile = CutterProfile::Table(points);
+
+    EXPECT_EQ(profile.Radius(), points.back().radius);
+    for (float dist = 0.f; dist <= 0.2f; dist += 0.00037f)
+        EXPECT_NEAR(profile.HeightAt(dist * dist), dist * dist, 1e-6f) << "dist = " << dist;
+}
+
+
+TEST(CutterProfileTests, InvalidProfilesAreRejected) {
+    EXPECT_THROW(auto profile = CutterProfile::Round(0.f), std::invalid_argument);
+    EXPECT_THROW(auto profile = CutterProfile::BullNose(0.05f, 0.06f), std::invalid_argument);
+    EXPECT_THROW(auto profile = CutterProfile::Tapered(0.05f, 0.01f, std::numbers::pi_v<float> / 2.f), std::invalid_argument);
+    EXPECT_THROW(auto profile = CutterProfile::Table({ { 0.f, 0.f } }), std::invalid_argument);
+    EXPECT_THROW(auto profile = CutterProfile::Table({ { 0.f, 0.1f }, { 0.1f, 0.1f } }), std::invalid_argument);
+    EXPECT_THROW(auto profile = CutterProfile::Table({ { 0.f, 0.f }, { 0.1f, 0.1f }, { 0.1f, 0.2f } }), std::invalid_argument);
+
+    // Concave profile
+    EXPECT_THROW(auto profile = CutterProfile::Table({ { 0.f, 0.f }, { 0.1f, 0.1f }, { 0.2f, 0.15f } }), std::invalid_argument);
+}
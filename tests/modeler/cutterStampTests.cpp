@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+
+#include <random>
+
+
+namespace
+{
+    constexpr int resolution = 200;
+    constexpr float materialLen = 1.5f;
+    constexpr float initHeight = 0.5f;
+
+
+    /// Mills the height map the same way, as the simulation did before introducing the stamp
+    void MillReference(MaterialHeightMap& heightMap, const MillingCutter& cutter, const alg::Vec3& cutterPos)
+    {
+        const float pixelXLen = heightMap.PixelXLen();
+        const float pixelZLen = heightMap.PixelZLen();
+
+        const int posPixelX = static_cast<int>(std::round((cutterPos.X() - heightMap.MinX()) / pixelXLen));
+        const int posPixelZ = static_cast<int>(std::round((cutterPos.Z() - heightMap.MinZ()) / pixelZLen));
+
+        const int radiusInPixelsX = static_cast<int>(std::ceil(cutter.radius / pixelXLen));
+        const int radiusInPixelsZ = static_cast<int>(std::ceil(cutter.radius / pixelZLen));
+
+        const Position pos(cutterPos);
+        MillingResult result;
+
+        for (int x = posPixelX - radiusInPixelsX; x <= posPixelX + radiusInPixelsX; x++) {
+            for (int z = posPixelZ - radiusInPixelsZ; z <= posPixelZ + radiusInPixelsZ; z++) {
+                if (x < 0 || x >= heightMap.XResolution() || z < 0 || z >= heightMap.ZResolution())
+                    continue;
+
+                const float cutterY = cutter.YCoordinate(pos, heightMap.GlobalX(x), heightMap.GlobalZ(z));
+                MillPixel(heightMap, x, z, cutterY, cutter.height, result);
+            }
+        }
+    }
+
+
+    void ExpectSameAsReference(const MillingCutter& cutter)
+    {
+        MaterialHeightMap reference(resolution, resolution, materialLen, materialLen, initHeight);
+        MaterialHeightMap stamped(resolution, resolution, materialLen, materialLen, initHeight);
+
+        const CutterStamp stamp(cutter, stamped.PixelXLen(), stamped.PixelZLen());
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> posDist(-0.8f, 0.8f);
+        std::uniform_real_distribution<float> heightDist(0.1f, 0.5f);
+
+        for (int i = 0; i < 500; ++i) {
+            const alg::Vec3 pos(posDist(gen), heightDist(gen), posDist(gen));
+
+            MillReference(reference, cutter, pos);
+            stamp.Mill(stamped, pos);
+        }
+
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x)
+                ASSERT_EQ(reference.HeightAt(x, z), stamped.HeightAt(x, z)) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(CutterStampTests, RoundCutterGivesSameHeightsAsReference) {
+    ExpectSameAsReference(MillingCutter(0.08f, MillingCutter::Type::Round));
+}
+
+
+TEST(CutterStampTests, FlatCutterGivesSameHeightsAsReference) {
+    ExpectSameAsReference(MillingCutter(0.05f, MillingCutter::Type::Flat));
+}
+
+
+TEST(CutterStampTests, BullNoseCutterGivesSameHeightsAsReference) {
+    ExpectSameAsReference(MillingCutter(CutterProfile::BullNose(0.08f, 0.03f)));
+}
+
+
+TEST(CutterStampTests, TaperedCutterGivesSameHeightsAsReference) {
+    ExpectSameAsReference(MillingCutter(CutterProfile::Tapered(0.06f, 0.01f, 0.5f)));
+}
+
+
+TEST(CutterStampTests, ReportsMillingBelowBaseAndTooDeep) {
+    MaterialHeightMap heightMap(resolution, resolution, materialLen, materialLen, initHeight);
+    heightMap.SetBaseLevel(0.2f);
+
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Flat, 0.1f);
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    const auto result = stamp.Mill(heightMap, alg::Vec3(0.f, 0.1f, 0.f));
+
+    EXPECT_TRUE(result.materialRemoved);
+    EXPECT_TRUE(result.underTheBase);
+    EXPECT_TRUE(result.tooDeep);
+
+    const auto secondResult = stamp.Mill(heightMap, alg::Vec3(0.f, 0.1f, 0.f));
+
+    EXPECT_FALSE(secondResult.materialRemoved);
+    EXPECT_FALSE(secondResult.underTheBase);
+    EXPECT_FALSE(secondResult.tooDeep);
+}
+
+
+TEST(CutterStampTests, MilledPixelsAreExactlyAtTheCutterHeight) {
+    // Heights, for which subtracting their difference from the old one rounds above the new one
+    constexpr float oldHeight = 0.275765598f;
+    constexpr float cutterY = 0.0741979405f;
+    ASSERT_NE(oldHeight - (oldHeight - cutterY), cutterY);
+
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Flat, 0.5f);
+
+    MaterialHeightMap stamped(resolution, resolution, materialLen, materialLen, oldHeight);
+    const CutterStamp stamp(cutter, stamped.PixelXLen(), stamped.PixelZLen());
+    stamp.Mill(stamped, alg::Vec3(0.f, cutterY, 0.f));
+
+    MaterialHeightMap milled(resolution, resolution, materialLen, materialLen, oldHeight);
+    MillingResult result;
+    MillPixel(milled, resolution / 2, resolution / 2, cutterY, cutter.height, result);
+
+    EXPECT_EQ(stamped.HeightAt(resolution / 2, resolution / 2), cutterY);
+    EXPECT_EQ(milled.HeightAt(resolution / 2, resolution / 2), cutterY);
+    EXPECT_TRUE(result.materialRemoved);
+
+    // Second pass at the same height removes nothing
+    EXPECT_FALSE(stamp.Mill(stamped, alg::Vec3(0.f, cutterY, 0.f)).materialRemoved);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/deviationAnalysis.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+
+#include "millingTestsCommon.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <stdexcept>
+
+
+using namespace millingTests;
+
+
+namespace
+{
+    /// @brief Dome in the middle of the material
+    TargetHeights DomeTarget()
+    {
+        TargetHeights target(resolution, resolution, materialLen, materialLen);
+
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x) {
+                const float u = (static_cast<float>(x) + 0.5f) / resolution * 2.f - 1.f;
+                const float v = (static_cast<float>(z) + 0.5f) / resolution * 2.f - 1.f;
+                target.SetHeightAt(x, z, 0.1f + 0.2f * std::max(1.f - u*u - v*v, 0.f));
+            }
+        }
+
+        return target;
+    }
+}
+
+
+TEST(DeviationAnalysisTests, CountsUndercutAndOvercutPixelsAndVolumes) {
+    MaterialHeightMap heightMap = Material();
+    const TargetHeights target(resolution, resolution, materialLen, materialLen, 0.3f);
+
+    // Left half milled exactly to the target, first rows of it below the target
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution / 2; ++x)
+            heightMap.ChangeHeightAt(x, z, z < 10 ? 0.225f : 0.3f);
+    }
+
+    const DeviationSettings settings { .tolerance = 0.001f, .histogramRange = 0.25f, .histogramBins = 10, .threadsCnt = 4 };
+    const auto report = AnalyzeDeviation(heightMap, target, initHeight, settings);
+
+    const size_t overcutPixels = 10 * resolution / 2;
+    const size_t undercutPixels = resolution * resolution / 2;
+    const double pixelArea = heightMap.PixelXLen() * heightMap.PixelZLen();
+
+    EXPECT_EQ(report.pixelsCnt, static_cast<size_t>(resolution * resolution));
+    EXPECT_EQ(report.undercutPixels, undercutPixels);
+    EXPECT_EQ(report.overcutPixels, overcutPixels);
+    EXPECT_FLOAT_EQ(report.maxUndercut, 0.2f);
+    EXPECT_NEAR(report.maxOvercut, 0.075f, 1e-6f);
+
+    EXPECT_NEAR(report.undercutVolume, undercutPixels * 0.2 * pixelArea, 1e-6);
+    EXPECT_NEAR(report.overcutVolume, overcutPixels * 0.075 * pixelArea, 1e-6);
+    EXPECT_NEAR(report.removedVolume, (undercutPixels - overcutPixels) * 0.2 * pixelArea + overcutPixels * 0.275 * pixelArea, 1e-5);
+    EXPECT_NEAR(report.rmsDeviation, std::sqrt((undercutPixels * 0.04 + overcutPixels * 0.005625) / report.pixelsCnt), 1e-6);
+
+    ASSERT_EQ(report.histogram.size(), 10u);
+    EXPECT_EQ(std::accumulate(report.histogram.begin(), report.histogram.end(), size_t{0}), report.pixelsCnt);
+    EXPECT_EQ(report.histogram[3], overcutPixels);
+    EXPECT_EQ(report.histogram[5], report.pixelsCnt - undercutPixels - overcutPixels);
+    EXPECT_EQ(report.histogram[9], undercutPixels);
+}
+
+
+TEST(DeviationAnalysisTests, ReportDoesNotDependOnThreadsCount) {
+    const auto path = RandomPath(80, 7);
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Round, 1.f);
+
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+    MillPath(TiledMiller(64, 2), heightMap, cutter, path, warnings);
+
+    const auto target = DomeTarget();
+
+    DeviationSettings settings;
+    settings.threadsCnt = 1;
+    const auto expected = AnalyzeDeviation(heightMap, target, initHeight, settings);
+
+    settings.threadsCnt = 8;
+    const auto report = AnalyzeDeviation(heightMap, target, initHeight, settings);
+
+    EXPECT_GT(expected.undercutPixels, 0u);
+    EXPECT_GT(expected.overcutPixels, 0u);
+
+    EXPECT_EQ(report.undercutPixels, expected.undercutPixels);
+    EXPECT_EQ(report.overcutPixels, expected.overcutPixels);
+    EXPECT_EQ(report.maxUndercut, expected.maxUndercut);
+    EXPECT_EQ(report.maxOvercut, expected.maxOvercut);
+    EXPECT_EQ(report.meanDeviation, expected.meanDeviation);
+    EXPECT_EQ(report.rmsDeviation, expected.rmsDeviation);
+    EXPECT_EQ(report.removedVolume, expected.removedVolume);
+    EXPECT_EQ(report.histogram, expected.histogram);
+}
+
+
+TEST(DeviationAnalysisTests, TargetHeightsFileRoundTrip) {
+    const auto target = DomeTarget();
+    const auto filePath = (std::filesystem::temp_directory_path() / "deviation_analysis_tests.thm").string();
+
+    target.Save(filePath);
+    const auto loaded = TargetHeights::Load(filePath);
+
+    EXPECT_EQ(loaded.XResolution(), resolution);
+    EXPECT_EQ(loaded.ZResolution(), resolution);
+    EXPECT_EQ(loaded.XLength(), materialLen);
+    EXPECT_EQ(loaded.ZLength(), materialLen);
+
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x)
+            ASSERT_EQ(loaded.HeightAt(x, z), target.HeightAt(x, z));
+    }
+
+    // Truncated file
+    std::filesystem::resize_file(filePath, 100);
+    EXPECT_THROW((void)TargetHeights::Load(filePath), std::invalid_argument);
+
+    std::filesystem::remove(filePath);
+}
+
+
+TEST(DeviationAnalysisTests, MismatchedGridsThrow) {
+    const MaterialHeightMap heightMap = Material();
+
+    EXPECT_THROW(
+        (void)AnalyzeDeviation(heightMap, TargetHeights(resolution, resolution / 2, materialLen, materialLen), initHeight),
+        std::invalid_argument
+    );
+
+    EXPECT_THROW(
+        (void)AnalyzeDeviation(heightMap, TargetHeights(resolution, resolution, materialLen, 1.f), initHeight),
+        std::invalid_argument
+    );
+}
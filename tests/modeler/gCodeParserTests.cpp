@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/gCodeParser.hpp>
+
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+    void ExpectDestination(const MoveCommand& command, const int id, const float gCodeX, const float gCodeY, const float gCodeZ)
+    {
+        EXPECT_EQ(command.id, id);
+
+        // G-code X, Y and Z axes are the modeler Z, X and Y axes
+        EXPECT_FLOAT_EQ(command.destination.GetX(), gCodeY);
+        EXPECT_FLOAT_EQ(command.destination.GetY(), gCodeZ);
+        EXPECT_FLOAT_EQ(command.destination.GetZ(), gCodeX);
+    }
+
+
+    std::string ErrorMessage(const std::string_view gCode)
+    {
+        try {
+            GCodeParser parser(1.f);
+            auto path = parser.Parse(gCode);
+        }
+        catch (const std::invalid_argument& e) {
+            return e.what();
+        }
+
+        return {};
+    }
+}
+
+
+TEST(GCodeParserTests, ParsingProgramWithCrLf) {
+    constexpr std::string_view gCode =
+        "%G71\r\n"
+        "N3G40G90\r\n"
+        "N4S10000M03\r\n"
+        "N5G01X0.000Y-1.500Z66.000\r\n"
+        "N6G01X10.000Y-1.500Z60.000\r\n";
+
+    GCodeParser parser(1.f);
+    const auto path = parser.Parse(gCode);
+
+    ASSERT_EQ(path.Size(), 2u);
+    ExpectDestination(path.Commands()[0], 5, 0.f, -1.5f, 66.f);
+    ExpectDestination(path.Commands()[1], 6, 10.f, -1.5f, 60.f);
+}
+
+
+TEST(GCodeParserTests, MissingCoordinatesAreTakenFromPreviousMove) {
+    constexpr std::string_view gCode =
+        "N1G01X1.0Y2.0Z3.0\n"
+        "N2G01Y5.0\n"
+        "N3G01X7.0Z8.0\n";
+
+    GCodeParser parser(1.f);
+    const auto path = parser.Parse(gCode);
+
+    ASSERT_EQ(path.Size(), 3u);
+    ExpectDestination(path.Commands()[0], 1, 1.f, 2.f, 3.f);
+    ExpectDestination(path.Commands()[1], 2, 1.f, 5.f, 3.f);
+    ExpectDestination(path.Commands()[2], 3, 7.f, 5.f, 8.f);
+}
+
+
+TEST(GCodeParserTests, WordsInAnyOrderAndModalMotion) {
+    constexpr std::string_view gCode =
+        "N1 Z3 Y2 X1 G00 ; rapid move\n"
+        "(comment line)\n"
+        "X4.5 N2\n"
+        "n3 g1 x+6 y-.5\n";
+
+    GCodeParser parser(1.f);
+    const auto path = parser.Parse(gCode);
+
+    ASSERT_EQ(path.Size(), 3u);
+    ExpectDestination(path.Commands()[0], 1, 1.f, 2.f, 3.f);
+    ExpectDestination(path.Commands()[1], 2, 4.5f, 2.f, 3.f);
+    ExpectDestination(path.Commands()[2], 3, 6.f, -0.5f, 3.f);
+}
+
+
+TEST(GCodeParserTests, CoordinatesAreScaled) {
+    GCodeParser parser(0.01f);
+    const auto path = parser.Parse("N1G01X100.0Y-50.0Z20.0");
+
+    ASSERT_EQ(path.Size(), 1u);
+    ExpectDestination(path.Commands()[0], 1, 1.f, -0.5f, 0.2f);
+}
+
+
+TEST(GCodeParserTests, LineWithoutIdUsesLineNumber) {
+    GCodeParser parser(1.f);
+    const auto path = parser.Parse("%\nG01X1Y2Z3\n");
+
+    ASSERT_EQ(path.Size(), 1u);
+    EXPECT_EQ(path.Commands()[0].id, 2);
+}
+
+
+TEST(GCodeParserTests, ErrorsContainLineNumber) {
+    EXPECT_NE(ErrorMessage("N1G01X1Y2Z3\nN2G01X#\n").find("line 2"), std::string::npos);
+    EXPECT_NE(ErrorMessage("N1G01X1Y2Z3\n\nN3G01X1Y2Z3?\n").find("line 3"), std::string::npos);
+    EXPECT_NE(ErrorMessage("N1G01X1Y2\n").find("line 1"), std::string::npos);
+    EXPECT_NE(ErrorMessage("N1X1Y2Z3\n").find("line 1"), std::string::npos);
+    EXPECT_NE(ErrorMessage("N1G01X1Y2Z3 (comment\n").find("line 1"), std::string::npos);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/gCodeWriter.hpp>
+#include <CAD_modeler/model/millingMachineSim/gCodeParser.hpp>
+
+#include <sstream>
+#include <stdexcept>
+
+
+TEST(GCodeWriterTests, WritingOnlyChangedCoordinates) {
+    MillingMachinePath path;
+    path.AddCommand(3, 0.f, 0.66f, 0.f);
+    path.AddCommand(4, 0.1f, 0.66f, 0.f);
+    path.AddCommand(5, 0.1f, 0.66f, 0.f);
+    path.AddCommand(6, 0.1f, 0.2f, -0.015f);
+
+    std::ostringstream out;
+    GCodeWriter writer(0.01f);
+    writer.Write(path, out);
+
+    EXPECT_EQ(out.str(),
+        "N3G01X0.000Y0.000Z66.000\r\n"
+        "N4G01Y10.000\r\n"
+        "N5G01X-1.500Z20.000\r\n"
+    );
+}
+
+
+TEST(GCodeWriterTests, TooBigCoordinateIsNotWritten) {
+    MillingMachinePath path;
+    path.AddCommand(1, 0.f, 0.66f, 0.f);
+    path.AddCommand(2, 1e30f, 0.66f, 0.f);
+
+    std::ostringstream out;
+    GCodeWriter writer(0.01f);
+
+    EXPECT_THROW(writer.Write(path, out), std::invalid_argument);
+}
+
+
+TEST(GCodeWriterTests, WrittenPathIsParsedBack) {
+    MillingMachinePath path;
+    for (int i = 0; i < 5000; ++i)
+        path.AddCommand(i + 1, 0.001f * static_cast<float>(i % 97), 0.1f + 0.0001f * static_cast<float>(i % 13), -0.002f * static_cast<float>(i % 31));
+
+    std::ostringstream out;
+    GCodeWriter writer(0.01f);
+    writer.Write(path, out);
+
+    GCodeParser parser(0.01f);
+    const auto parsed = parser.Parse(out.str());
+
+    ASSERT_EQ(parsed.Size(), path.Size());
+    for (size_t i = 0; i < path.Size(); ++i) {
+        EXPECT_EQ(parsed.Commands()[i].id, path.Commands()[i].id);
+        EXPECT_NEAR(parsed.Commands()[i].destination.GetX(), path.Commands()[i].destination.GetX(), 1e-5f);
+        EXPECT_NEAR(parsed.Commands()[i].destination.GetY(), path.Commands()[i].destination.GetY(), 1e-5f);
+        EXPECT_NEAR(parsed.Commands()[i].destination.GetZ(), path.Commands()[i].destination.GetZ(), 1e-5f);
+    }
+}
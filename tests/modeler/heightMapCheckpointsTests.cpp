@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/heightMapCheckpoints.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+
+#include "millingTestsCommon.hpp"
+
+#include <vector>
+
+
+using namespace millingTests;
+
+
+namespace
+{
+    constexpr size_t interval = 25;
+
+
+    std::vector<float> MilledUpTo(const MillingMachinePath& path, const MillingCutter& cutter, const size_t endCommand)
+    {
+        MaterialHeightMap heightMap = Material();
+        MillingWarningsRepo warnings;
+        warnings.Reset(path);
+
+        MillPath(TiledMiller(64, 2), heightMap, cutter, path, warnings, 1, endCommand);
+
+        return Heights(heightMap);
+    }
+}
+
+
+TEST(HeightMapCheckpointsTests, RestoredCheckpointsMatchMillingFromScratch) {
+    const auto path = RandomPath(120, 11);
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Round, 1.f);
+    const TiledMiller miller(64, 2);
+
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+
+    HeightMapCheckpoints checkpoints(interval, 1e9);
+    checkpoints.Reset(heightMap, 1);
+
+    for (size_t command = 1; command < path.Size(); command += interval) {
+        const size_t end = command + interval;
+        MillPath(miller, heightMap, cutter, path, warnings, command, end);
+
+        if (end < path.Size())
+            checkpoints.Take(heightMap, end, 0.0);
+    }
+
+    ASSERT_EQ(checkpoints.CheckpointsCnt(), 5u);
+
+    // Restoring drops the later checkpoints, so they are restored from the last one
+    for (size_t idx = checkpoints.CheckpointsCnt(); idx-- > 0;) {
+        const size_t command = checkpoints.CheckpointCommand(idx);
+        const auto restored = checkpoints.Restore(heightMap, command + interval / 2);
+
+        ASSERT_EQ(restored.command, command);
+        ASSERT_EQ(Heights(heightMap), MilledUpTo(path, cutter, command)) << "command = " << command;
+        EXPECT_EQ(heightMap.MinHeight(heightMap.Bounds()), std::ranges::min(Heights(heightMap)));
+    }
+
+    EXPECT_EQ(checkpoints.CheckpointsCnt(), 1u);
+}
+
+
+TEST(HeightMapCheckpointsTests, MemoryBudgetMergesCheckpoints) {
+    const auto path = RandomPath(200, 11);
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Flat, 1.f);
+    const TiledMiller miller(64, 2);
+
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+
+    constexpr size_t budget = 400 * 1024;
+    HeightMapCheckpoints checkpoints(interval, 1e9, budget);
+    checkpoints.Reset(heightMap, 1);
+
+    for (size_t command = 1; command + interval < path.Size(); command += interval) {
+        MillPath(miller, heightMap, cutter, path, warnings, command, command + interval);
+        checkpoints.Take(heightMap, command + interval, 0.0);
+
+        EXPECT_TRUE(checkpoints.MemoryUsage() <= budget || checkpoints.CheckpointsCnt() == 2);
+    }
+
+    EXPECT_LT(checkpoints.CheckpointsCnt(), (path.Size() - 1) / interval + 1);
+
+    const auto restored = checkpoints.Restore(heightMap, 100);
+    EXPECT_LE(restored.command, 100u);
+    EXPECT_EQ(Heights(heightMap), MilledUpTo(path, cutter, restored.command));
+}
+
+
+TEST(HeightMapCheckpointsTests, SavesOnlyChangedTilesAndFlatTilesAsSingleValue) {
+    MaterialHeightMap heightMap = Material();
+
+    HeightMapCheckpoints checkpoints;
+    checkpoints.Reset(heightMap, 1);
+    const size_t emptyUsage = checkpoints.MemoryUsage();
+
+    // Whole tile milled flat
+    const PixelRect tile = heightMap.TileRect(1, 2);
+    for (int z = tile.minZ; z < tile.maxZ; ++z) {
+        for (int x = tile.minX; x < tile.maxX; ++x)
+            heightMap.ChangeHeightAt(x, z, 0.2f);
+    }
+    heightMap.MarkChanged(tile);
+
+    checkpoints.Take(heightMap, 10, 0.0);
+    const size_t flatUsage = checkpoints.MemoryUsage() - emptyUsage;
+    EXPECT_LT(flatUsage, 64u);
+
+    heightMap.ChangeHeightAt(tile.minX, tile.minZ, 0.1f);
+    heightMap.MarkChanged({ .minX = tile.minX, .minZ = tile.minZ, .maxX = tile.minX + 1, .maxZ = tile.minZ + 1 });
+
+    checkpoints.Take(heightMap, 20, 0.0);
+    const size_t fullTile = MaterialHeightMap::tileSize * MaterialHeightMap::tileSize * sizeof(float);
+    EXPECT_GE(checkpoints.MemoryUsage() - emptyUsage - flatUsage, fullTile);
+    EXPECT_LT(checkpoints.MemoryUsage() - emptyUsage - flatUsage, fullTile + 64u);
+
+    checkpoints.Restore(heightMap, 15);
+    EXPECT_EQ(heightMap.HeightAt(tile.minX, tile.minZ), 0.2f);
+    EXPECT_EQ(heightMap.HeightAt(tile.maxX - 1, tile.maxZ - 1), 0.2f);
+    EXPECT_EQ(heightMap.HeightAt(0, 0), initHeight);
+    EXPECT_FALSE(heightMap.IsTileMaterialized(0, 0));
+}
+
+
+TEST(HeightMapCheckpointsTests, CheckpointIsDueAfterIntervals) {
+    MaterialHeightMap heightMap = Material();
+
+    HeightMapCheckpoints checkpoints(100, 5.0);
+    EXPECT_FALSE(checkpoints.Due(1000, 1000.0));
+
+    checkpoints.Reset(heightMap, 1);
+
+    EXPECT_FALSE(checkpoints.Due(50, 1.0));
+    EXPECT_TRUE(checkpoints.Due(101, 1.0));
+    EXPECT_TRUE(checkpoints.Due(50, 5.0));
+
+    checkpoints.Take(heightMap, 50, 5.0);
+    EXPECT_FALSE(checkpoints.Due(50, 20.0));
+    EXPECT_FALSE(checkpoints.Due(100, 9.0));
+    EXPECT_TRUE(checkpoints.Due(150, 9.0));
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/heightMapLod.hpp>
+
+#include <vector>
+
+
+namespace
+{
+    constexpr int resolution = 1000;
+    constexpr float length = 1.5f;
+    constexpr float thickness = 0.5f;
+
+
+    /// @brief Number of patches covering each pixel of the height map
+    std::vector<int> Coverage(const MaterialHeightMap& heightMap, const std::vector<PixelRect>& patches)
+    {
+        std::vector<int> coverage(heightMap.XResolution() * heightMap.ZResolution(), 0);
+
+        for (const auto& patch : patches) {
+            const PixelRect inside = patch.Intersection(heightMap.Bounds());
+
+            for (int z = inside.minZ; z < inside.maxZ; ++z) {
+                for (int x = inside.minX; x < inside.maxX; ++x)
+                    ++coverage[z * heightMap.XResolution() + x];
+            }
+        }
+
+        return coverage;
+    }
+}
+
+
+TEST(HeightMapLodTests, PatchesCoverHeightMapOnce) {
+    MaterialHeightMap heightMap(resolution, 700, length, length, thickness);
+    HeightMapLod lod;
+
+    const auto& patches = lod.SelectPatches(heightMap, heightMap.Pyramid(), alg::Vec3(0.1f, 0.6f, -0.3f));
+
+    for (const int cnt : Coverage(heightMap, patches))
+        ASSERT_EQ(cnt, 1);
+}
+
+
+TEST(HeightMapLodTests, PatchUnderCameraHasFinestDetail) {
+    MaterialHeightMap heightMap(resolution, resolution, length, length, thickness);
+    HeightMapLod lod;
+
+    const alg::Vec3 cameraPos(0.f, thickness + 0.01f, 0.f);
+    const auto& patches = lod.SelectPatches(heightMap, heightMap.Pyramid(), cameraPos);
+
+    const int x = static_cast<int>((cameraPos.X() - heightMap.MinX()) / heightMap.PixelXLen());
+    const int z = static_cast<int>((cameraPos.Z() - heightMap.MinZ()) / heightMap.PixelZLen());
+
+    bool found = false;
+    for (const auto& patch : patches) {
+        if (patch.minX <= x && x < patch.maxX && patch.minZ <= z && z < patch.maxZ) {
+            EXPECT_EQ(patch.Width(), HeightMapLod::patchCells);
+            found = true;
+        }
+    }
+
+    EXPECT_TRUE(found);
+}
+
+
+TEST(HeightMapLodTests, DistantCameraGetsSinglePatch) {
+    MaterialHeightMap heightMap(resolution, resolution, length, length, thickness);
+    HeightMapLod lod;
+
+    const auto& patches = lod.SelectPatches(heightMap, heightMap.Pyramid(), alg::Vec3(0.f, 100.f, 0.f));
+
+    ASSERT_EQ(patches.size(), 1u);
+    EXPECT_GE(patches.front().Width(), resolution);
+}
+
+
+TEST(HeightMapLodTests, PatchesCountGrowsSlowerThanResolution) {
+    MaterialHeightMap small(resolution, resolution, length, length, thickness);
+    MaterialHeightMap large(4 * resolution, 4 * resolution, length, length, thickness);
+    HeightMapLod lod;
+
+    const alg::Vec3 cameraPos(0.3f, 1.f, 1.2f);
+
+    const size_t smallCnt = lod.SelectPatches(small, small.Pyramid(), cameraPos).size();
+    const size_t largeCnt = lod.SelectPatches(large, large.Pyramid(), cameraPos).size();
+
+    // Full resolution grid would need 16 times more quads
+    EXPECT_LT(largeCnt, 4 * smallCnt);
+}
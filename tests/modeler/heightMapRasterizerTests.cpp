@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingPathsDesigner/heightMapRasterizer.hpp>
+
+#include <cmath>
+#include <numbers>
+
+
+using namespace interSys;
+
+
+namespace
+{
+    constexpr float mapLen = 2.f;
+
+
+    /// @brief Plane y = h + a*x + b*z over the square [-s, s]^2
+    class SlopedPlane final : public Surface {
+    public:
+        SlopedPlane(const float size, const float height, const float a, const float b):
+            size(size), height(height), a(a), b(b) {}
+
+        alg::Vec3 PointOnSurface(const float u, const float v) override {
+            const float x = (2.f * u - 1.f) * size;
+            const float z = (2.f * v - 1.f) * size;
+
+            return { x, height + a * x + b * z, z };
+        }
+
+        alg::Vec3 PartialDerivativeU(float, float) override
+            { return { 2.f * size, 2.f * size * a, 0.f }; }
+
+        alg::Vec3 PartialDerivativeV(float, float) override
+            { return { 0.f, 2.f * size * b, 2.f * size }; }
+
+        float MaxU() override { return 1.f; }
+        float MinU() override { return 0.f; }
+        float MaxV() override { return 1.f; }
+        float MinV() override { return 0.f; }
+
+    private:
+        float size, height, a, b;
+    };
+
+
+    /// @brief Upper half of the unit sphere centered in the origin, parametrized by the spherical angles
+    class Dome final : public Surface {
+    public:
+        alg::Vec3 PointOnSurface(const float u, const float v) override {
+            const float azimuth = u * 2.f * std::numbers::pi_v<float>;
+            const float polar = v * std::numbers::pi_v<float> / 2.f;
+
+            return { std::sin(polar) * std::cos(azimuth), std::cos(polar), std::sin(polar) * std::sin(azimuth) };
+        }
+
+        alg::Vec3 PartialDerivativeU(float, float) override
+            { return {}; }
+
+        alg::Vec3 PartialDerivativeV(float, float) override
+            { return {}; }
+
+        float MaxU() override { return 1.f; }
+        float MinU() override { return 0.f; }
+        float MaxV() override { return 1.f; }
+        float MinV() override { return 0.f; }
+    };
+}
+
+
+TEST(HeightMapRasterizerTests, PlaneHeightsAreInterpolatedExactly) {
+    SlopedPlane plane(0.5f, 0.3f, 0.2f, -0.1f);
+
+    HeightMapRasterizer rasterizer;
+    rasterizer.AddSurface(plane, 3);
+
+    BroadPhaseHeightMap heightMap(200, 150, mapLen, mapLen);
+    rasterizer.Render(heightMap);
+
+    for (size_t x = 0; x < heightMap.XResolution(); ++x) {
+        for (size_t z = 0; z < heightMap.ZResolution(); ++z) {
+            const float globalX = heightMap.MinX() + (static_cast<float>(x) + 0.5f) * heightMap.PixelXLen();
+            const float globalZ = heightMap.MinZ() + (static_cast<float>(z) + 0.5f) * heightMap.PixelZLen();
+
+            const float height = heightMap.ToFlatVec2D().At(x, z);
+
+            // Pixels on the plane border might be covered or not
+            if (std::abs(std::abs(globalX) - 0.5f) < 1e-4f || std::abs(std::abs(globalZ) - 0.5f) < 1e-4f)
+                continue;
+
+            if (std::abs(globalX) < 0.5f && std::abs(globalZ) < 0.5f)
+                EXPECT_NEAR(height, 0.3f + 0.2f * globalX - 0.1f * globalZ, 1e-5f) << "x = " << x << ", z = " << z;
+            else
+                EXPECT_EQ(height, 0.f) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(HeightMapRasterizerTests, HighestSurfaceIsKept) {
+    Dome dome;
+    SlopedPlane plane(0.8f, 0.5f, 0.f, 0.f);
+
+    HeightMapRasterizer rasterizer;
+    rasterizer.AddSurface(dome, 256);
+    rasterizer.AddSurface(plane, 1);
+
+    BroadPhaseHeightMap heightMap(300, 300, mapLen, mapLen);
+    rasterizer.Render(heightMap);
+
+    for (size_t x = 0; x < heightMap.XResolution(); x += 7) {
+        for (size_t z = 0; z < heightMap.ZResolution(); z += 7) {
+            const float globalX = heightMap.MinX() + (static_cast<float>(x) + 0.5f) * heightMap.PixelXLen();
+            const float globalZ = heightMap.MinZ() + (static_cast<float>(z) + 0.5f) * heightMap.PixelZLen();
+
+            const float distSq = globalX*globalX + globalZ*globalZ;
+            if (std::abs(globalX) >= 0.8f || std::abs(globalZ) >= 0.8f || distSq >= 0.95f)
+                continue;
+
+            const float expected = std::max(std::sqrt(1.f - distSq), 0.5f);
+            EXPECT_NEAR(heightMap.ToFlatVec2D().At(x, z), expected, 2e-3f) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(HeightMapRasterizerTests, ResultDoesNotDependOnThreadsAndTiles) {
+    Dome dome;
+
+    HeightMapRasterizer singleThreaded(1, 1000);
+    singleThreaded.AddSurface(dome, 64);
+
+    HeightMapRasterizer parallel(4, 16);
+    parallel.AddSurface(dome, 64);
+
+    EXPECT_EQ(singleThreaded.TrianglesCnt(), parallel.TrianglesCnt());
+
+    BroadPhaseHeightMap expected(250, 270, mapLen, mapLen);
+    BroadPhaseHeightMap actual(250, 270, mapLen, mapLen);
+
+    singleThreaded.Render(expected);
+    parallel.Render(actual);
+
+    for (size_t x = 0; x < expected.XResolution(); ++x) {
+        for (size_t z = 0; z < expected.ZResolution(); ++z)
+            ASSERT_EQ(expected.ToFlatVec2D().At(x, z), actual.ToFlatVec2D().At(x, z)) << "x = " << x << ", z = " << z;
+    }
+}
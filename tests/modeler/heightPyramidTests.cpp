@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/heightPyramid.hpp>
+
+#include <random>
+
+
+namespace
+{
+    constexpr int tilesX = 11;
+    constexpr int tilesZ = 6;
+}
+
+
+TEST(HeightPyramidTests, ResetBuildsLevelsUpToSingleCell) {
+    HeightPyramid pyramid;
+    pyramid.Reset(tilesX, tilesZ, 0.5f);
+
+    ASSERT_EQ(pyramid.LevelsCnt(), 5);
+
+    const auto& top = pyramid.Cell(pyramid.LevelsCnt() - 1, 0, 0);
+    EXPECT_EQ(top.min, 0.5f);
+    EXPECT_EQ(top.max, 0.5f);
+}
+
+
+TEST(HeightPyramidTests, RangeOfTilesMatchesBruteForce) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> heightDist(0.f, 1.f);
+
+    HeightPyramid pyramid;
+    pyramid.Reset(tilesX, tilesZ, 0.5f);
+
+    std::vector<HeightRange> tiles(tilesX * tilesZ, { .min = 0.5f, .max = 0.5f });
+
+    for (int i = 0; i < 200; ++i) {
+        const int tileX = static_cast<int>(gen() % tilesX);
+        const int tileZ = static_cast<int>(gen() % tilesZ);
+
+        const float first = heightDist(gen);
+        const float second = heightDist(gen);
+        const HeightRange range { .min = std::min(first, second), .max = std::max(first, second) };
+
+        pyramid.SetTile(tileX, tileZ, range);
+        tiles[tileZ*tilesX + tileX] = range;
+
+        const int minX = static_cast<int>(gen() % tilesX);
+        const int minZ = static_cast<int>(gen() % tilesZ);
+        const PixelRect rect {
+            .minX = minX,
+            .minZ = minZ,
+            .maxX = minX + 1 + static_cast<int>(gen() % (tilesX - minX)),
+            .maxZ = minZ + 1 + static_cast<int>(gen() % (tilesZ - minZ))
+        };
+
+        HeightRange expected;
+        for (int z = rect.minZ; z < rect.maxZ; ++z) {
+            for (int x = rect.minX; x < rect.maxX; ++x)
+                expected |= tiles[z*tilesX + x];
+        }
+
+        const HeightRange actual = pyramid.RangeOfTiles(rect);
+        ASSERT_EQ(actual.min, expected.min) << "iteration " << i;
+        ASSERT_EQ(actual.max, expected.max) << "iteration " << i;
+    }
+}
+
+
+TEST(HeightPyramidTests, EmptyRectGivesEmptyRange) {
+    HeightPyramid pyramid;
+    pyramid.Reset(tilesX, tilesZ, 0.5f);
+
+    EXPECT_TRUE(pyramid.RangeOfTiles({ .minX = 3, .minZ = 2, .maxX = 3, .maxZ = 5 }).Empty());
+}
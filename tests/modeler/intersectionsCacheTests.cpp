@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/systems/intersectionSystem/intersectionsCache.hpp>
+
+
+using namespace interSys;
+
+
+namespace
+{
+    IntersectionsCache::Key MakeKey(const Entity surface1, const Entity surface2, const size_t hash1, const size_t hash2)
+    {
+        return {
+            .surface1 = surface1,
+            .surface2 = surface2,
+            .surface1Hash = hash1,
+            .surface2Hash = hash2,
+            .step = 0.01f,
+            .guidance = std::nullopt,
+            .selfIntersection = false
+        };
+    }
+
+
+    IntersectionsCache::Entry MakeEntry()
+    {
+        return {
+            .points = { IntersectionPoint(0.f, 0.f, 1.f, 1.f), IntersectionPoint(0.5f, 0.5f, 0.2f, 0.1f) },
+            .isOpen = true
+        };
+    }
+}
+
+
+TEST(IntersectionsCacheTests, FindingInsertedEntry) {
+    IntersectionsCache cache;
+    cache.Insert(MakeKey(0, 1, 1, 2), MakeEntry());
+
+    const auto entry = cache.Find(MakeKey(0, 1, 1, 2));
+
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->points.size(), 2u);
+    EXPECT_TRUE(entry->isOpen);
+}
+
+
+TEST(IntersectionsCacheTests, KeysDifferingInParameters) {
+    IntersectionsCache cache;
+    cache.Insert(MakeKey(0, 1, 1, 2), MakeEntry());
+
+    auto otherStep = MakeKey(0, 1, 1, 2);
+    otherStep.step = 0.02f;
+
+    auto withGuidance = MakeKey(0, 1, 1, 2);
+    withGuidance.guidance = alg::Vec3(1.f, 2.f, 3.f);
+
+    EXPECT_EQ(cache.Find(MakeKey(1, 0, 2, 1)), nullptr);
+    EXPECT_EQ(cache.Find(MakeKey(0, 2, 1, 2)), nullptr);
+    EXPECT_EQ(cache.Find(otherStep), nullptr);
+    EXPECT_EQ(cache.Find(withGuidance), nullptr);
+}
+
+
+TEST(IntersectionsCacheTests, ChangedSurfaceInvalidatesEntries) {
+    constexpr Entity surface1 = 0;
+    constexpr Entity surface2 = 1;
+
+    IntersectionsCache cache;
+    cache.UpdateSurfaceHash(surface1, 10);
+    cache.UpdateSurfaceHash(surface2, 20);
+    cache.Insert(MakeKey(surface1, surface2, 10, 20), MakeEntry());
+    cache.Insert(MakeKey(surface2, surface2, 20, 20), MakeEntry());
+
+    cache.UpdateSurfaceHash(surface1, 10);
+    EXPECT_EQ(cache.Size(), 2u);
+
+    cache.UpdateSurfaceHash(surface1, 11);
+    EXPECT_EQ(cache.Size(), 1u);
+    EXPECT_EQ(cache.Find(MakeKey(surface1, surface2, 10, 20)), nullptr);
+    EXPECT_NE(cache.Find(MakeKey(surface2, surface2, 20, 20)), nullptr);
+}
+
+
+TEST(IntersectionsCacheTests, SurfacesWithTheSameGeometryDoNotShareEntries) {
+    constexpr Entity surface1 = 0;
+    constexpr Entity surface2 = 1;
+    constexpr Entity surface3 = 2;
+
+    IntersectionsCache cache;
+    cache.UpdateSurfaceHash(surface1, 10);
+    cache.UpdateSurfaceHash(surface2, 10);
+    cache.UpdateSurfaceHash(surface3, 20);
+    cache.Insert(MakeKey(surface1, surface3, 10, 20), MakeEntry());
+    cache.Insert(MakeKey(surface2, surface3, 10, 20), MakeEntry());
+
+    EXPECT_EQ(cache.Size(), 2u);
+
+    cache.UpdateSurfaceHash(surface1, 11);
+    EXPECT_EQ(cache.Find(MakeKey(surface1, surface3, 10, 20)), nullptr);
+    EXPECT_NE(cache.Find(MakeKey(surface2, surface3, 10, 20)), nullptr);
+}
+
+
+TEST(IntersectionsCacheTests, RemovedSurfaceEntriesAreEvicted) {
+    constexpr Entity surface1 = 0;
+    constexpr Entity surface2 = 1;
+    constexpr Entity surface3 = 2;
+
+    IntersectionsCache cache;
+    cache.UpdateSurfaceHash(surface1, 10);
+    cache.UpdateSurfaceHash(surface2, 20);
+    cache.UpdateSurfaceHash(surface3, 30);
+    cache.Insert(MakeKey(surface1, surface2, 10, 20), MakeEntry());
+    cache.Insert(MakeKey(surface3, surface1, 30, 10), MakeEntry());
+    cache.Insert(MakeKey(surface2, surface3, 20, 30), MakeEntry());
+
+    cache.RemoveSurface(surface1);
+
+    EXPECT_FALSE(cache.TracksSurface(surface1));
+    EXPECT_TRUE(cache.TracksSurface(surface2));
+    EXPECT_EQ(cache.Size(), 1u);
+    EXPECT_NE(cache.Find(MakeKey(surface2, surface3, 20, 30)), nullptr);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/materialHeightMap.hpp>
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+    constexpr int xResolution = 200;
+    constexpr int zResolution = 130;
+    constexpr float materialLen = 1.5f;
+    constexpr float initHeight = 0.5f;
+
+    constexpr int tileSize = MaterialHeightMap::tileSize;
+}
+
+
+TEST(MaterialHeightMapTests, UntouchedTilesAreNotAllocated) {
+    const MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+
+    EXPECT_EQ(heightMap.TilesX(), (xResolution + tileSize - 1) / tileSize);
+    EXPECT_EQ(heightMap.TilesZ(), (zResolution + tileSize - 1) / tileSize);
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), 0u);
+
+    EXPECT_EQ(heightMap.HeightAt(0, 0), initHeight);
+    EXPECT_EQ(heightMap.HeightAt(xResolution - 1, zResolution - 1), initHeight);
+    EXPECT_EQ(heightMap.TileData(1, 1)[5], initHeight);
+}
+
+
+TEST(MaterialHeightMapTests, WriteMaterializesOnlyItsTile) {
+    MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+
+    heightMap.ChangeHeightAt(tileSize + 3, tileSize + 5, 0.2f);
+
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), 1u);
+    EXPECT_TRUE(heightMap.IsTileMaterialized(1, 1));
+    EXPECT_FALSE(heightMap.IsTileMaterialized(0, 1));
+
+    EXPECT_EQ(heightMap.HeightAt(tileSize + 3, tileSize + 5), 0.2f);
+    EXPECT_EQ(heightMap.HeightAt(tileSize + 4, tileSize + 5), initHeight);
+    EXPECT_EQ(heightMap.TileData(1, 1)[5*tileSize + 3], 0.2f);
+}
+
+
+TEST(MaterialHeightMapTests, FillReleasesAllTiles) {
+    MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+    heightMap.Materialize(heightMap.Bounds());
+
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), static_cast<size_t>(heightMap.TilesX() * heightMap.TilesZ()));
+
+    heightMap.ChangeHeightAt(10, 10, 0.1f);
+    heightMap.Fill(0.3f);
+
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), 0u);
+    EXPECT_EQ(heightMap.HeightAt(10, 10), 0.3f);
+    EXPECT_EQ(heightMap.FillHeight(), 0.3f);
+}
+
+
+TEST(MaterialHeightMapTests, CopyRowJoinsTiles) {
+    MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+    heightMap.ChangeHeightAt(tileSize - 1, 7, 0.1f);
+    heightMap.ChangeHeightAt(xResolution - 1, 7, 0.2f);
+
+    std::vector<float> row(xResolution);
+    heightMap.CopyRow(7, row.data());
+
+    for (int x = 0; x < xResolution; ++x)
+        EXPECT_EQ(row[x], heightMap.HeightAt(x, 7)) << "x = " << x;
+
+    EXPECT_EQ(row[tileSize - 1], 0.1f);
+    EXPECT_EQ(row[xResolution - 1], 0.2f);
+}
+
+
+TEST(MaterialHeightMapTests, CutterAboveMaterialDoesNotAllocateTiles) {
+    MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+    const MillingCutter cutter(0.1f, MillingCutter::Type::Round);
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    const auto above = stamp.Mill(heightMap, alg::Vec3(0.f, initHeight + 0.01f, 0.f));
+
+    EXPECT_FALSE(above.materialRemoved);
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), 0u);
+
+    const auto below = stamp.Mill(heightMap, alg::Vec3(-0.6f, initHeight - 0.1f, -0.6f));
+
+    EXPECT_TRUE(below.materialRemoved);
+    EXPECT_TRUE(heightMap.IsTileMaterialized(0, 0));
+    EXPECT_LT(heightMap.MaterializedTilesCnt(), static_cast<size_t>(heightMap.TilesX() * heightMap.TilesZ()));
+}
+
+
+TEST(MaterialHeightMapTests, HeightQueriesMatchBruteForceAfterMilling) {
+    MaterialHeightMap heightMap(xResolution, zResolution, materialLen, materialLen, initHeight);
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Round);
+    const CutterStamp stamp(cutter, heightMap.PixelXLen(), heightMap.PixelZLen());
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> posDist(-0.7f, 0.7f);
+    std::uniform_real_distribution<float> heightDist(0.2f, 0.6f);
+
+    for (int i = 0; i < 30; ++i) {
+        const alg::Vec3 pos(posDist(gen), heightDist(gen), posDist(gen));
+        stamp.Mill(heightMap, pos);
+        heightMap.MarkChanged(heightMap.Bounds());
+    }
+
+    // Before refreshing the maximum is still an upper bound
+    EXPECT_GE(heightMap.MaxHeight(heightMap.Bounds()), initHeight);
+
+    heightMap.RefreshHeightRanges();
+
+    for (int i = 0; i < 100; ++i) {
+        const int minX = static_cast<int>(gen() % xResolution);
+        const int minZ = static_cast<int>(gen() % zResolution);
+        const PixelRect rect {
+            .minX = minX,
+            .minZ = minZ,
+            .maxX = minX + 1 + static_cast<int>(gen() % (xResolution - minX)),
+            .maxZ = minZ + 1 + static_cast<int>(gen() % (zResolution - minZ))
+        };
+
+        float expectedMin = std::numeric_limits<float>::infinity();
+        float expectedMax = -std::numeric_limits<float>::infinity();
+
+        for (int z = rect.minZ; z < rect.maxZ; ++z) {
+            for (int x = rect.minX; x < rect.maxX; ++x) {
+                expectedMin = std::min(expectedMin, heightMap.HeightAt(x, z));
+                expectedMax = std::max(expectedMax, heightMap.HeightAt(x, z));
+            }
+        }
+
+        ASSERT_EQ(heightMap.MinHeight(rect), expectedMin) << "iteration " << i;
+        ASSERT_GE(heightMap.MaxHeight(rect), expectedMax) << "iteration " << i;
+    }
+
+    EXPECT_LT(heightMap.MinHeight(heightMap.Bounds()), initHeight);
+    EXPECT_EQ(heightMap.MaxHeight({ .minX = 5, .minZ = 5, .maxX = 5, .maxZ = 9 }), -std::numeric_limits<float>::infinity());
+}
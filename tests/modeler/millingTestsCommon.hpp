@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CAD_modeler/model/components/millingMachinePath.hpp>
+#include <CAD_modeler/model/millingMachineSim/materialHeightMap.hpp>
+
+#include <random>
+#include <vector>
+
+
+/// @brief Material and paths shared by the milling simulation tests
+namespace millingTests
+{
+    constexpr int resolution = 300;
+    constexpr float materialLen = 1.5f;
+    constexpr float initHeight = 0.5f;
+
+
+    inline MaterialHeightMap Material()
+    {
+        return { resolution, resolution, materialLen, materialLen, initHeight };
+    }
+
+
+    /// @brief Path starting above the middle of the material through random points, whose coordinates are within
+    /// the position range and heights from just above the bottom to the max height. Some of the moves are plunges,
+    /// some are repeated points.
+    inline MillingMachinePath RandomPath(
+        const int commandsCnt, const unsigned int seed, const float posRange = 0.8f, const float maxHeight = 0.45f
+    ) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<float> posDist(-posRange, posRange);
+        std::uniform_real_distribution<float> heightDist(0.05f, maxHeight);
+
+        MillingMachinePath path;
+        path.AddCommand(1, 0.f, 0.6f, 0.f);
+
+        for (int i = 1; i < commandsCnt; ++i) {
+            const auto prev = path.Commands().back().destination;
+
+            if (i % 10 == 3)
+                path.AddCommand(i + 1, prev.GetX(), heightDist(gen), prev.GetZ());
+            else if (i % 10 == 7)
+                path.AddCommand(i + 1, prev.GetX(), prev.GetY(), prev.GetZ());
+            else
+                path.AddCommand(i + 1, posDist(gen), heightDist(gen), posDist(gen));
+        }
+
+        return path;
+    }
+
+
+    /// @brief Heights of all the pixels, row after row
+    inline std::vector<float> Heights(const MaterialHeightMap& heightMap)
+    {
+        std::vector<float> heights(static_cast<size_t>(heightMap.XResolution()) * heightMap.ZResolution());
+
+        for (int z = 0; z < heightMap.ZResolution(); ++z)
+            heightMap.CopyRow(z, heights.data() + static_cast<size_t>(z) * heightMap.XResolution());
+
+        return heights;
+    }
+}
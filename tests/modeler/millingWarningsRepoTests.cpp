@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/components/millingWarningsRepo.hpp>
+
+#include <thread>
+
+
+namespace
+{
+    MillingMachinePath PathWithIds(const std::vector<int>& ids)
+    {
+        MillingMachinePath path;
+        for (const int id : ids)
+            path.AddCommand(id, 0.f, 0.f, 0.f);
+
+        return path;
+    }
+}
+
+
+TEST(MillingWarningsRepoTests, ViewIsSortedByCommandsIds) {
+    MillingWarningsRepo repo;
+    repo.Reset(PathWithIds({ 30, 10, 20 }));
+
+    repo.AddWarning(0, MillingWarningsRepo::MillingTooDeep);
+    repo.AddWarning(1, MillingWarningsRepo::MillingStraightDown);
+    repo.AddWarning(1, MillingWarningsRepo::MillingUnderTheBase);
+    repo.UpdateView();
+
+    const auto& warnings = repo.GetWarnings();
+    ASSERT_EQ(warnings.size(), 2u);
+
+    EXPECT_EQ(warnings[0].commandId, 10);
+    EXPECT_EQ(warnings[0].warnings, MillingWarningsRepo::MillingStraightDown | MillingWarningsRepo::MillingUnderTheBase);
+
+    EXPECT_EQ(warnings[1].commandId, 30);
+    EXPECT_EQ(warnings[1].warnings, MillingWarningsRepo::MillingTooDeep);
+}
+
+
+
+TEST(MillingWarningsRepoTests, ClearFromKeepsWarningsOfEarlierCommands) {
+    MillingWarningsRepo repo;
+    repo.Reset(PathWithIds({ 1, 2, 3, 4 }));
+
+    repo.AddWarning(0, MillingWarningsRepo::MillingTooDeep);
+    repo.AddWarning(2, MillingWarningsRepo::MillingStraightDown);
+    repo.AddWarning(3, MillingWarningsRepo::MillingUnderTheBase);
+    repo.UpdateView();
+
+    repo.ClearFrom(2);
+    repo.UpdateView();
+
+    const auto& warnings = repo.GetWarnings();
+    ASSERT_EQ(warnings.size(), 1u);
+    EXPECT_EQ(warnings[0].commandId, 1);
+    EXPECT_EQ(warnings[0].warnings, MillingWarningsRepo::MillingTooDeep);
+}
+
+TEST(MillingWarningsRepoTests, WarningsAreVisibleAfterUpdatingView) {
+    MillingWarningsRepo repo;
+    repo.Reset(PathWithIds({ 1, 2 }));
+
+    repo.AddWarning(1, MillingWarningsRepo::MillingTooDeep);
+    EXPECT_TRUE(repo.Empty());
+
+    repo.UpdateView();
+    EXPECT_FALSE(repo.Empty());
+
+    repo.Clear();
+    EXPECT_TRUE(repo.Empty());
+
+    repo.UpdateView();
+    EXPECT_TRUE(repo.Empty());
+}
+
+
+TEST(MillingWarningsRepoTests, AddingWarningsFromManyThreads) {
+    constexpr int commandsCnt = 10000;
+    constexpr int threadsCnt = 4;
+
+    std::vector<int> ids(commandsCnt);
+    for (int i = 0; i < commandsCnt; ++i)
+        ids[i] = i;
+
+    MillingWarningsRepo repo;
+    repo.Reset(PathWithIds(ids));
+
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < threadsCnt; ++t) {
+            threads.emplace_back([&repo, t] {
+                const auto type = t % 2 == 0 ? MillingWarningsRepo::MillingTooDeep : MillingWarningsRepo::MillingUnderTheBase;
+
+                for (size_t i = t; i < commandsCnt; i += 2)
+                    repo.AddWarning(i, type);
+            });
+        }
+    }
+
+    repo.UpdateView();
+
+    const auto& warnings = repo.GetWarnings();
+    ASSERT_EQ(warnings.size(), static_cast<size_t>(commandsCnt));
+
+    for (int i = 0; i < commandsCnt; ++i) {
+        const int expected = i % 2 == 0 ? MillingWarningsRepo::MillingTooDeep : MillingWarningsRepo::MillingUnderTheBase;
+        EXPECT_EQ(warnings[i].warnings, expected);
+    }
+}
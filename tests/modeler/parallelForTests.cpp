@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/utilities/parallelFor.hpp>
+
+#include <atomic>
+#include <vector>
+
+
+TEST(ParallelForTests, EveryTaskRunsOnce) {
+    constexpr size_t tasksCnt = 1000;
+    std::vector<std::atomic_int> runs(tasksCnt);
+
+    ParallelFor(tasksCnt, 4, [&runs] (const size_t i) {
+        runs[i].fetch_add(1);
+    });
+
+    for (size_t i = 0; i < tasksCnt; ++i)
+        EXPECT_EQ(runs[i].load(), 1) << "i = " << i;
+}
+
+
+TEST(ParallelForTests, WorkersIndicesAreInRange) {
+    constexpr size_t tasksCnt = 3;
+    constexpr unsigned int threadsCnt = 8;
+
+    const unsigned int workersCnt = ParallelWorkersCnt(tasksCnt, threadsCnt);
+    EXPECT_EQ(workersCnt, 3u);
+
+    std::vector<std::atomic_int> workersTasks(workersCnt);
+
+    ParallelFor(tasksCnt, threadsCnt, [&workersTasks] (size_t, const unsigned int workerIdx) {
+        ASSERT_LT(workerIdx, workersTasks.size());
+        workersTasks[workerIdx].fetch_add(1);
+    });
+
+    int tasksSum = 0;
+    for (const auto& tasks : workersTasks)
+        tasksSum += tasks.load();
+
+    EXPECT_EQ(tasksSum, 3);
+}
+
+
+TEST(ParallelForTests, NoTasksAndNoThreads) {
+    EXPECT_EQ(ParallelWorkersCnt(0, 4), 0u);
+    EXPECT_EQ(ParallelWorkersCnt(10, 0), 1u);
+
+    int runs = 0;
+    ParallelFor(0, 4, [&runs] (size_t) { ++runs; });
+    ParallelFor(5, 0, [&runs] (size_t) { ++runs; });
+
+    EXPECT_EQ(runs, 5);
+}
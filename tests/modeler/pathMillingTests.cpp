@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/heightMapExport.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+
+namespace
+{
+    constexpr int resolution = 200;
+    constexpr float materialLen = 1.5f;
+    constexpr float initHeight = 0.5f;
+
+
+    MillingMachinePath PlungeAndMove()
+    {
+        MillingMachinePath path;
+        path.AddCommand(1, 0.f, 0.7f, 0.f);
+        path.AddCommand(2, 0.f, 0.3f, 0.f);
+        path.AddCommand(3, 0.5f, 0.3f, 0.f);
+        path.AddCommand(4, 0.5f, 0.05f, 0.5f);
+
+        return path;
+    }
+}
+
+
+TEST(PathMillingTests, SectionsStartFromGivenCommand) {
+    const auto path = PlungeAndMove();
+
+    const auto sections = PathSections(path, 2);
+    ASSERT_EQ(sections.size(), 2u);
+
+    EXPECT_EQ(sections[0].start, path.Commands()[1].destination.vec);
+    EXPECT_EQ(sections[0].end, path.Commands()[2].destination.vec);
+    EXPECT_EQ(sections[1].end, path.Commands()[3].destination.vec);
+
+    EXPECT_TRUE(PathSections(path, 4).empty());
+}
+
+
+TEST(PathMillingTests, ReportsWarningsOfMilledCommands) {
+    const auto path = PlungeAndMove();
+    const MillingCutter cutter(0.08f, MillingCutter::Type::Flat, 0.1f);
+
+    MaterialHeightMap heightMap(resolution, resolution, materialLen, materialLen, initHeight);
+    heightMap.SetBaseLevel(0.1f);
+
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+
+    const TiledMiller miller(32, 2);
+    MillPath(miller, heightMap, cutter, path, warnings);
+    warnings.UpdateView();
+
+    const auto& view = warnings.GetWarnings();
+    ASSERT_EQ(view.size(), 3u);
+
+    EXPECT_EQ(view[0].commandId, 2);
+    EXPECT_EQ(view[0].warnings, MillingWarningsRepo::MillingStraightDown | MillingWarningsRepo::MillingTooDeep);
+
+    EXPECT_EQ(view[1].commandId, 3);
+    EXPECT_EQ(view[1].warnings, MillingWarningsRepo::MillingTooDeep);
+
+    EXPECT_EQ(view[2].commandId, 4);
+    EXPECT_EQ(view[2].warnings, MillingWarningsRepo::MillingUnderTheBase | MillingWarningsRepo::MillingTooDeep);
+}
+
+
+TEST(PathMillingTests, RawExportStoresHeights) {
+    MaterialHeightMap heightMap(4, 3, 1.f, 1.f, initHeight);
+    heightMap.ChangeHeightAt(2, 1, 0.25f);
+
+    const auto filePath = std::filesystem::temp_directory_path() / "pathMillingTests.raw";
+    SaveHeightMapRaw(heightMap, filePath.string());
+
+    std::ifstream file(filePath, std::ios::binary);
+    std::vector<float> heights(4 * 3);
+    file.read(reinterpret_cast<char*>(heights.data()), static_cast<std::streamsize>(heights.size() * sizeof(float)));
+
+    ASSERT_TRUE(file);
+    for (int z = 0; z < 3; ++z) {
+        for (int x = 0; x < 4; ++x)
+            EXPECT_EQ(heights[z*4 + x], heightMap.HeightAt(x, z));
+    }
+    EXPECT_EQ(heights[1*4 + 2], 0.25f);
+
+    file.close();
+    std::filesystem::remove(filePath);
+}
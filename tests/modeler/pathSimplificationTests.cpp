@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/pathSimplification.hpp>
+
+
+namespace
+{
+    MillingMachinePath ZigZagPath(const int pointsInRow, const int rows)
+    {
+        MillingMachinePath path;
+        int id = 1;
+
+        for (int row = 0; row < rows; ++row) {
+            for (int i = 0; i < pointsInRow; ++i) {
+                const int col = row % 2 == 0 ? i : pointsInRow - 1 - i;
+                path.AddCommand(id++, static_cast<float>(col) * 0.01f, 0.2f, static_cast<float>(row) * 0.1f);
+            }
+        }
+
+        return path;
+    }
+}
+
+
+TEST(PathSimplificationTests, CollinearMovesAreMerged) {
+    const auto path = ZigZagPath(100, 4);
+    const auto simplified = SimplifyPath(path, 1e-5f);
+
+    ASSERT_EQ(simplified.Size(), 8u);
+
+    for (size_t i = 0; i < simplified.Size(); ++i) {
+        const auto& expected = path.Commands()[(i / 2) * 100 + (i % 2) * 99];
+        EXPECT_EQ(simplified.Commands()[i].id, expected.id);
+        EXPECT_EQ(simplified.Commands()[i].destination.vec, expected.destination.vec);
+    }
+}
+
+
+TEST(PathSimplificationTests, PointsFartherThanToleranceAreKept) {
+    MillingMachinePath path;
+    path.AddCommand(1, 0.f, 0.f, 0.f);
+    path.AddCommand(2, 0.5f, 0.02f, 0.f);
+    path.AddCommand(3, 1.f, 0.f, 0.f);
+
+    EXPECT_EQ(SimplifyPath(path, 0.01f).Size(), 3u);
+    EXPECT_EQ(SimplifyPath(path, 0.03f).Size(), 2u);
+}
+
+
+TEST(PathSimplificationTests, ReturningPathIsNotMerged) {
+    MillingMachinePath path;
+    path.AddCommand(1, 0.f, 0.f, 0.f);
+    path.AddCommand(2, 1.f, 0.f, 0.f);
+    path.AddCommand(3, 0.f, 0.f, 0.f);
+
+    EXPECT_EQ(SimplifyPath(path, 0.01f).Size(), 3u);
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/pathStepper.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+
+#include "millingTestsCommon.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+using namespace millingTests;
+
+
+namespace
+{
+    /// @brief Waits until the stepper mills all the time added to it
+    PathStepper::Progress WaitForStepper(const PathStepper& stepper)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            const auto progress = stepper.GetProgress();
+            if (progress.pendingTime == 0.0 || progress.finished)
+                return progress;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        ADD_FAILURE() << "Stepper did not mill the added time";
+        return stepper.GetProgress();
+    }
+}
+
+
+TEST(PathStepperTests, FinishedPathGivesSameHeightsAsMillingPathAtOnce) {
+    const auto path = RandomPath(60, 5);
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Round, 1.f);
+
+    MaterialHeightMap expected = Material();
+    MillingWarningsRepo expectedWarnings;
+    expectedWarnings.Reset(path);
+    MillPath(TiledMiller(64, 1), expected, cutter, path, expectedWarnings);
+    expectedWarnings.UpdateView();
+
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+
+    std::vector<size_t> milledCommands;
+    PathStepper stepper;
+    stepper.SetSpeed(1.f);
+    stepper.Start(heightMap, cutter, path, warnings, { .cutterPos = path.Commands()[0].destination.vec },
+        [&milledCommands] (const size_t nextCommand, double) { milledCommands.push_back(nextCommand); }
+    );
+
+    // Time long enough to mill every section at once
+    stepper.AddTime(1e6);
+    const auto progress = WaitForStepper(stepper);
+    stepper.Stop();
+    warnings.UpdateView();
+
+    ASSERT_TRUE(progress.finished);
+    EXPECT_EQ(progress.command, path.Size());
+    EXPECT_EQ(progress.cutterPos, path.Commands().back().destination.vec);
+    EXPECT_EQ(milledCommands.size(), path.Size() - 1);
+
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x)
+            ASSERT_EQ(heightMap.HeightAt(x, z), expected.HeightAt(x, z)) << "x = " << x << ", z = " << z;
+    }
+
+    ASSERT_EQ(warnings.GetWarnings().size(), expectedWarnings.GetWarnings().size());
+    for (size_t i = 0; i < warnings.GetWarnings().size(); ++i) {
+        EXPECT_EQ(warnings.GetWarnings()[i].commandId, expectedWarnings.GetWarnings()[i].commandId);
+        EXPECT_EQ(warnings.GetWarnings()[i].warnings, expectedWarnings.GetWarnings()[i].warnings);
+    }
+}
+
+
+TEST(PathStepperTests, CutterMovesBySimulatedTimeAndSpeed) {
+    MillingMachinePath path;
+    path.AddCommand(1, -0.5f, 1.f, 0.f);
+    path.AddCommand(2, 0.5f, 1.f, 0.f);
+    path.AddCommand(3, 0.5f, 1.f, 0.5f);
+
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Flat, 1.f);
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+
+    PathStepper stepper;
+    stepper.SetSpeed(0.5f);
+    stepper.Start(heightMap, cutter, path, warnings, { .cutterPos = path.Commands()[0].destination.vec });
+
+    stepper.AddTime(1.f);
+    auto progress = WaitForStepper(stepper);
+
+    EXPECT_EQ(progress.command, 1u);
+    EXPECT_NEAR(progress.cutterPos.X(), 0.f, 1e-5f);
+    EXPECT_NEAR(progress.simulatedTime, 1.0, 1e-6);
+
+    // Stopped stepper continues from its progress
+    progress = stepper.Stop();
+    stepper.Start(heightMap, cutter, path, warnings, progress);
+
+    stepper.AddTime(1.5f);
+    progress = WaitForStepper(stepper);
+
+    EXPECT_EQ(progress.command, 2u);
+    EXPECT_NEAR(progress.cutterPos.X(), 0.5f, 1e-5f);
+    EXPECT_NEAR(progress.cutterPos.Z(), 0.25f, 1e-5f);
+    EXPECT_FALSE(progress.finished);
+
+    stepper.AddTime(10.f);
+    progress = WaitForStepper(stepper);
+
+    EXPECT_TRUE(progress.finished);
+    EXPECT_NEAR(progress.simulatedTime, 3.0, 1e-5);
+    EXPECT_EQ(heightMap.MaterializedTilesCnt(), 0u);
+}
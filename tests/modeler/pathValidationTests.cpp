@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/pathValidation.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+
+#include "millingTestsCommon.hpp"
+
+#include <vector>
+
+
+using namespace millingTests;
+
+
+namespace
+{
+    std::vector<int> WarningsOfCommands(const MillingWarningsRepo& warnings, const MillingMachinePath& path)
+    {
+        std::vector<int> flags(path.Size(), 0);
+
+        for (const auto& [commandId, warningsTypes] : warnings.GetWarnings())
+            flags[commandId - 1] = warningsTypes;
+
+        return flags;
+    }
+
+
+    std::vector<int> Validate(const MillingMachinePath& path, const MillingCutter& cutter, const float baseLevel = 0.f)
+    {
+        MaterialHeightMap heightMap = Material();
+        heightMap.SetBaseLevel(baseLevel);
+
+        MillingWarningsRepo warnings;
+        warnings.Reset(path);
+        ValidatePath(heightMap, cutter, path, warnings);
+        warnings.UpdateView();
+
+        return WarningsOfCommands(warnings, path);
+    }
+}
+
+
+TEST(PathValidationTests, FindsEveryWarningOfMilling) {
+    // Path leaves the material and goes above it
+    const auto path = RandomPath(400, 3, 1.f, 0.6f);
+    const MillingCutter cutter(0.08f, MillingCutter::Type::Flat, 0.15f);
+    constexpr float baseLevel = 0.2f;
+
+    MaterialHeightMap heightMap = Material();
+    heightMap.SetBaseLevel(baseLevel);
+
+    MillingWarningsRepo warnings;
+    warnings.Reset(path);
+    MillPath(TiledMiller(64, 2), heightMap, cutter, path, warnings);
+    warnings.UpdateView();
+
+    const auto milled = WarningsOfCommands(warnings, path);
+    const auto validated = Validate(path, cutter, baseLevel);
+
+    for (size_t i = 0; i < path.Size(); ++i)
+        EXPECT_EQ(milled[i] & ~validated[i], 0) << "command = " << i + 1;
+
+    for (const int warning : { MillingWarningsRepo::MillingUnderTheBase, MillingWarningsRepo::MillingTooDeep, MillingWarningsRepo::MillingStraightDown })
+        EXPECT_TRUE(std::ranges::any_of(milled, [warning](const int flags) { return flags & warning; }));
+}
+
+
+TEST(PathValidationTests, FlagsEachKindOfProblem) {
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Round, 0.2f);
+
+    MillingMachinePath path;
+    path.AddCommand(1, 0.f, 0.6f, 0.f);
+    // Plunge into the material
+    path.AddCommand(2, 0.f, 0.4f, 0.f);
+    // Move along the material top
+    path.AddCommand(3, 0.5f, 0.4f, 0.f);
+    // Step down deeper than the cutter height
+    path.AddCommand(4, 0.5f, 0.2f, 0.5f);
+    // Retract straight up and move outside of the material
+    path.AddCommand(5, 0.5f, 0.6f, 0.5f);
+    path.AddCommand(6, 1.f, 0.6f, 1.f);
+    // Go under the base outside of the material
+    path.AddCommand(7, 1.f, -0.1f, 1.f);
+    // Enter the material under the base
+    path.AddCommand(8, 0.f, -0.1f, 0.f);
+
+    const auto flags = Validate(path, cutter);
+
+    EXPECT_EQ(flags[0], 0);
+    EXPECT_EQ(flags[1], MillingWarningsRepo::MillingStraightDown);
+    EXPECT_EQ(flags[2], 0);
+    EXPECT_EQ(flags[3], MillingWarningsRepo::MillingTooDeep);
+    EXPECT_EQ(flags[4], 0);
+    EXPECT_EQ(flags[5], 0);
+    EXPECT_EQ(flags[6], 0);
+    EXPECT_EQ(flags[7], MillingWarningsRepo::MillingTooDeep | MillingWarningsRepo::MillingUnderTheBase);
+}
+
+
+TEST(PathValidationTests, ValidatingAgainFollowsMaterialThickness) {
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Round, 0.2f);
+
+    MillingMachinePath path;
+    path.AddCommand(1, -1.f, 0.4f, 0.f);
+    path.AddCommand(2, 1.f, 0.4f, 0.f);
+
+    MaterialHeightMap heightMap = Material();
+    MillingWarningsRepo warnings;
+
+    // Same steps as the simulator takes, when the path is loaded and the thickness changed afterward
+    auto validate = [&] {
+        warnings.Reset(path);
+        ValidatePath(heightMap, cutter, path, warnings);
+        warnings.UpdateView();
+
+        return WarningsOfCommands(warnings, path);
+    };
+
+    EXPECT_EQ(validate()[1], 0);
+
+    heightMap.Fill(0.8f);
+    EXPECT_EQ(validate()[1], MillingWarningsRepo::MillingTooDeep);
+
+    heightMap.Fill(initHeight);
+    EXPECT_EQ(validate()[1], 0);
+}
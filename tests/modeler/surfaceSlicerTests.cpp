@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/systems/intersectionSystem/surfaceSlicer.hpp>
+
+#include <limits>
+#include <numbers>
+
+
+using namespace interSys;
+
+
+namespace
+{
+    /// @brief z = x^2 + y^2 over [-1, 1]^2
+    class Paraboloid final : public Surface {
+    public:
+        alg::Vec3 PointOnSurface(const float u, const float v) override {
+            const float x = 2.f * u - 1.f;
+            const float y = 2.f * v - 1.f;
+
+            return { x, y, x*x + y*y };
+        }
+
+        alg::Vec3 PartialDerivativeU(const float u, float) override
+            { return { 2.f, 0.f, 4.f * (2.f * u - 1.f) }; }
+
+        alg::Vec3 PartialDerivativeV(float, const float v) override
+            { return { 0.f, 2.f, 4.f * (2.f * v - 1.f) }; }
+
+        float MaxU() override { return 1.f; }
+        float MinU() override { return 0.f; }
+        float MaxV() override { return 1.f; }
+        float MinV() override { return 0.f; }
+    };
+
+
+    /// @brief Unit cylinder around z axis, wrapped in u
+    class Cylinder final : public Surface {
+    public:
+        alg::Vec3 PointOnSurface(const float u, const float v) override
+            { return { std::cos(u), std::sin(u), v }; }
+
+        alg::Vec3 PartialDerivativeU(const float u, float) override
+            { return { -std::sin(u), std::cos(u), 0.f }; }
+
+        alg::Vec3 PartialDerivativeV(float, float) override
+            { return { 0.f, 0.f, 1.f }; }
+
+        float MaxUSampleVal() override
+            { return 2.f * std::numbers::pi_v<float>; }
+
+        float MaxU() override { return std::numeric_limits<float>::infinity(); }
+        float MinU() override { return -std::numeric_limits<float>::infinity(); }
+        float MaxV() override { return 1.f; }
+        float MinV() override { return 0.f; }
+    };
+}
+
+
+TEST(SurfaceSlicerTests, ClosedContourInsideDomain) {
+    constexpr float eps = 1e-4f;
+
+    Paraboloid surface;
+    SurfaceSlicer slicer(surface, 50, 50);
+
+    const auto contours = slicer.Slice(alg::Vec3(0.f, 0.f, 0.25f), alg::Vec3::UnitZ());
+
+    ASSERT_EQ(contours.size(), 1u);
+    EXPECT_FALSE(contours[0].isOpen);
+    EXPECT_GT(contours[0].points.size(), 20u);
+
+    for (const auto& point : contours[0].points) {
+        EXPECT_NEAR(point.Z(), 0.25f, eps);
+        EXPECT_NEAR(point.X()*point.X() + point.Y()*point.Y(), 0.25f, eps);
+    }
+}
+
+
+TEST(SurfaceSlicerTests, OpenContourReachingDomainBoundary) {
+    Paraboloid surface;
+    SurfaceSlicer slicer(surface, 50, 50);
+
+    const auto contours = slicer.Slice(alg::Vec3(0.5f, 0.f, 0.f), alg::Vec3::UnitX());
+
+    ASSERT_EQ(contours.size(), 1u);
+    EXPECT_TRUE(contours[0].isOpen);
+}
+
+
+TEST(SurfaceSlicerTests, ManyLevelsOnWrappedSurface) {
+    constexpr float eps = 1e-4f;
+
+    Cylinder surface;
+    SurfaceSlicer slicer(surface, 64, 10);
+
+    const auto contours = slicer.Slice(alg::Vec3(0.f, 0.f, 0.f), alg::Vec3::UnitZ(), { 0.25f, 0.5f, 0.75f });
+
+    ASSERT_EQ(contours.size(), 3u);
+
+    for (const auto& contour : contours) {
+        EXPECT_FALSE(contour.isOpen);
+        EXPECT_EQ(contour.points.size(), 64u);
+
+        for (const auto& point : contour.points)
+            EXPECT_NEAR(point.Z(), contour.level, eps);
+    }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/sweptCutter.hpp>
+
+#include <limits>
+#include <numbers>
+#include <random>
+
+
+namespace
+{
+    constexpr int samplesCnt = 20000;
+
+
+    /// Lowest point of the cutter found by sampling its positions along the move
+    float SampledLowestPoint(const MillingCutter& cutter, const alg::Vec3& start, const alg::Vec3& end, const float x, const float z)
+    {
+        float result = std::numeric_limits<float>::infinity();
+
+        for (int i = 0; i <= samplesCnt; ++i) {
+            const float t = static_cast<float>(i) / samplesCnt;
+            const Position pos(start + t * (end - start));
+
+            result = std::min(result, cutter.YCoordinate(pos, x, z));
+        }
+
+        return result;
+    }
+
+
+    void ExpectSameAsSampled(const MillingCutter& cutter, const alg::Vec3& start, const alg::Vec3& end)
+    {
+        const SweptCutter sweptCutter(cutter, start, end);
+
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> zDist(sweptCutter.MinZ() - 0.05f, sweptCutter.MaxZ() + 0.05f);
+
+        const float minX = std::min(start.X(), end.X()) - cutter.radius;
+        const float maxX = std::max(start.X(), end.X()) + cutter.radius;
+        std::uniform_real_distribution<float> xDist(minX - 0.05f, maxX + 0.05f);
+
+        for (int i = 0; i < 300; ++i) {
+            const float x = xDist(gen);
+            const float z = zDist(gen);
+
+            const float expected = SampledLowestPoint(cutter, start, end, x, z);
+            const float actual = sweptCutter.LowestPoint(x, z);
+
+            // Points near the boundary of the swept area might be missed by sampling
+            if (std::isinf(expected) != std::isinf(actual)) {
+                const auto span = sweptCutter.Span(z);
+                ASSERT_TRUE(span.has_value());
+                EXPECT_NEAR(std::min(std::abs(x - span->minX), std::abs(x - span->maxX)), 0.f, 1e-3f);
+                continue;
+            }
+
+            if (std::isinf(expected))
+                continue;
+
+            EXPECT_NEAR(actual, expected, 1e-4f) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(SweptCutterTests, RoundCutterHorizontalMove) {
+    ExpectSameAsSampled(MillingCutter(0.08f, MillingCutter::Type::Round), alg::Vec3(-0.3f, 0.2f, 0.1f), alg::Vec3(0.4f, 0.2f, -0.2f));
+}
+
+
+TEST(SweptCutterTests, RoundCutterDescendingMove) {
+    ExpectSameAsSampled(MillingCutter(0.08f, MillingCutter::Type::Round), alg::Vec3(-0.1f, 0.4f, -0.2f), alg::Vec3(0.1f, 0.1f, 0.3f));
+}
+
+
+TEST(SweptCutterTests, RoundCutterSteepMove) {
+    ExpectSameAsSampled(MillingCutter(0.05f, MillingCutter::Type::Round), alg::Vec3(0.f, 0.1f, 0.f), alg::Vec3(0.02f, 0.5f, 0.01f));
+}
+
+
+TEST(SweptCutterTests, FlatCutterDescendingMove) {
+    ExpectSameAsSampled(MillingCutter(0.05f, MillingCutter::Type::Flat), alg::Vec3(0.3f, 0.4f, -0.2f), alg::Vec3(-0.2f, 0.1f, 0.2f));
+}
+
+
+TEST(SweptCutterTests, BullNoseCutterDescendingMove) {
+    const MillingCutter cutter(CutterProfile::BullNose(0.08f, 0.03f));
+    ExpectSameAsSampled(cutter, alg::Vec3(-0.1f, 0.4f, -0.2f), alg::Vec3(0.1f, 0.1f, 0.3f));
+}
+
+
+TEST(SweptCutterTests, BullNoseCutterSteepMove) {
+    const MillingCutter cutter(CutterProfile::BullNose(0.05f, 0.02f));
+    ExpectSameAsSampled(cutter, alg::Vec3(0.f, 0.1f, 0.f), alg::Vec3(0.02f, 0.5f, 0.01f));
+}
+
+
+TEST(SweptCutterTests, TaperedCutterAscendingMove) {
+    const MillingCutter cutter(CutterProfile::Tapered(0.08f, 0.01f, std::numbers::pi_v<float> / 4.f));
+    ExpectSameAsSampled(cutter, alg::Vec3(0.3f, 0.1f, -0.2f), alg::Vec3(-0.2f, 0.3f, 0.2f));
+}
+
+
+TEST(SweptCutterTests, LowerEndIsExactlyAtTheCutterTip) {
+    // Heights, whose difference is not exact in single precision
+    const alg::Vec3 start(-0.387272954f, 0.499663919f, 0.560629487f);
+    const alg::Vec3 end(0.78613019f, 0.172076836f, -0.484829426f);
+
+    for (const auto type : { MillingCutter::Type::Flat, MillingCutter::Type::Round }) {
+        const MillingCutter cutter(0.08f, type);
+        const SweptCutter sweptCutter(cutter, start, end);
+
+        EXPECT_EQ(sweptCutter.LowestPoint(end.X(), end.Z()), end.Y());
+        EXPECT_LE(sweptCutter.LowestPoint(end.X() + 0.01f, end.Z() - 0.02f), cutter.YCoordinate(Position(end), end.X() + 0.01f, end.Z() - 0.02f));
+    }
+}
+
+
+TEST(SweptCutterTests, PointsOutsideTheSpanAreNotCovered) {
+    const MillingCutter cutter(0.08f, MillingCutter::Type::Round);
+    const SweptCutter sweptCutter(cutter, alg::Vec3(-0.3f, 0.2f, 0.1f), alg::Vec3(0.4f, 0.3f, -0.2f));
+
+    for (float z = sweptCutter.MinZ() - 0.01f; z <= sweptCutter.MaxZ() + 0.01f; z += 0.005f) {
+        const auto span = sweptCutter.Span(z);
+
+        for (float x = -0.5f; x <= 0.6f; x += 0.002f) {
+            if (span.has_value() && x >= span->minX && x <= span->maxX)
+                continue;
+
+            EXPECT_TRUE(std::isinf(sweptCutter.LowestPoint(x, z))) << "x = " << x << ", z = " << z;
+        }
+    }
+}
+
+
+TEST(SweptCutterTests, PlungeIsRecognized) {
+    const MillingCutter cutter(0.08f, MillingCutter::Type::Flat);
+
+    EXPECT_TRUE(SweptCutter(cutter, alg::Vec3(0.1f, 0.5f, 0.1f), alg::Vec3(0.1f, 0.2f, 0.1f)).IsPlunge());
+    EXPECT_FALSE(SweptCutter(cutter, alg::Vec3(0.1f, 0.5f, 0.1f), alg::Vec3(0.2f, 0.2f, 0.1f)).IsPlunge());
+}
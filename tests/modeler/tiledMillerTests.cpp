@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/tiledMiller.hpp>
+#include <CAD_modeler/model/millingMachineSim/cutterStamp.hpp>
+#include <CAD_modeler/model/millingMachineSim/pathMilling.hpp>
+#include <CAD_modeler/model/millingMachineSim/sectionMilling.hpp>
+
+#include "millingTestsCommon.hpp"
+
+#include <algorithm>
+
+
+using namespace millingTests;
+
+
+namespace
+{
+    std::vector<MillingSection> RandomSections(const int sectionsCnt)
+    {
+        return PathSections(RandomPath(sectionsCnt + 1, 7));
+    }
+
+
+    void ExpectSameAsSequential(const MillingCutter& cutter, const int tileSize, const unsigned int threadsCnt)
+    {
+        const auto sections = RandomSections(300);
+
+        MaterialHeightMap sequential = Material();
+        sequential.SetBaseLevel(0.1f);
+        MaterialHeightMap tiled = sequential;
+
+        const CutterStamp stamp(cutter, sequential.PixelXLen(), sequential.PixelZLen());
+        std::vector<MillingResult> expectedResults;
+
+        for (const auto& section : sections) {
+            expectedResults.push_back(
+                MillPathSection(sequential, cutter, stamp, section.start, section.end, sequential.Bounds())
+            );
+        }
+
+        const TiledMiller miller(tileSize, threadsCnt);
+        const auto results = miller.Mill(tiled, cutter, sections);
+
+        for (int z = 0; z < resolution; ++z) {
+            for (int x = 0; x < resolution; ++x)
+                ASSERT_EQ(sequential.HeightAt(x, z), tiled.HeightAt(x, z)) << "x = " << x << ", z = " << z;
+        }
+
+        ASSERT_EQ(results.size(), expectedResults.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(results[i].materialRemoved, expectedResults[i].materialRemoved) << "section " << i;
+            EXPECT_EQ(results[i].underTheBase, expectedResults[i].underTheBase) << "section " << i;
+            EXPECT_EQ(results[i].tooDeep, expectedResults[i].tooDeep) << "section " << i;
+        }
+    }
+}
+
+
+TEST(TiledMillerTests, RoundCutterGivesSameResultsAsSequentialMilling) {
+    ExpectSameAsSequential(MillingCutter(0.08f, MillingCutter::Type::Round, 0.2f), 32, 4);
+}
+
+
+TEST(TiledMillerTests, FlatCutterGivesSameResultsAsSequentialMilling) {
+    ExpectSameAsSequential(MillingCutter(0.05f, MillingCutter::Type::Flat, 0.2f), 17, 3);
+}
+
+
+TEST(TiledMillerTests, SingleThreadGivesSameResultsAsSequentialMilling) {
+    ExpectSameAsSequential(MillingCutter(0.06f, MillingCutter::Type::Round, 0.2f), 64, 1);
+}
+
+
+TEST(TiledMillerTests, MillingInPartsGivesSameHeightsAsSequentialMilling) {
+    const MillingCutter cutter(0.06f, MillingCutter::Type::Flat, 0.2f);
+    const auto sections = RandomSections(200);
+
+    MaterialHeightMap sequential = Material();
+    MaterialHeightMap tiled = sequential;
+
+    const CutterStamp stamp(cutter, sequential.PixelXLen(), sequential.PixelZLen());
+    for (const auto& section : sections)
+        MillPathSection(sequential, cutter, stamp, section.start, section.end, sequential.Bounds());
+
+    // Second part is milled with the height ranges refreshed after the first one, so sections above the material are skipped
+    const TiledMiller miller(64, 2);
+    miller.Mill(tiled, cutter, { sections.begin(), sections.begin() + 100 });
+    miller.Mill(tiled, cutter, { sections.begin() + 100, sections.end() });
+
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x)
+            ASSERT_EQ(sequential.HeightAt(x, z), tiled.HeightAt(x, z)) << "x = " << x << ", z = " << z;
+    }
+}
+
+
+TEST(TiledMillerTests, ChangedPixelsAreInsideChangedRegion) {
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Round, 0.2f);
+    const std::vector<MillingSection> sections {
+        { .start = alg::Vec3(-0.3f, 0.4f, -0.2f), .end = alg::Vec3(-0.1f, 0.3f, -0.25f) },
+        { .start = alg::Vec3(-0.1f, 0.3f, -0.25f), .end = alg::Vec3(0.1f, 0.3f, 0.f) }
+    };
+
+    MaterialHeightMap heightMap = Material();
+    heightMap.ClearChangedRegion();
+
+    const TiledMiller miller(32, 2);
+    miller.Mill(heightMap, cutter, sections);
+
+    const auto& region = heightMap.ChangedRegion();
+    ASSERT_FALSE(region.Empty());
+    EXPECT_LT(region.Width(), resolution / 2);
+    EXPECT_LT(region.Height(), resolution / 2);
+
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x) {
+            if (heightMap.HeightAt(x, z) != initHeight) {
+                ASSERT_TRUE(region.Contains(x, z)) << "x = " << x << ", z = " << z;
+            }
+        }
+    }
+}
+
+
+TEST(TiledMillerTests, ChangedPixelsAreInsidePublishedTiles) {
+    const MillingCutter cutter(0.05f, MillingCutter::Type::Flat, 0.2f);
+    const auto sections = RandomSections(20);
+
+    MaterialHeightMap heightMap = Material();
+
+    const TiledMiller miller(40, 2);
+    MilledTiles milledTiles;
+    milledTiles.Reset(heightMap, miller.TileSize());
+
+    miller.Mill(heightMap, cutter, sections, {}, &milledTiles);
+
+    std::vector<PixelRect> tiles;
+    milledTiles.TakePublished([&tiles](const PixelRect& tile) { tiles.push_back(tile); });
+
+    EXPECT_FALSE(tiles.empty());
+    EXPECT_LT(tiles.size(), static_cast<size_t>(milledTiles.TilesX() * milledTiles.TilesZ()));
+
+    for (int z = 0; z < resolution; ++z) {
+        for (int x = 0; x < resolution; ++x) {
+            if (heightMap.HeightAt(x, z) == initHeight)
+                continue;
+
+            const bool published = std::ranges::any_of(tiles, [x, z](const PixelRect& tile) { return tile.Contains(x, z); });
+            ASSERT_TRUE(published) << "x = " << x << ", z = " << z;
+        }
+    }
+
+    int publishedAgain = 0;
+    milledTiles.TakePublished([&publishedAgain](const PixelRect&) { publishedAgain++; });
+    EXPECT_EQ(publishedAgain, 0);
+}
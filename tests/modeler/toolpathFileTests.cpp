@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <CAD_modeler/model/millingMachineSim/toolpathFile.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+
+namespace
+{
+    class ToolpathFileTests : public testing::Test {
+    protected:
+        void SetUp() override
+            { filePath = (std::filesystem::temp_directory_path() / "toolpathFileTests.ctp").string(); }
+
+        void TearDown() override
+            { std::filesystem::remove(filePath); }
+
+        std::string filePath;
+    };
+}
+
+
+TEST_F(ToolpathFileTests, SavedToolpathIsLoaded) {
+    MillingMachinePath path;
+    for (int i = 0; i < 1000; ++i)
+        path.AddCommand(i + 1, 0.01f * static_cast<float>(i), 0.5f, -0.02f * static_cast<float>(i));
+
+    const MillingCutter cutter(0.08f, MillingCutter::Type::Round, 0.4f);
+    ToolpathFile::Save(filePath, path, cutter);
+
+    const auto loaded = ToolpathFile::Load(filePath);
+
+    EXPECT_EQ(loaded.cutter.type, cutter.type);
+    EXPECT_EQ(loaded.cutter.radius, cutter.radius);
+    EXPECT_EQ(loaded.cutter.height, cutter.height);
+
+    ASSERT_EQ(loaded.path.Size(), path.Size());
+
+    for (size_t i = 0; i < path.Size(); ++i) {
+        EXPECT_EQ(loaded.path.Commands()[i].id, path.Commands()[i].id);
+        EXPECT_EQ(loaded.path.Commands()[i].destination.vec, path.Commands()[i].destination.vec);
+    }
+}
+
+
+TEST_F(ToolpathFileTests, MappedCommandsAreReadOnly) {
+    MillingMachinePath path;
+    path.AddCommand(1, 0.f, 0.5f, 0.f);
+    path.AddCommand(2, 1.f, 0.5f, 0.f);
+
+    ToolpathFile::Save(filePath, path, MillingCutter(0.08f, MillingCutter::Type::Round));
+
+    // Commands are not copied from the mapped file, so they cannot be changed
+    auto loaded = ToolpathFile::Load(filePath);
+
+    EXPECT_THROW(loaded.path.AddCommand(3, 0.f, 0.f, 0.f), std::runtime_error);
+    EXPECT_THROW(loaded.path.RemoveLastCommand(), std::runtime_error);
+    EXPECT_EQ(loaded.path.Size(), 2u);
+}
+
+
+TEST_F(ToolpathFileTests, LoadedPathOutlivesLoadResult) {
+    MillingMachinePath path;
+    path.AddCommand(7, 1.f, 2.f, 3.f);
+    ToolpathFile::Save(filePath, path, MillingCutter(0.05f, MillingCutter::Type::Flat));
+
+    MillingMachinePath copy;
+    {
+        auto loaded = ToolpathFile::Load(filePath);
+        copy = loaded.path;
+    }
+
+    ASSERT_EQ(copy.Size(), 1u);
+    EXPECT_EQ(copy.Commands()[0].id, 7);
+    EXPECT_EQ(copy.Commands()[0].destination.vec, alg::Vec3(1.f, 2.f, 3.f));
+}
+
+
+TEST_F(ToolpathFileTests, CutterProfileIsLoaded) {
+    MillingMachinePath path;
+    path.AddCommand(1, 1.f, 2.f, 3.f);
+    path.AddCommand(2, 2.f, 2.f, 3.f);
+
+    for (const auto& profile : {
+        CutterProfile::BullNose(0.08f, 0.02f),
+        CutterProfile::Tapered(0.06f, 0.01f, 0.3f),
+        CutterProfile::Table({ { 0.f, 0.f }, { 0.02f, 0.005f }, { 0.05f, 0.03f } })
+    }) {
+        ToolpathFile::Save(filePath, path, MillingCutter(profile, 0.3f));
+
+        const auto loaded = ToolpathFile::Load(filePath);
+
+        EXPECT_EQ(loaded.cutter.Profile(), profile);
+        EXPECT_EQ(loaded.cutter.height, 0.3f);
+        ASSERT_EQ(loaded.path.Size(), path.Size());
+        EXPECT_EQ(loaded.path.Commands()[1].destination.vec, alg::Vec3(2.f, 2.f, 3.f));
+    }
+}
+
+
+TEST_F(ToolpathFileTests, InvalidFileIsRejected) {
+    {
+        std::ofstream file(filePath, std::ios::binary);
+        file << "N1G01X1Y2Z3\r\nN2G01X2Y2Z3\r\nN3G01X3Y2Z3\r\n";
+    }
+
+    EXPECT_THROW(auto loaded = ToolpathFile::Load(filePath), std::invalid_argument);
+}
+
+
+TEST_F(ToolpathFileTests, RecognizingExtension) {
+    EXPECT_TRUE(ToolpathFile::HasToolpathExtension("paths/1.ctp"));
+    EXPECT_FALSE(ToolpathFile::HasToolpathExtension("paths/1.k16"));
+}